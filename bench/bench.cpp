@@ -0,0 +1,1031 @@
+//
+// Copyright (c) 2019 Vinnie Falco (vinnie.falco@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/CPPAlliance/url
+//
+
+#include <boost/url.hpp>
+#include <boost/url/authority_view.hpp>
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+/*
+    Measures the throughput of the parsing,
+    percent-coding, resolution and modification
+    algorithms, in nanoseconds per URL and in
+    bytes of input per second.
+
+    Usage:
+
+        boost_url_bench [options] [file...]
+
+    Each file is a corpus, either a text file with
+    one URL per line, or a web-platform-tests JSON
+    file such as test/wpt/urltestdata.json, from
+    which the "input" and "base" strings are taken.
+    When no files are given, the bundled corpora
+    are used if BOOST_URL_BENCH_DIR was defined as
+    the root of the sources when building, as the
+    CMake target does. Synthetic corpora are always
+    added.
+
+    Options:
+
+        --csv           Emit CSV instead of JSON
+        --filter=<s>    Run only the benchmarks whose
+                        name contains the string s
+        --time=<ms>     Minimum duration of a trial,
+                        default 50
+        --trials=<n>    Number of trials, of which the
+                        fastest is reported, default 5
+
+    The results are written to standard output.
+*/
+
+using namespace boost::urls;
+
+namespace {
+
+using clock_type =
+    std::chrono::steady_clock;
+
+// Prevents the optimizer from
+// discarding the measured work
+std::size_t volatile sink_ = 0;
+
+struct corpus
+{
+    std::string name;
+    std::vector<std::string> inputs;
+
+    // { base, reference }
+    std::vector<std::pair<
+        std::string, std::string>> pairs;
+};
+
+struct result
+{
+    std::string name;
+    std::string corpus;
+    std::size_t items;
+    std::size_t bytes;
+    std::size_t reps;
+    double ns_per_item;
+    double bytes_per_sec;
+};
+
+struct options
+{
+    bool csv = false;
+    std::string filter;
+    std::chrono::milliseconds time{50};
+    int trials = 5;
+};
+
+//------------------------------------------------
+//
+// Corpora
+//
+//------------------------------------------------
+
+std::string
+read_file(char const* path)
+{
+    std::ifstream f(path,
+        std::ios::in | std::ios::binary);
+    if(! f)
+        throw std::runtime_error(
+            std::string("can't open ") + path);
+    std::ostringstream oss;
+    oss << f.rdbuf();
+    return oss.str();
+}
+
+std::string
+base_name(std::string const& path)
+{
+    auto const n = path.find_last_of("/\\");
+    if(n == std::string::npos)
+        return path;
+    return path.substr(n + 1);
+}
+
+void
+append_utf8(
+    std::string& s,
+    unsigned long cp)
+{
+    if(cp < 0x80)
+    {
+        s.push_back(static_cast<char>(cp));
+    }
+    else if(cp < 0x800)
+    {
+        s.push_back(static_cast<char>(
+            0xc0 | (cp >> 6)));
+        s.push_back(static_cast<char>(
+            0x80 | (cp & 0x3f)));
+    }
+    else if(cp < 0x10000)
+    {
+        s.push_back(static_cast<char>(
+            0xe0 | (cp >> 12)));
+        s.push_back(static_cast<char>(
+            0x80 | ((cp >> 6) & 0x3f)));
+        s.push_back(static_cast<char>(
+            0x80 | (cp & 0x3f)));
+    }
+    else
+    {
+        s.push_back(static_cast<char>(
+            0xf0 | (cp >> 18)));
+        s.push_back(static_cast<char>(
+            0x80 | ((cp >> 12) & 0x3f)));
+        s.push_back(static_cast<char>(
+            0x80 | ((cp >> 6) & 0x3f)));
+        s.push_back(static_cast<char>(
+            0x80 | (cp & 0x3f)));
+    }
+}
+
+// Parse the JSON string starting at the
+// opening quote s[i], advancing i past it.
+// Only the syntax used in the corpus files
+// is needed, so no JSON library is required.
+std::string
+read_string(
+    std::string const& s,
+    std::size_t& i)
+{
+    std::string r;
+    auto const hex = [&]
+    {
+        unsigned long v = 0;
+        for(int k = 0; k < 4; ++k)
+        {
+            char const c = s.at(++i);
+            v <<= 4;
+            if(c >= '0' && c <= '9')
+                v |= c - '0';
+            else if(c >= 'a' && c <= 'f')
+                v |= c - 'a' + 10;
+            else if(c >= 'A' && c <= 'F')
+                v |= c - 'A' + 10;
+            else
+                throw std::runtime_error(
+                    "bad JSON escape");
+        }
+        return v;
+    };
+    for(++i;; ++i)
+    {
+        char c = s.at(i);
+        if(c == '"')
+        {
+            ++i;
+            return r;
+        }
+        if(c != '\\')
+        {
+            r.push_back(c);
+            continue;
+        }
+        c = s.at(++i);
+        switch(c)
+        {
+        case 'b': r.push_back('\b'); break;
+        case 'f': r.push_back('\f'); break;
+        case 'n': r.push_back('\n'); break;
+        case 'r': r.push_back('\r'); break;
+        case 't': r.push_back('\t'); break;
+        case 'u':
+        {
+            auto cp = hex();
+            if( cp >= 0xd800 && cp < 0xdc00 &&
+                s.compare(i + 1, 2, "\\u") == 0)
+            {
+                i += 2;
+                auto const lo = hex();
+                cp = 0x10000 +
+                    ((cp - 0xd800) << 10) +
+                    (lo - 0xdc00);
+            }
+            append_utf8(r, cp);
+            break;
+        }
+        default:
+            r.push_back(c);
+            break;
+        }
+    }
+}
+
+// Collect the "input" and "base" members
+// of each object in a web-platform-tests
+// URL test file
+void
+load_wpt(
+    corpus& c,
+    std::string const& s)
+{
+    std::string key;
+    std::string input;
+    std::string base;
+    bool has_input = false;
+    bool has_base = false;
+    std::size_t i = 0;
+    while(i < s.size())
+    {
+        char const ch = s[i];
+        if(ch == '"')
+        {
+            auto v = read_string(s, i);
+            while( i < s.size() && (
+                s[i] == ' ' || s[i] == '\t' ||
+                s[i] == '\r' || s[i] == '\n'))
+                ++i;
+            if(i < s.size() && s[i] == ':')
+            {
+                key = std::move(v);
+                continue;
+            }
+            if(key == "input")
+            {
+                input = std::move(v);
+                has_input = true;
+            }
+            else if(key == "base")
+            {
+                base = std::move(v);
+                has_base = true;
+            }
+            key.clear();
+            continue;
+        }
+        if(ch == '}')
+        {
+            if(has_input)
+            {
+                c.inputs.push_back(input);
+                if(has_base)
+                    c.pairs.emplace_back(
+                        base, input);
+            }
+            has_input = false;
+            has_base = false;
+        }
+        else if(ch == ',' || ch == '{')
+        {
+            key.clear();
+        }
+        ++i;
+    }
+}
+
+void
+load_lines(
+    corpus& c,
+    std::string const& s)
+{
+    std::istringstream is(s);
+    std::string line;
+    while(std::getline(is, line))
+    {
+        if( ! line.empty() &&
+            line.back() == '\r')
+            line.pop_back();
+        if( line.empty() ||
+            line[0] == '#')
+            continue;
+        c.inputs.push_back(line);
+    }
+}
+
+corpus
+load_corpus(char const* path)
+{
+    corpus c;
+    c.name = base_name(path);
+    auto const s = read_file(path);
+    auto const n = s.find_first_not_of(
+        " \t\r\n");
+    if( n != std::string::npos &&
+        s[n] == '[')
+        load_wpt(c, s);
+    else
+        load_lines(c, s);
+    return c;
+}
+
+// Deterministic pseudo-random numbers, so
+// that the synthetic corpora are the same
+// on every run and every platform
+struct lcg
+{
+    std::uint32_t v = 1;
+
+    std::size_t
+    operator()(std::size_t n) noexcept
+    {
+        v = v * 1103515245u + 12345u;
+        return (v >> 16) % n;
+    }
+};
+
+void
+make_synthetic(
+    std::vector<corpus>& v)
+{
+    static char const* const words[] = {
+        "index", "a", "users", "api", "v2",
+        "images", "en-US", "search", "x.y",
+        "2021", "~me", "docs", "item_42" };
+    auto const nwords =
+        sizeof(words) / sizeof(words[0]);
+    lcg r;
+
+    // short
+    {
+        corpus c;
+        c.name = "synthetic-short";
+        for(int i = 0; i < 1000; ++i)
+        {
+            std::string s = "http://h";
+            s += std::to_string(r(100));
+            s += ".com/";
+            s += words[r(nwords)];
+            c.inputs.push_back(std::move(s));
+        }
+        v.push_back(std::move(c));
+    }
+
+    // many segments
+    {
+        corpus c;
+        c.name = "synthetic-path";
+        for(int i = 0; i < 250; ++i)
+        {
+            std::string s =
+                "https://www.example.com";
+            auto const n = 16 + r(32);
+            for(std::size_t j = 0; j < n; ++j)
+            {
+                s += '/';
+                s += words[r(nwords)];
+            }
+            c.inputs.push_back(std::move(s));
+        }
+        v.push_back(std::move(c));
+    }
+
+    // many params
+    {
+        corpus c;
+        c.name = "synthetic-query";
+        for(int i = 0; i < 250; ++i)
+        {
+            std::string s =
+                "https://www.example.com/search?";
+            auto const n = 16 + r(32);
+            for(std::size_t j = 0; j < n; ++j)
+            {
+                if(j > 0)
+                    s += '&';
+                s += words[r(nwords)];
+                s += '=';
+                s += std::to_string(r(100000));
+            }
+            c.inputs.push_back(std::move(s));
+        }
+        v.push_back(std::move(c));
+    }
+
+    // mostly escapes
+    {
+        static char const hex[] =
+            "0123456789ABCDEF";
+        corpus c;
+        c.name = "synthetic-pct";
+        for(int i = 0; i < 250; ++i)
+        {
+            std::string s =
+                "https://www.example.com/";
+            auto const n = 64 + r(128);
+            for(std::size_t j = 0; j < n; ++j)
+            {
+                if(r(3) == 0)
+                {
+                    s += static_cast<char>(
+                        'a' + r(26));
+                    continue;
+                }
+                auto const b = 0x80 + r(0x80);
+                s += '%';
+                s += hex[b >> 4];
+                s += hex[b & 15];
+            }
+            s += "?q=";
+            for(std::size_t j = 0; j < n; ++j)
+            {
+                s += "%20";
+                s += words[r(nwords)];
+            }
+            c.inputs.push_back(std::move(s));
+        }
+        v.push_back(std::move(c));
+    }
+}
+
+// Pair each absolute URL with the references
+// from rfc3986, when a corpus has no pairs
+void
+make_pairs(corpus& c)
+{
+    static char const* const refs[] = {
+        "g:h", "g", "./g", "g/", "/g", "//g",
+        "?y", "g?y", "#s", "g#s", "g?y#s",
+        ";x", "g;x", "g;x?y#s", "", ".", "./",
+        "..", "../", "../g", "../..", "../../",
+        "../../g", "../../../g", "/./g",
+        "/../g", "g.", ".g", "g..", "..g",
+        "./../g", "./g/.", "g/./h", "g/../h",
+        "g;x=1/./y", "g;x=1/../y" };
+    auto const nrefs =
+        sizeof(refs) / sizeof(refs[0]);
+    if(! c.pairs.empty())
+        return;
+    std::size_t i = 0;
+    for(auto const& s : c.inputs)
+        if(parse_uri(s).has_value())
+            c.pairs.emplace_back(
+                s, refs[i++ % nrefs]);
+}
+
+//------------------------------------------------
+//
+// Measurement
+//
+//------------------------------------------------
+
+class runner
+{
+    options const& opt_;
+    std::vector<result> results_;
+
+public:
+    explicit
+    runner(options const& opt)
+        : opt_(opt)
+    {
+    }
+
+    std::vector<result> const&
+    results() const noexcept
+    {
+        return results_;
+    }
+
+    // Measure f, which performs one pass
+    // over `items` elements totaling `bytes`
+    template<class F>
+    void
+    operator()(
+        std::string const& name,
+        corpus const& c,
+        std::size_t items,
+        std::size_t bytes,
+        F const& f)
+    {
+        if( items == 0 ||
+            name.find(opt_.filter) ==
+                std::string::npos)
+            return;
+
+        // warm up, and find the number of
+        // passes which fill the minimum time
+        std::size_t reps = 1;
+        clock_type::duration d;
+        for(;;)
+        {
+            auto const t0 = clock_type::now();
+            for(std::size_t i = 0; i < reps; ++i)
+                sink_ = sink_ + f();
+            d = clock_type::now() - t0;
+            if(d >= opt_.time)
+                break;
+            reps *= 2;
+        }
+        for(int i = 1; i < opt_.trials; ++i)
+        {
+            auto const t0 = clock_type::now();
+            for(std::size_t j = 0; j < reps; ++j)
+                sink_ = sink_ + f();
+            d = (std::min)(d,
+                clock_type::now() - t0);
+        }
+
+        double const ns = static_cast<double>(
+            std::chrono::duration_cast<
+                std::chrono::nanoseconds>(
+                    d).count());
+        result r;
+        r.name = name;
+        r.corpus = c.name;
+        r.items = items;
+        r.bytes = bytes;
+        r.reps = reps;
+        r.ns_per_item = ns / (
+            static_cast<double>(reps) * items);
+        r.bytes_per_sec = 1e9 *
+            static_cast<double>(bytes) *
+            static_cast<double>(reps) / ns;
+        results_.push_back(r);
+        std::cerr <<
+            r.name << " " << r.corpus << ": " <<
+            r.ns_per_item << " ns/url, " <<
+            r.bytes_per_sec / 1e6 << " MB/s\n";
+    }
+};
+
+template<class Range>
+std::size_t
+total_size(Range const& v)
+{
+    std::size_t n = 0;
+    for(auto const& s : v)
+        n += s.size();
+    return n;
+}
+
+template<class Parse>
+void
+bench_parse(
+    runner& run,
+    char const* name,
+    corpus const& c,
+    Parse const& parse)
+{
+    run(name, c,
+        c.inputs.size(),
+        total_size(c.inputs),
+        [&]
+        {
+            std::size_t n = 0;
+            for(auto const& s : c.inputs)
+            {
+                auto r = parse(s);
+                if(r.has_value())
+                    n += r->size();
+            }
+            return n;
+        });
+}
+
+void
+bench_corpus(
+    runner& run,
+    corpus const& c)
+{
+    bench_parse(run, "parse_uri", c,
+        [](string_view s)
+        {
+            return parse_uri(s);
+        });
+    bench_parse(run, "parse_uri_reference", c,
+        [](string_view s)
+        {
+            return parse_uri_reference(s);
+        });
+    bench_parse(run, "parse_relative_ref", c,
+        [](string_view s)
+        {
+            return parse_relative_ref(s);
+        });
+
+    // validation only
+    run("validate_uri_reference", c,
+        c.inputs.size(), total_size(c.inputs),
+        [&]
+        {
+            std::size_t n = 0;
+            error_code ec;
+            for(auto const& s : c.inputs)
+                n += validate_uri_reference(
+                    s, ec);
+            return n;
+        });
+
+    // routing, which reads only
+    // the scheme and the host
+    run("route_parse_uri_reference", c,
+        c.inputs.size(), total_size(c.inputs),
+        [&]
+        {
+            std::size_t n = 0;
+            for(auto const& s : c.inputs)
+            {
+                auto r = parse_uri_reference(s);
+                if( r.has_value() &&
+                    r->scheme_id() != scheme::none)
+                    n += r->encoded_host().size();
+            }
+            return n;
+        });
+    run("route_lazy_url_view", c,
+        c.inputs.size(), total_size(c.inputs),
+        [&]
+        {
+            std::size_t n = 0;
+            for(auto const& s : c.inputs)
+            {
+                lazy_url_view u(s);
+                if(u.scheme_id() != scheme::none)
+                    n += u.encoded_host().size();
+            }
+            return n;
+        });
+
+    // into a table, reused
+    {
+        std::vector<string_view> v(
+            c.inputs.begin(), c.inputs.end());
+        url_table t;
+        run("parse_uri_reference_table", c,
+            v.size(), total_size(v),
+            [&]
+            {
+                return parse_uri_reference(
+                    v.data(), v.size(), t);
+            });
+
+        // a log of at least 4MB, split
+        // over all hardware threads
+        std::string log;
+        std::size_t lines = 0;
+        while(log.size() < 4 * 1024 * 1024)
+        {
+            for(auto const& s : c.inputs)
+            {
+                if(s.find_first_of("\r\n") !=
+                        std::string::npos)
+                    continue;
+                log += s;
+                log += '\n';
+                ++lines;
+            }
+            if(lines == 0)
+                break;
+        }
+        run("parse_uri_reference_lines", c,
+            lines, log.size(),
+            [&]
+            {
+                return parse_uri_reference_lines(
+                    log, t);
+            });
+    }
+
+    // views of the valid references
+    std::vector<url_view> refs;
+    for(auto const& s : c.inputs)
+    {
+        auto r = parse_uri_reference(s);
+        if(r.has_value())
+            refs.push_back(*r);
+    }
+
+    // authorities
+    {
+        std::vector<string_view> v;
+        for(auto const& u : refs)
+            if(u.has_authority())
+                v.push_back(
+                    u.encoded_authority());
+        run("parse_authority", c,
+            v.size(), total_size(v),
+            [&]
+            {
+                std::size_t n = 0;
+                for(auto const& s : v)
+                {
+                    auto r = parse_authority(s);
+                    if(r.has_value())
+                        n += r->encoded_host().size();
+                }
+                return n;
+            });
+    }
+
+    // paths and queries
+    {
+        auto const cs = pchars + '/' + '?';
+        std::vector<string_view> enc;
+        std::vector<std::string> dec;
+        for(auto const& u : refs)
+        {
+            if(! u.encoded_path().empty())
+                enc.push_back(u.encoded_path());
+            if(! u.encoded_query().empty())
+                enc.push_back(u.encoded_query());
+        }
+        std::size_t max = 0;
+        for(auto const& s : enc)
+        {
+            dec.emplace_back(
+                pct_decode_unchecked(s));
+            max = (std::max)(max, 3 * s.size());
+        }
+        std::string buf(max, '\0');
+        char* const dest = &buf[0];
+        char const* const end = dest + max;
+
+        run("pct_decode", c,
+            enc.size(), total_size(enc),
+            [&]
+            {
+                std::size_t n = 0;
+                error_code ec;
+                for(auto const& s : enc)
+                    n += pct_decode(
+                        dest, end, s, ec, {}, cs);
+                return n;
+            });
+        run("pct_encode", c,
+            dec.size(), total_size(dec),
+            [&]
+            {
+                std::size_t n = 0;
+                for(auto const& s : dec)
+                    n += pct_encode(
+                        dest, end, s, pchars);
+                return n;
+            });
+    }
+
+    // resolution
+    {
+        std::vector<std::pair<
+            url_view, url_view>> v;
+        std::size_t bytes = 0;
+        for(auto const& p : c.pairs)
+        {
+            auto b = parse_uri(p.first);
+            auto r = parse_uri_reference(p.second);
+            if( ! b.has_value() ||
+                ! r.has_value())
+                continue;
+            v.emplace_back(*b, *r);
+            bytes += p.second.size();
+        }
+        url u;
+        run("resolve", c, v.size(), bytes,
+            [&]
+            {
+                std::size_t n = 0;
+                error_code ec;
+                for(auto const& p : v)
+                {
+                    resolve(p.first,
+                        p.second, u, ec);
+                    n += u.size();
+                }
+                return n;
+            });
+    }
+
+    // modification of copies, which are
+    // the same at the end of every pass
+    {
+        std::vector<url> v;
+        v.reserve(refs.size());
+        for(auto const& u : refs)
+            if(u.has_scheme())
+                v.emplace_back(u);
+        std::size_t bytes = 0;
+        for(auto const& u : v)
+            bytes += u.size();
+
+        run("segment_edits", c, v.size(), bytes,
+            [&]
+            {
+                std::size_t n = 0;
+                for(auto& u : v)
+                {
+                    auto s = u.encoded_segments();
+                    s.insert(s.begin(), "first");
+                    s.push_back("last");
+                    n += u.size();
+                    s.erase(s.begin());
+                    s.pop_back();
+                }
+                return n;
+            });
+        run("param_edits", c, v.size(), bytes,
+            [&]
+            {
+                std::size_t n = 0;
+                for(auto& u : v)
+                {
+                    auto p = u.encoded_params();
+                    p.emplace_back("k", "v");
+                    p.emplace_before(p.begin(), "a", "b");
+                    n += u.size();
+                    p.erase(p.begin());
+                    p.erase(std::prev(p.end()));
+                }
+                return n;
+            });
+
+        // the first pass changes the URLs,
+        // so it is done before measuring
+        auto const set = [](url& u)
+        {
+            u.set_scheme("https");
+            u.set_encoded_user("user");
+            u.set_encoded_host(
+                "www.example.com");
+            u.set_port(8443);
+            u.set_encoded_query(
+                "q=1&lang=en");
+            u.set_encoded_fragment("top");
+        };
+        bytes = 0;
+        for(auto& u : v)
+        {
+            set(u);
+            bytes += u.size();
+        }
+        run("url_setters", c, v.size(), bytes,
+            [&]
+            {
+                std::size_t n = 0;
+                for(auto& u : v)
+                {
+                    set(u);
+                    n += u.size();
+                }
+                return n;
+            });
+    }
+}
+
+//------------------------------------------------
+//
+// Output
+//
+//------------------------------------------------
+
+void
+write_json_string(
+    std::ostream& os,
+    string_view s)
+{
+    os << '"';
+    for(char c : s)
+    {
+        if(c == '"' || c == '\\')
+            os << '\\' << c;
+        else if(static_cast<
+                unsigned char>(c) < 0x20)
+            os << ' ';
+        else
+            os << c;
+    }
+    os << '"';
+}
+
+void
+write_json(
+    std::ostream& os,
+    std::vector<result> const& v)
+{
+    os << "{\n";
+    os << "  \"simd_level\": ";
+    write_json_string(os,
+        to_string(active_simd_level()));
+    os << ",\n  \"results\": [";
+    bool first = true;
+    for(auto const& r : v)
+    {
+        os << (first ? "\n" : ",\n");
+        first = false;
+        os << "    { \"name\": ";
+        write_json_string(os, r.name);
+        os << ", \"corpus\": ";
+        write_json_string(os, r.corpus);
+        os <<
+            ", \"items\": " << r.items <<
+            ", \"bytes\": " << r.bytes <<
+            ", \"reps\": " << r.reps <<
+            ", \"ns_per_item\": " << r.ns_per_item <<
+            ", \"bytes_per_sec\": " << r.bytes_per_sec <<
+            " }";
+    }
+    os << "\n  ]\n}\n";
+}
+
+void
+write_csv(
+    std::ostream& os,
+    std::vector<result> const& v)
+{
+    os << "name,corpus,items,bytes,reps,"
+        "ns_per_item,bytes_per_sec\n";
+    for(auto const& r : v)
+        os <<
+            r.name << ',' <<
+            r.corpus << ',' <<
+            r.items << ',' <<
+            r.bytes << ',' <<
+            r.reps << ',' <<
+            r.ns_per_item << ',' <<
+            r.bytes_per_sec << '\n';
+}
+
+int
+usage(char const* name)
+{
+    std::cerr <<
+        "Usage: " << name <<
+        " [--csv] [--filter=<s>] [--time=<ms>]"
+        " [--trials=<n>] [file...]\n";
+    return EXIT_FAILURE;
+}
+
+} // (anon)
+
+int
+main(int argc, char** argv)
+{
+    options opt;
+    std::vector<std::string> files;
+    for(int i = 1; i < argc; ++i)
+    {
+        string_view const s = argv[i];
+        if(s == "--csv")
+            opt.csv = true;
+        else if(s.starts_with("--filter="))
+            opt.filter = std::string(
+                s.substr(9));
+        else if(s.starts_with("--time="))
+            opt.time = std::chrono::milliseconds(
+                std::atoi(argv[i] + 7));
+        else if(s.starts_with("--trials="))
+            opt.trials = (std::max)(1,
+                std::atoi(argv[i] + 9));
+        else if(s.starts_with("--"))
+            return usage(argv[0]);
+        else
+            files.emplace_back(s);
+    }
+#ifdef BOOST_URL_BENCH_DIR
+    if(files.empty())
+    {
+        files.emplace_back(BOOST_URL_BENCH_DIR
+            "/bench/corpus/urls.txt");
+        files.emplace_back(BOOST_URL_BENCH_DIR
+            "/test/wpt/urltestdata.json");
+    }
+#endif
+    if(files.empty())
+        return usage(argv[0]);
+
+    std::vector<corpus> corpora;
+    try
+    {
+        for(auto const& f : files)
+            corpora.push_back(
+                load_corpus(f.c_str()));
+    }
+    catch(std::exception const& e)
+    {
+        std::cerr << e.what() << "\n";
+        return EXIT_FAILURE;
+    }
+    make_synthetic(corpora);
+
+    runner run(opt);
+    for(auto& c : corpora)
+    {
+        make_pairs(c);
+        bench_corpus(run, c);
+    }
+
+    if(opt.csv)
+        write_csv(std::cout, run.results());
+    else
+        write_json(std::cout, run.results());
+    return EXIT_SUCCESS;
+}
@@ -10,28 +10,42 @@
 #ifndef BOOST_URL_HPP
 #define BOOST_URL_HPP
 
+#include <boost/url/basic_url.hpp>
 #include <boost/url/error.hpp>
 #include <boost/url/host_type.hpp>
 #include <boost/url/ipv4_address.hpp>
 #include <boost/url/ipv6_address.hpp>
+#include <boost/url/lazy_url_view.hpp>
 #include <boost/url/params.hpp>
 #include <boost/url/params_encoded.hpp>
 #include <boost/url/params_encoded_view.hpp>
 #include <boost/url/params_value_type.hpp>
 #include <boost/url/params_view.hpp>
+#include <boost/url/parse_stats.hpp>
 #include <boost/url/pct_encoding.hpp>
 #include <boost/url/pct_encoding_types.hpp>
+#include <boost/url/resolver.hpp>
 #include <boost/url/scheme.hpp>
 #include <boost/url/segments.hpp>
 #include <boost/url/segments_encoded.hpp>
 #include <boost/url/segments_encoded_view.hpp>
 #include <boost/url/segments_view.hpp>
+#include <boost/url/shared_url.hpp>
+#include <boost/url/simd_level.hpp>
+#include <boost/url/small_url.hpp>
 #include <boost/url/static_pool.hpp>
 #include <boost/url/static_url.hpp>
 #include <boost/url/string.hpp>
 #include <boost/url/url.hpp>
+#include <boost/url/url_builder.hpp>
+#include <boost/url/url_editor.hpp>
+#include <boost/url/url_literal.hpp>
+#include <boost/url/url_pieces.hpp>
+#include <boost/url/url_stream_parser.hpp>
+#include <boost/url/url_table.hpp>
 #include <boost/url/url_view.hpp>
 #include <boost/url/urls.hpp>
+#include <boost/url/validate.hpp>
 
 #include <boost/url/bnf/ascii.hpp>
 #include <boost/url/bnf/charset.hpp>
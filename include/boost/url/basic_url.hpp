@@ -0,0 +1,329 @@
+//
+// Copyright (c) 2019 Vinnie Falco (vinnie.falco@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/CPPAlliance/url
+//
+
+#ifndef BOOST_URL_BASIC_URL_HPP
+#define BOOST_URL_BASIC_URL_HPP
+
+#include <boost/url/detail/config.hpp>
+#include <boost/url/url.hpp>
+#include <boost/url/detail/except.hpp>
+#include <boost/url/detail/over_allocator.hpp>
+#include <boost/core/empty_value.hpp>
+#include <cstddef>
+#include <memory>
+#include <utility>
+
+namespace boost {
+namespace urls {
+
+/** A URL with storage from an allocator
+
+    This container acts like @ref url,
+    except that the storage for the data
+    is obtained from a copy of the
+    allocator passed upon construction,
+    instead of from `operator new`. This
+    allows a URL to live in an arena or
+    pool, for example one owned by a
+    request, and to be freed with it.
+
+    @par Example
+    @code
+    static_pool< 4096 > pool;
+
+    basic_url< static_pool<4096>::allocator_type< char > > u(
+        "https://www.example.com/index.htm", pool.allocator() );
+
+    u.set_encoded_query( "q=1" );   // grows in the pool
+    @endcode
+
+    @tparam Allocator The allocator type,
+    which meets the requirements of
+    <em>Allocator</em>. It is rebound
+    internally, so any value type may be
+    used. In C++17 this may be
+    `std::pmr::polymorphic_allocator<char>`
+    to obtain storage from a
+    `std::pmr::memory_resource`.
+
+    @note
+    Since @ref url is a base class, an
+    object of this type may be moved into
+    a @ref url, or a @ref url moved into it.
+    This is undefined behavior, as the
+    storage would be released by the wrong
+    allocator. Copies between the types are
+    always allowed.
+
+    @see
+        @ref url,
+        @ref static_url,
+        @ref static_pool.
+*/
+template<class Allocator =
+    std::allocator<char>>
+class basic_url
+    : public url
+#ifndef BOOST_URL_DOCS
+    , private empty_value<typename
+        detail::allocator_traits<Allocator>::
+            template rebind_alloc<
+                pos_t>>
+#endif
+{
+    using alloc_type = typename
+        detail::allocator_traits<Allocator>::
+            template rebind_alloc<pos_t>;
+    using alloc_traits =
+        detail::allocator_traits<alloc_type>;
+
+    alloc_type&
+    alloc() noexcept
+    {
+        return empty_value<
+            alloc_type>::get();
+    }
+
+    alloc_type const&
+    alloc() const noexcept
+    {
+        return empty_value<
+            alloc_type>::get();
+    }
+
+    // the storage is allocated in
+    // units of pos_t, which keeps the
+    // table at the end aligned
+    char*
+    allocate(std::size_t n) override
+    {
+        auto const m =
+            (n + sizeof(pos_t) - 1) /
+                sizeof(pos_t);
+        auto const p =
+            alloc_traits::allocate(
+                alloc(), m);
+        cap_ = m * sizeof(pos_t);
+        return reinterpret_cast<
+            char*>(std::addressof(*p));
+    }
+
+    void
+    deallocate(char* s) override
+    {
+        alloc_traits::deallocate(
+            alloc(),
+            reinterpret_cast<
+                pos_t*>(s),
+            cap_ / sizeof(pos_t));
+    }
+
+    void
+    construct(string_view s)
+    {
+        auto r = parse_uri_reference(s);
+        if(r.has_error())
+            detail::throw_invalid_argument(
+                BOOST_CURRENT_LOCATION);
+        copy(r.value());
+    }
+
+public:
+    /** The type of allocator used by the container
+    */
+    using allocator_type = Allocator;
+
+    /** Destructor
+    */
+    ~basic_url()
+    {
+        if(s_)
+        {
+            deallocate(s_);
+            // prevent url from
+            // deallocating memory
+            s_ = nullptr;
+        }
+    }
+
+    /** Constructor
+
+        Default constructed urls contain
+        a zero-length string. No memory
+        is allocated.
+    */
+    basic_url() noexcept
+        : empty_value<alloc_type>(
+            boost::empty_init_t{})
+    {
+    }
+
+    /** Constructor
+
+        Default constructed urls contain
+        a zero-length string. No memory
+        is allocated.
+
+        @param a The allocator to use.
+    */
+    explicit
+    basic_url(
+        Allocator const& a) noexcept
+        : empty_value<alloc_type>(
+            boost::empty_init_t{}, a)
+    {
+    }
+
+    /** Constructor
+
+        This function constructs a URL from
+        the string `s`, which must contain a
+        valid URI or <em>relative-ref</em> or
+        else an exception is thrown.
+
+        @throw std::invalid_argument parse error
+
+        @param s The string to parse.
+
+        @param a The allocator to use.
+    */
+    explicit
+    basic_url(
+        string_view s,
+        Allocator const& a = {})
+        : basic_url(a)
+    {
+        construct(s);
+    }
+
+    /** Constructor
+
+        This constructs a copy of `u`.
+
+        @par Exception Safety
+        Strong guarantee.
+        Calls to allocate may throw.
+
+        @param u The url to copy.
+
+        @param a The allocator to use.
+    */
+    basic_url(
+        url_view const& u,
+        Allocator const& a = {})
+        : basic_url(a)
+    {
+        copy(u);
+    }
+
+    /** Constructor
+
+        This constructs a copy of `u`, using
+        an allocator obtained from the
+        allocator of `u`.
+
+        @par Exception Safety
+        Strong guarantee.
+        Calls to allocate may throw.
+    */
+    basic_url(basic_url const& u)
+        : url()
+        , empty_value<alloc_type>(
+            boost::empty_init_t{},
+            alloc_traits::
+                select_on_container_copy_construction(
+                    u.alloc()))
+    {
+        copy(u);
+    }
+
+    /** Constructor
+
+        The contents and allocator of `u`
+        are transferred to the newly
+        constructed object. After the move,
+        `u` is empty.
+    */
+    basic_url(basic_url&& u) noexcept
+        : url(std::move(u))
+        , empty_value<alloc_type>(
+            boost::empty_init_t{},
+            std::move(u.alloc()))
+    {
+    }
+
+    /** Assignment
+
+        @par Exception Safety
+        Strong guarantee.
+        Calls to allocate may throw.
+    */
+    basic_url&
+    operator=(url_view const& u)
+    {
+        copy(u);
+        return *this;
+    }
+
+    /** Assignment
+
+        The allocator is not changed.
+
+        @par Exception Safety
+        Strong guarantee.
+        Calls to allocate may throw.
+    */
+    basic_url&
+    operator=(basic_url const& u)
+    {
+        if(this != &u)
+            copy(u);
+        return *this;
+    }
+
+    /** Assignment
+
+        The allocator is not changed. If the
+        allocators compare equal, the contents
+        of `u` are transferred, otherwise they
+        are copied. After the move, `u` is
+        empty.
+
+        @par Exception Safety
+        Strong guarantee.
+        Calls to allocate may throw.
+    */
+    basic_url&
+    operator=(basic_url&& u)
+    {
+        if(this == &u)
+            return *this;
+        if(alloc() == u.alloc())
+        {
+            url::operator=(std::move(u));
+            return *this;
+        }
+        copy(u);
+        u.clear();
+        return *this;
+    }
+
+    /** Return the allocator used by the container
+    */
+    allocator_type
+    get_allocator() const noexcept
+    {
+        return allocator_type(alloc());
+    }
+};
+
+} // urls
+} // boost
+
+#endif
@@ -12,8 +12,10 @@
 
 #include <boost/url/detail/config.hpp>
 #include <boost/url/bnf/detail/charset.hpp>
+#include <boost/mp11/integer_sequence.hpp>
 #include <boost/type_traits/make_void.hpp>
 #include <boost/static_assert.hpp>
+#include <cstddef>
 #include <cstdint>
 #include <type_traits>
 
@@ -90,6 +92,13 @@ class lut_chars
 {
     std::uint64_t mask_[4] = {};
 
+    // Nibble-split form of the same set,
+    // used by the vectorized find functions.
+    // Bit `b` of tab_[i] is set when the char
+    // `((i / 16) * 128) | (b << 4) | (i % 16)`
+    // is a member.
+    unsigned char tab_[32] = {};
+
     constexpr
     static
     std::uint64_t
@@ -108,42 +117,86 @@ class lut_chars
             unsigned char>(c) >> 2);
     }
 
+    // mask word i for the chars in s
     constexpr
     static
-    lut_chars
-    construct(
-        char const* s) noexcept
+    std::uint64_t
+    word(
+        char const* s,
+        std::uint64_t i) noexcept
     {
         return *s
-            ? lut_chars(*s) +
-                construct(s+1)
-            : lut_chars();
+            ? (lo(*s) == i ? hi(*s) : 0) |
+                word(s + 1, i)
+            : 0;
     }
 
+    // mask word i for the chars
+    // 4*k+i where pred is true
+    template<class Pred>
     constexpr
     static
-    lut_chars
-    construct(
-        unsigned char ch,
-        bool b) noexcept
+    std::uint64_t
+    word(
+        Pred const& pred,
+        std::uint64_t i,
+        unsigned k) noexcept
     {
-        return b
-            ? lut_chars(ch)
-            : lut_chars();
+        return (pred(static_cast<char>(
+                4 * k + i)) ? 1ULL << k : 0) |
+            (k == 63 ? 0 :
+                word(pred, i, k + 1));
     }
 
-    template<class Pred>
     constexpr
     static
-    lut_chars
-    construct(
-        Pred pred,
-        unsigned char ch) noexcept
+    bool
+    test(
+        std::uint64_t m0,
+        std::uint64_t m1,
+        std::uint64_t m2,
+        std::uint64_t m3,
+        unsigned c) noexcept
+    {
+        return (((c & 3) == 0 ? m0 :
+            (c & 3) == 1 ? m1 :
+            (c & 3) == 2 ? m2 : m3) >>
+                (c >> 2)) & 1;
+    }
+
+    // bits [b, 8) of tab_[i]
+    constexpr
+    static
+    unsigned char
+    nibble(
+        std::uint64_t m0,
+        std::uint64_t m1,
+        std::uint64_t m2,
+        std::uint64_t m3,
+        unsigned i,
+        unsigned b = 0) noexcept
+    {
+        return b == 8 ? 0 :
+            static_cast<unsigned char>(
+                (test(m0, m1, m2, m3,
+                    ((i >> 4) << 7) |
+                    (b << 4) | (i & 15)) ?
+                        1u << b : 0u) |
+                nibble(m0, m1, m2, m3,
+                    i, b + 1));
+    }
+
+    template<std::size_t... I>
+    constexpr
+    lut_chars(
+        std::uint64_t m0,
+        std::uint64_t m1,
+        std::uint64_t m2,
+        std::uint64_t m3,
+        mp11::index_sequence<I...>) noexcept
+        : mask_{ m0, m1, m2, m3 }
+        , tab_{ nibble(m0, m1, m2, m3, I)... }
     {
-        return ch == 255
-            ? construct(ch, pred(ch))
-            : construct(ch, pred(ch)) +
-                construct(pred, ch + 1);
     }
 
     constexpr
@@ -155,7 +208,8 @@ class lut_chars
         std::uint64_t m1,
         std::uint64_t m2,
         std::uint64_t m3) noexcept
-        : mask_{ m0, m1, m2, m3 }
+        : lut_chars(m0, m1, m2, m3,
+            mp11::make_index_sequence<32>{})
     {
     }
 
@@ -181,11 +235,11 @@ public:
     */
     constexpr
     lut_chars(char ch) noexcept
-        : mask_ {
+        : lut_chars(
             lo(ch) == 0 ? hi(ch) : 0,
             lo(ch) == 1 ? hi(ch) : 0,
             lo(ch) == 2 ? hi(ch) : 0,
-            lo(ch) == 3 ? hi(ch) : 0 }
+            lo(ch) == 3 ? hi(ch) : 0)
     {
     }
 
@@ -212,7 +266,9 @@ public:
     */
     constexpr
     lut_chars(char const* s) noexcept
-        : lut_chars(construct(s))
+        : lut_chars(
+            word(s, 0), word(s, 1),
+            word(s, 2), word(s, 3))
     {
     }
 
@@ -258,7 +314,8 @@ public:
     constexpr
     lut_chars(Pred const& pred) noexcept
         : lut_chars(
-            construct(pred, 0))
+            word(pred, 0, 0), word(pred, 1, 0),
+            word(pred, 2, 0), word(pred, 3, 0))
     {
     }
 
@@ -396,14 +453,13 @@ public:
     }
 
 #ifndef BOOST_URL_DOCS
-#ifdef BOOST_URL_USE_SSE2
     char const*
     find_if(
         char const* first,
         char const* last) const noexcept
     {
-        return detail::find_if_pred(
-            *this, first, last);
+        return detail::find_lut(
+            tab_, true, first, last);
     }
 
     char const*
@@ -411,10 +467,15 @@ public:
         char const* first,
         char const* last) const noexcept
     {
-        return detail::find_if_not_pred(
-            *this, first, last);
+        return detail::find_lut(
+            tab_, false, first, last);
+    }
+
+    unsigned char const*
+    nibble_table() const noexcept
+    {
+        return tab_;
     }
-#endif
 #endif
 };
 
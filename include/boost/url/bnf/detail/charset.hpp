@@ -10,13 +10,24 @@
 #ifndef BOOST_URL_BNF_DETAIL_CHARSET_HPP
 #define BOOST_URL_BNF_DETAIL_CHARSET_HPP
 
+#include <boost/url/detail/config.hpp>
+#include <boost/url/detail/simd.hpp>
 #include <boost/core/bit.hpp>
 #include <boost/type_traits/make_void.hpp>
+#include <cstdint>
 #include <type_traits>
 
 #ifdef BOOST_URL_USE_SSE2
 # include <emmintrin.h>
 # include <xmmintrin.h>
+# if defined(BOOST_URL_USE_SSSE3) || \
+     defined(BOOST_URL_USE_DISPATCH)
+#  include <tmmintrin.h>
+# endif
+# if defined(BOOST_URL_USE_AVX2) || \
+     defined(BOOST_URL_USE_DISPATCH)
+#  include <immintrin.h>
+# endif
 # ifdef _MSC_VER
 #  include <intrin.h>
 # endif
@@ -60,6 +71,47 @@ struct has_find_if_not<T, boost::void_t<
 {
 };
 
+template<class T, class = void>
+struct has_nibble_table : std::false_type {};
+
+template<class T>
+struct has_nibble_table<T, boost::void_t<
+    decltype(
+    std::declval<unsigned char const*&>() =
+        std::declval<T const&>().nibble_table()
+            )>> : std::true_type
+{
+};
+
+// Returns the nibble table of a lut_chars,
+// or null for other character sets.
+template<class CharSet>
+unsigned char const*
+nibble_table(
+    CharSet const&,
+    std::false_type) noexcept
+{
+    return nullptr;
+}
+
+template<class CharSet>
+unsigned char const*
+nibble_table(
+    CharSet const& cs,
+    std::true_type) noexcept
+{
+    return cs.nibble_table();
+}
+
+template<class CharSet>
+unsigned char const*
+nibble_table(
+    CharSet const& cs) noexcept
+{
+    return nibble_table(cs,
+        has_nibble_table<CharSet>{});
+}
+
 template<class Pred>
 char const*
 find_if(
@@ -121,6 +173,11 @@ find_if_not(
 #ifdef BOOST_URL_USE_SSE2
 
 // by Peter Dimov
+//
+// The predicate is still evaluated once per
+// character, but without a branch, so that
+// a run of sixteen characters costs a single
+// test of the resulting mask.
 template<class Pred>
 char const*
 find_if_pred(
@@ -130,13 +187,12 @@ find_if_pred(
 {
     while( last - first >= 16 )
     {
-        unsigned char r[ 16 ] = {};
+        unsigned r = 0;
         for( int i = 0; i < 16; ++i )
-            r[ i ] = pred( first[ i ] )? 0xFF: 0x00;
-        __m128i r2 = _mm_loadu_si128( (__m128i const*)r );
-        unsigned r3 = _mm_movemask_epi8( r2 );
-        if( r3 )
-            return first + boost::core::countr_zero( r3 );
+            r |= static_cast<unsigned>(
+                pred( first[ i ] )) << i;
+        if( r )
+            return first + boost::core::countr_zero( r );
         first += 16;
     }
     while(
@@ -158,13 +214,12 @@ find_if_not_pred(
 {
     while( last - first >= 16 )
     {
-        unsigned char r[ 16 ] = {};
+        unsigned r = 0;
         for( int i = 0; i < 16; ++i )
-            r[ i ] = pred( first[ i ] )? 0x00: 0xFF;
-        __m128i r2 = _mm_loadu_si128( (__m128i const*)r );
-        unsigned r3 = _mm_movemask_epi8( r2 );
-        if( r3 )
-            return first + boost::core::countr_zero( r3 );
+            r |= static_cast<unsigned>(
+                ! pred( first[ i ] )) << i;
+        if( r )
+            return first + boost::core::countr_zero( r );
         first += 16;
     }
     while(
@@ -178,6 +233,268 @@ find_if_not_pred(
 
 #endif
 
+// Returns true if `c` is in the set
+// described by the nibble table `tab`,
+// see lut_chars.
+inline
+bool
+lut_test(
+    unsigned char const* tab,
+    char c) noexcept
+{
+    auto const u = static_cast<
+        unsigned char>(c);
+    return ((tab[((u >> 7) << 4) | (u & 15)]
+        >> ((u >> 4) & 7)) & 1) != 0;
+}
+
+// Find the first character for which
+// the set membership equals `want`,
+// using the nibble table in `tab`.
+// The lookup needs PSHUFB, so this is
+// also the kernel used with only SSE2.
+inline
+char const*
+find_lut_scalar(
+    unsigned char const* tab,
+    bool want,
+    char const* first,
+    char const* last) noexcept
+{
+    while(
+        first != last &&
+        lut_test(tab, *first) != want)
+        ++first;
+    return first;
+}
+
+#if defined(BOOST_URL_USE_SSSE3) || \
+    defined(BOOST_URL_USE_DISPATCH)
+
+/*  Nibble-split lookup
+
+    A character set is stored as two tables
+    of sixteen bytes each, indexed by the low
+    nibble of the character. Bit `b` of entry
+    `t[lo]` in the first table is set if the
+    character `(b << 4) | lo` is in the set,
+    and the second table does the same for
+    the characters with the high bit set.
+    PSHUFB performs sixteen lookups at once,
+    returning zero for any index with its high
+    bit set, which selects the right table.
+    A second PSHUFB turns the high nibble into
+    the bit to test.
+
+    When the compiler does not target SSSE3
+    or AVX2, these functions are only called
+    through the kernel table in detail/simd.hpp
+    after checking the processor.
+*/
+
+// returns a mask with bit i set if
+// the i-th character of v is in the set
+BOOST_URL_TARGET_SSSE3
+inline
+unsigned
+lut_members(
+    __m128i v,
+    __m128i t0,
+    __m128i t1) noexcept
+{
+    __m128i const bits = _mm_setr_epi8(
+        1, 2, 4, 8, 16, 32, 64, -128,
+        1, 2, 4, 8, 16, 32, 64, -128);
+    __m128i const lo = _mm_and_si128(
+        v, _mm_set1_epi8(
+            static_cast<char>(0x8f)));
+    __m128i const hi = _mm_and_si128(
+        _mm_srli_epi16(v, 4),
+        _mm_set1_epi8(0x0f));
+    __m128i const row = _mm_or_si128(
+        _mm_shuffle_epi8(t0, lo),
+        _mm_shuffle_epi8(t1, _mm_xor_si128(
+            lo, _mm_set1_epi8(
+                static_cast<char>(0x80)))));
+    __m128i const m = _mm_and_si128(
+        row, _mm_shuffle_epi8(bits, hi));
+    return static_cast<unsigned>(
+        _mm_movemask_epi8(_mm_cmpeq_epi8(
+            m, _mm_setzero_si128()))) ^ 0xffff;
+}
+
+BOOST_URL_TARGET_SSSE3
+inline
+char const*
+find_lut_ssse3(
+    unsigned char const* tab,
+    bool want,
+    char const* first,
+    char const* last) noexcept
+{
+    if(last - first < 16)
+        return find_lut_scalar(
+            tab, want, first, last);
+    unsigned const flip =
+        want ? 0 : 0xffff;
+    __m128i const t0 = _mm_loadu_si128(
+        reinterpret_cast<
+            __m128i const*>(tab));
+    __m128i const t1 = _mm_loadu_si128(
+        reinterpret_cast<
+            __m128i const*>(tab + 16));
+    while(last - first >= 16)
+    {
+        unsigned const r = flip ^
+            lut_members(_mm_loadu_si128(
+                reinterpret_cast<
+                    __m128i const*>(first)),
+                t0, t1);
+        if(r)
+            return first +
+                boost::core::countr_zero(r);
+        first += 16;
+    }
+    if(first == last)
+        return last;
+    // The input is at least 16 chars, so
+    // the tail is handled by re-reading
+    // the last 16, ignoring the overlap.
+    auto const n = static_cast<
+        unsigned>(16 - (last - first));
+    unsigned const r = (flip ^
+        lut_members(_mm_loadu_si128(
+            reinterpret_cast<
+                __m128i const*>(last - 16)),
+            t0, t1)) >> n;
+    if(r)
+        return first +
+            boost::core::countr_zero(r);
+    return last;
+}
+
+#endif
+
+#if defined(BOOST_URL_USE_AVX2) || \
+    defined(BOOST_URL_USE_DISPATCH)
+
+BOOST_URL_TARGET_AVX2
+inline
+std::uint32_t
+lut_members(
+    __m256i v,
+    __m256i t0,
+    __m256i t1) noexcept
+{
+    __m256i const bits = _mm256_setr_epi8(
+        1, 2, 4, 8, 16, 32, 64, -128,
+        1, 2, 4, 8, 16, 32, 64, -128,
+        1, 2, 4, 8, 16, 32, 64, -128,
+        1, 2, 4, 8, 16, 32, 64, -128);
+    __m256i const lo = _mm256_and_si256(
+        v, _mm256_set1_epi8(
+            static_cast<char>(0x8f)));
+    __m256i const hi = _mm256_and_si256(
+        _mm256_srli_epi16(v, 4),
+        _mm256_set1_epi8(0x0f));
+    __m256i const row = _mm256_or_si256(
+        _mm256_shuffle_epi8(t0, lo),
+        _mm256_shuffle_epi8(t1, _mm256_xor_si256(
+            lo, _mm256_set1_epi8(
+                static_cast<char>(0x80)))));
+    __m256i const m = _mm256_and_si256(
+        row, _mm256_shuffle_epi8(bits, hi));
+    return ~static_cast<std::uint32_t>(
+        _mm256_movemask_epi8(_mm256_cmpeq_epi8(
+            m, _mm256_setzero_si256())));
+}
+
+BOOST_URL_TARGET_AVX2
+inline
+char const*
+find_lut_avx2(
+    unsigned char const* tab,
+    bool want,
+    char const* first,
+    char const* last) noexcept
+{
+    if(last - first < 32)
+        return find_lut_ssse3(
+            tab, want, first, last);
+    std::uint32_t const flip =
+        want ? 0 : 0xffffffff;
+    __m256i const t0 =
+        _mm256_broadcastsi128_si256(
+            _mm_loadu_si128(
+                reinterpret_cast<
+                    __m128i const*>(tab)));
+    __m256i const t1 =
+        _mm256_broadcastsi128_si256(
+            _mm_loadu_si128(
+                reinterpret_cast<
+                    __m128i const*>(tab + 16)));
+    while(last - first >= 32)
+    {
+        std::uint32_t const r = flip ^
+            lut_members(_mm256_loadu_si256(
+                reinterpret_cast<
+                    __m256i const*>(first)),
+                t0, t1);
+        if(r)
+            return first +
+                boost::core::countr_zero(r);
+        first += 32;
+    }
+    if(first == last)
+        return last;
+    auto const n = static_cast<
+        unsigned>(32 - (last - first));
+    std::uint32_t const r = (flip ^
+        lut_members(_mm256_loadu_si256(
+            reinterpret_cast<
+                __m256i const*>(last - 32)),
+            t0, t1)) >> n;
+    if(r)
+        return first +
+            boost::core::countr_zero(r);
+    return last;
+}
+
+#endif
+
+// Find the first character for which
+// the set membership equals `want`,
+// with the best kernel available.
+inline
+char const*
+find_lut(
+    unsigned char const* tab,
+    bool want,
+    char const* first,
+    char const* last) noexcept
+{
+#if defined(BOOST_URL_USE_AVX2)
+    return find_lut_avx2(
+        tab, want, first, last);
+#else
+    // short runs are common in URLs,
+    // and not worth an indirect call
+    if(last - first < 16)
+        return find_lut_scalar(
+            tab, want, first, last);
+# if defined(BOOST_URL_USE_DISPATCH)
+    return urls::detail::active_simd_kernels(
+        ).find_lut(tab, want, first, last);
+# elif defined(BOOST_URL_USE_SSSE3)
+    return find_lut_ssse3(
+        tab, want, first, last);
+# else
+    return find_lut_scalar(
+        tab, want, first, last);
+# endif
+#endif
+}
+
 } // detail
 } // bnf
 } // urls
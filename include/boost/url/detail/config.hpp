@@ -49,6 +49,53 @@
 # endif
 #endif
 
+// When the compiler is already targeting
+// SSSE3 or AVX2 their kernels are called
+// directly. Otherwise BOOST_URL_USE_DISPATCH
+// below builds them anyway, and the fastest
+// one the CPU supports is chosen at run time.
+#if defined(BOOST_URL_USE_SSE2) && \
+    ! defined(BOOST_URL_NO_SSSE3) && \
+    ! defined(BOOST_URL_USE_SSSE3)
+# if defined(__SSSE3__) || defined(__AVX__)
+#  define BOOST_URL_USE_SSSE3
+# endif
+#endif
+
+#if defined(BOOST_URL_USE_SSSE3) && \
+    ! defined(BOOST_URL_NO_AVX2) && \
+    ! defined(BOOST_URL_USE_AVX2)
+# if defined(__AVX2__)
+#  define BOOST_URL_USE_AVX2
+# endif
+#endif
+
+// Kernels for instruction sets above the
+// compiler's target are built with function
+// attributes and chosen at run time.
+#if defined(BOOST_URL_USE_SSE2) && \
+    ! defined(BOOST_URL_USE_AVX2) && \
+    ! defined(BOOST_URL_NO_DISPATCH)
+# if defined(_MSC_VER) && ! defined(__clang__)
+#  define BOOST_URL_USE_DISPATCH
+# elif defined(__clang__) || ( \
+    defined(BOOST_GCC_VERSION) && \
+    BOOST_GCC_VERSION >= 40900)
+#  define BOOST_URL_USE_DISPATCH
+#  define BOOST_URL_TARGET_SSSE3 \
+    __attribute__((target("ssse3")))
+#  define BOOST_URL_TARGET_AVX2 \
+    __attribute__((target("avx2")))
+# endif
+#endif
+
+#ifndef BOOST_URL_TARGET_SSSE3
+# define BOOST_URL_TARGET_SSSE3
+#endif
+#ifndef BOOST_URL_TARGET_AVX2
+# define BOOST_URL_TARGET_AVX2
+#endif
+
 // This macro is used for the limits
 // test which sets the value lower,
 // to exercise code coverage.
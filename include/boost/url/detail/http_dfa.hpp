@@ -0,0 +1,261 @@
+//
+// Copyright (c) 2019 Vinnie Falco (vinnie.falco@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/CPPAlliance/url
+//
+
+#ifndef BOOST_URL_DETAIL_HTTP_DFA_HPP
+#define BOOST_URL_DETAIL_HTTP_DFA_HPP
+
+#include <boost/url/detail/config.hpp>
+#include <boost/mp11/integer_sequence.hpp>
+#include <cstddef>
+
+namespace boost {
+namespace urls {
+namespace detail {
+
+/*  A DFA for what follows "http://" or
+    "https://" in the common URLs, a
+    reg-name host with no userinfo:
+
+        host [ ":" port ] path-abempty
+            [ "?" query ] [ "#" fragment ]
+
+    Each char moves to the state of the
+    part it belongs to, so the delimiters
+    ':', '?' and '#' start their part,
+    and '/' and '&' have states of their
+    own to be counted. A host starting
+    with a digit may be an IPv4address,
+    and is left to the general parser
+    with the other rare forms, by moving
+    to st_bail.
+*/
+namespace http_dfa {
+
+// character classes
+constexpr unsigned char cc_bad = 0;      // not in any part
+constexpr unsigned char cc_alpha = 1;    // ALPHA, not HEXDIG
+constexpr unsigned char cc_hexalpha = 2; // ALPHA, HEXDIG
+constexpr unsigned char cc_digit = 3;
+constexpr unsigned char cc_mark = 4;     // "-" / "." / "_" / "~"
+constexpr unsigned char cc_sub = 5;      // sub-delims, not "&"
+constexpr unsigned char cc_amp = 6;
+constexpr unsigned char cc_colon = 7;
+constexpr unsigned char cc_at = 8;
+constexpr unsigned char cc_slash = 9;
+constexpr unsigned char cc_qmark = 10;
+constexpr unsigned char cc_hash = 11;
+constexpr unsigned char cc_pct = 12;
+constexpr std::size_t cc_count = 16;
+
+// states
+constexpr unsigned char st_bail = 0;     // not handled
+constexpr unsigned char st_host0 = 1;    // start of host
+constexpr unsigned char st_host = 2;
+constexpr unsigned char st_port = 3;     // ':' and the digits
+constexpr unsigned char st_slash = 4;    // '/' in the path
+constexpr unsigned char st_path = 5;
+constexpr unsigned char st_path1 = 6;    // after '%'
+constexpr unsigned char st_path2 = 7;    // after '%' HEXDIG
+constexpr unsigned char st_query0 = 8;   // '?'
+constexpr unsigned char st_amp = 9;      // '&' in the query
+constexpr unsigned char st_query = 10;
+constexpr unsigned char st_query1 = 11;
+constexpr unsigned char st_query2 = 12;
+constexpr unsigned char st_frag0 = 13;   // '#'
+constexpr unsigned char st_frag1 = 14;
+constexpr unsigned char st_frag2 = 15;
+constexpr unsigned char st_frag = 16;
+constexpr std::size_t st_count = 17;
+
+constexpr
+unsigned char
+char_class(unsigned char c) noexcept
+{
+    return
+        (c >= 'a' && c <= 'f') ||
+        (c >= 'A' && c <= 'F') ?
+            cc_hexalpha :
+        (c >= 'a' && c <= 'z') ||
+        (c >= 'A' && c <= 'Z') ?
+            cc_alpha :
+        (c >= '0' && c <= '9') ?
+            cc_digit :
+        c == '-' || c == '.' ||
+        c == '_' || c == '~' ?
+            cc_mark :
+        c == '!' || c == '$' ||
+        c == '\'' || c == '(' ||
+        c == ')' || c == '*' ||
+        c == '+' || c == ',' ||
+        c == ';' || c == '=' ?
+            cc_sub :
+        c == '&' ? cc_amp :
+        c == ':' ? cc_colon :
+        c == '@' ? cc_at :
+        c == '/' ? cc_slash :
+        c == '?' ? cc_qmark :
+        c == '#' ? cc_hash :
+        c == '%' ? cc_pct :
+        cc_bad;
+}
+
+constexpr
+bool
+is_hexdig(unsigned char k) noexcept
+{
+    return
+        k == cc_hexalpha ||
+        k == cc_digit;
+}
+
+// pchar, without the escapes
+constexpr
+bool
+is_pchar(unsigned char k) noexcept
+{
+    return
+        k == cc_alpha ||
+        k == cc_hexalpha ||
+        k == cc_digit ||
+        k == cc_mark ||
+        k == cc_sub ||
+        k == cc_amp ||
+        k == cc_colon ||
+        k == cc_at;
+}
+
+// the state after a path, query, or
+// fragment char which is not in pchar
+constexpr
+unsigned char
+next_delim(
+    unsigned char s,
+    unsigned char k) noexcept
+{
+    return
+        k == cc_qmark ? (
+            s < st_query0 ? st_query0 :
+            s < st_frag0 ? st_query :
+            st_frag) :
+        k == cc_hash ? (
+            s < st_frag0 ? st_frag0 :
+            st_bail) :
+        k == cc_slash ? (
+            s < st_query0 ? st_slash :
+            s < st_frag0 ? st_query :
+            st_frag) :
+        k == cc_pct ? (
+            s < st_query0 ? st_path1 :
+            s < st_frag0 ? st_query1 :
+            st_frag1) :
+        st_bail;
+}
+
+constexpr
+unsigned char
+next_state(
+    unsigned char s,
+    unsigned char k) noexcept
+{
+    return
+        s == st_host0 || s == st_host ? (
+            k == cc_alpha ||
+            k == cc_hexalpha ||
+            k == cc_mark ? st_host :
+            k == cc_digit ? (
+                s == st_host ? st_host :
+                st_bail) :
+            k == cc_colon ? st_port :
+            k == cc_slash ||
+            k == cc_qmark ||
+            k == cc_hash ?
+                next_delim(st_slash, k) :
+            st_bail) :
+        s == st_port ? (
+            k == cc_digit ? st_port :
+            k == cc_slash ||
+            k == cc_qmark ||
+            k == cc_hash ?
+                next_delim(st_slash, k) :
+            st_bail) :
+        s == st_path1 ? (
+            is_hexdig(k) ? st_path2 : st_bail) :
+        s == st_path2 ? (
+            is_hexdig(k) ? st_path : st_bail) :
+        s == st_query1 ? (
+            is_hexdig(k) ? st_query2 : st_bail) :
+        s == st_query2 ? (
+            is_hexdig(k) ? st_query : st_bail) :
+        s == st_frag1 ? (
+            is_hexdig(k) ? st_frag2 : st_bail) :
+        s == st_frag2 ? (
+            is_hexdig(k) ? st_frag : st_bail) :
+        s == st_slash || s == st_path ? (
+            is_pchar(k) ? st_path :
+            next_delim(s, k)) :
+        s == st_query0 || s == st_amp ||
+        s == st_query ? (
+            k == cc_amp ? st_amp :
+            is_pchar(k) ? st_query :
+            next_delim(s, k)) :
+        s == st_frag0 || s == st_frag ? (
+            is_pchar(k) ? st_frag :
+            next_delim(s, k)) :
+        st_bail;
+}
+
+// true if the URL may end in state s
+constexpr
+bool
+is_final(unsigned char s) noexcept
+{
+    return
+        s != st_bail &&
+        s != st_path1 && s != st_path2 &&
+        s != st_query1 && s != st_query2 &&
+        s != st_frag1 && s != st_frag2;
+}
+
+struct tables
+{
+    unsigned char cls[256];
+    unsigned char next[
+        st_count * cc_count];
+};
+
+template<
+    std::size_t... I,
+    std::size_t... J>
+constexpr
+tables
+make_tables(
+    mp11::index_sequence<I...>,
+    mp11::index_sequence<J...>) noexcept
+{
+    return {
+        { char_class(I)... },
+        { next_state(
+            static_cast<unsigned char>(
+                J / cc_count),
+            static_cast<unsigned char>(
+                J % cc_count))... } };
+}
+
+constexpr tables tab = make_tables(
+    mp11::make_index_sequence<256>{},
+    mp11::make_index_sequence<
+        st_count * cc_count>{});
+
+} // http_dfa
+
+} // detail
+} // urls
+} // boost
+
+#endif
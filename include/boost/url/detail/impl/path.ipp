@@ -11,11 +11,143 @@
 #define BOOST_URL_DETAIL_IMPL_PATH_IPP
 
 #include <boost/url/detail/path.hpp>
+#include <boost/assert.hpp>
+#include <cstring>
 
 namespace boost {
 namespace urls {
 namespace detail {
 
+std::size_t
+remove_dot_segments(
+    char* p,
+    std::size_t n,
+    bool has_scheme,
+    bool has_authority,
+    std::size_t& nseg) noexcept
+{
+    if( n == 0 || (
+        n == 1 && p[0] == '/'))
+    {
+        nseg = 0;
+        return n;
+    }
+    bool const abs = p[0] == '/';
+    auto const end = p + n;
+    auto const n0 = path_prefix(
+        string_view(p, n));
+
+    // Rewrite the segments over
+    // themselves, the output never
+    // gets ahead of the input.
+    char* const first = p + n0;
+    char* dest = first;
+    std::size_t nout = 0;
+    std::size_t nrem = 0;
+    auto const emit = [&](
+        char const* s,
+        std::size_t len)
+    {
+        if(nout++ > 0)
+            *dest++ = '/';
+        if(dest != s)
+            std::memmove(dest, s, len);
+        dest += len;
+    };
+    char const* it = first;
+    for(;;)
+    {
+        auto sep = static_cast<
+            char const*>(std::memchr(
+                it, '/', end - it));
+        if(! sep)
+            sep = end;
+        string_view const s(it, sep - it);
+        bool const last = sep == end;
+        if(s == ".")
+        {
+            if(last)
+                emit(it, 0);
+        }
+        else if(s == "..")
+        {
+            if(nrem > 0)
+            {
+                // remove the
+                // previous segment
+                --nrem;
+                if(--nout > 0)
+                    while(*--dest != '/')
+                    {
+                    }
+                else
+                    dest = first;
+                if( last &&
+                    nout > 0)
+                    emit(it, 0);
+            }
+            else
+            {
+                emit(it, s.size());
+            }
+        }
+        else
+        {
+            emit(it, s.size());
+            ++nrem;
+        }
+        if(last)
+            break;
+        it = sep + 1;
+    }
+    // a lone empty segment
+    // is the empty path
+    if( nout == 1 &&
+        dest == first)
+        nout = 0;
+
+    // the new prefix
+    string_view front(first, 0);
+    if(nout > 0)
+    {
+        auto const e = std::memchr(
+            first, '/', dest - first);
+        front = string_view(first, (e ?
+            static_cast<char const*>(e) :
+            dest) - first);
+    }
+    string_view prefix;
+    if(abs)
+    {
+        if( nout > 0 &&
+            front.empty() &&
+            ! has_authority)
+            prefix = "/./";
+        else
+            prefix = "/";
+    }
+    else if(
+        nout > 0 && (
+        front.empty() || (
+            ! has_scheme &&
+            front.find_first_of(':') !=
+                string_view::npos)))
+    {
+        prefix = "./";
+    }
+    auto const n1 = dest - first;
+    BOOST_ASSERT(
+        prefix.size() + n1 <= n);
+    if(prefix.size() != n0)
+        std::memmove(p + prefix.size(),
+            first, n1);
+    if(! prefix.empty())
+        std::memcpy(p,
+            prefix.data(), prefix.size());
+    nseg = nout;
+    return prefix.size() + n1;
+}
+
 } // detail
 } // url
 } // boost
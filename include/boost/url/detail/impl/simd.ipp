@@ -0,0 +1,867 @@
+//
+// Copyright (c) 2019 Vinnie Falco (vinnie.falco@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/CPPAlliance/url
+//
+
+#ifndef BOOST_URL_DETAIL_IMPL_SIMD_IPP
+#define BOOST_URL_DETAIL_IMPL_SIMD_IPP
+
+#include <boost/url/detail/simd.hpp>
+#include <boost/url/bnf/charset.hpp>
+#include <boost/url/bnf/detail/charset.hpp>
+#include <boost/core/bit.hpp>
+#include <cstdint>
+#include <cstring>
+
+#ifdef BOOST_URL_USE_DISPATCH
+# ifdef _MSC_VER
+#  include <intrin.h>
+# else
+#  include <cpuid.h>
+# endif
+#endif
+
+namespace boost {
+namespace urls {
+namespace detail {
+
+static
+char const*
+find_pct_scalar(
+    char const* first,
+    char const* last,
+    bool plus) noexcept
+{
+    while(first != last)
+    {
+        if( *first == '%' ||
+            (plus && *first == '+'))
+            break;
+        ++first;
+    }
+    return first;
+}
+
+#ifdef BOOST_URL_USE_SSE2
+
+static
+char const*
+find_pct_sse2(
+    char const* first,
+    char const* last,
+    bool plus) noexcept
+{
+    __m128i const c0 =
+        _mm_set1_epi8('%');
+    __m128i const c1 =
+        _mm_set1_epi8(plus ? '+' : '%');
+    while(last - first >= 16)
+    {
+        __m128i const v = _mm_loadu_si128(
+            reinterpret_cast<
+                __m128i const*>(first));
+        unsigned const r =
+            static_cast<unsigned>(
+                _mm_movemask_epi8(_mm_or_si128(
+                    _mm_cmpeq_epi8(v, c0),
+                    _mm_cmpeq_epi8(v, c1))));
+        if(r)
+            return first +
+                boost::core::countr_zero(r);
+        first += 16;
+    }
+    return find_pct_scalar(
+        first, last, plus);
+}
+
+#endif
+
+#if defined(BOOST_URL_USE_AVX2) || \
+    defined(BOOST_URL_USE_DISPATCH)
+
+BOOST_URL_TARGET_AVX2
+static
+char const*
+find_pct_avx2(
+    char const* first,
+    char const* last,
+    bool plus) noexcept
+{
+    __m256i const c0 =
+        _mm256_set1_epi8('%');
+    __m256i const c1 =
+        _mm256_set1_epi8(plus ? '+' : '%');
+    while(last - first >= 32)
+    {
+        __m256i const v = _mm256_loadu_si256(
+            reinterpret_cast<
+                __m256i const*>(first));
+        std::uint32_t const r =
+            static_cast<std::uint32_t>(
+                _mm256_movemask_epi8(_mm256_or_si256(
+                    _mm256_cmpeq_epi8(v, c0),
+                    _mm256_cmpeq_epi8(v, c1))));
+        if(r)
+            return first +
+                boost::core::countr_zero(r);
+        first += 32;
+    }
+    return find_pct_sse2(
+        first, last, plus);
+}
+
+#endif
+
+//------------------------------------------------
+
+static
+std::size_t
+decode_pct_scalar(
+    char* dest,
+    char const* first,
+    char const* last) noexcept
+{
+    std::size_t n = 0;
+    while(
+        last - first >= 3 &&
+        first[0] == '%')
+    {
+        auto const d0 =
+            bnf::hexdig_value(first[1]);
+        auto const d1 =
+            bnf::hexdig_value(first[2]);
+        if( d0 == -1 ||
+            d1 == -1)
+            break;
+        *dest++ = static_cast<char>(
+            (d0 << 4) + d1);
+        first += 3;
+        ++n;
+    }
+    return n;
+}
+
+#ifdef BOOST_URL_USE_SSE2
+
+// Return the values of the hex digits
+// in v, setting ok to all ones in the
+// lanes which hold a hex digit
+static
+inline
+__m128i
+hex_values(
+    __m128i v,
+    __m128i& ok) noexcept
+{
+    __m128i const d = _mm_sub_epi8(
+        v, _mm_set1_epi8('0'));
+    __m128i const is_d = _mm_cmpeq_epi8(
+        _mm_min_epu8(d, _mm_set1_epi8(9)), d);
+    __m128i const a = _mm_sub_epi8(
+        _mm_or_si128(v, _mm_set1_epi8(0x20)),
+        _mm_set1_epi8('a'));
+    __m128i const is_a = _mm_cmpeq_epi8(
+        _mm_min_epu8(a, _mm_set1_epi8(5)), a);
+    ok = _mm_or_si128(is_d, is_a);
+    return _mm_or_si128(
+        _mm_and_si128(is_d, d),
+        _mm_and_si128(is_a, _mm_add_epi8(
+            a, _mm_set1_epi8(10))));
+}
+
+#endif
+
+#if defined(BOOST_URL_USE_SSSE3) || \
+    defined(BOOST_URL_USE_DISPATCH)
+
+// Each 16 chars hold 5 escapes, whose
+// chars are gathered into the first
+// 5 lanes with a shuffle.
+BOOST_URL_TARGET_SSSE3
+static
+std::size_t
+decode_pct_ssse3(
+    char* dest,
+    char const* first,
+    char const* last) noexcept
+{
+    __m128i const pi = _mm_setr_epi8(
+        0, 3, 6, 9, 12, -1, -1, -1,
+        -1, -1, -1, -1, -1, -1, -1, -1);
+    __m128i const hi = _mm_setr_epi8(
+        1, 4, 7, 10, 13, -1, -1, -1,
+        -1, -1, -1, -1, -1, -1, -1, -1);
+    __m128i const lo = _mm_setr_epi8(
+        2, 5, 8, 11, 14, -1, -1, -1,
+        -1, -1, -1, -1, -1, -1, -1, -1);
+    std::size_t n = 0;
+    while(last - first >= 16)
+    {
+        __m128i const v = _mm_loadu_si128(
+            reinterpret_cast<
+                __m128i const*>(first));
+        __m128i ok0;
+        __m128i ok1;
+        __m128i const d0 = hex_values(
+            _mm_shuffle_epi8(v, hi), ok0);
+        __m128i const d1 = hex_values(
+            _mm_shuffle_epi8(v, lo), ok1);
+        __m128i const ok = _mm_and_si128(
+            _mm_and_si128(ok0, ok1),
+            _mm_cmpeq_epi8(
+                _mm_shuffle_epi8(v, pi),
+                _mm_set1_epi8('%')));
+        // the digits are below 16, so the
+        // shift stays within each byte
+        char tmp[16];
+        _mm_storeu_si128(
+            reinterpret_cast<__m128i*>(tmp),
+            _mm_or_si128(
+                _mm_slli_epi16(d0, 4), d1));
+        unsigned const m =
+            _mm_movemask_epi8(ok) & 0x1f;
+        if(m != 0x1f)
+        {
+            // the valid escapes
+            // before the first invalid
+            auto const k = static_cast<
+                std::size_t>(boost::core::
+                    countr_zero(~m));
+            std::memcpy(dest, tmp, k);
+            return n + k;
+        }
+        std::memcpy(dest, tmp, 5);
+        dest += 5;
+        first += 15;
+        n += 5;
+    }
+    return n + decode_pct_scalar(
+        dest, first, last);
+}
+
+#endif
+
+#if defined(BOOST_URL_USE_AVX2) || \
+    defined(BOOST_URL_USE_DISPATCH)
+
+BOOST_URL_TARGET_AVX2
+static
+inline
+__m256i
+hex_values(
+    __m256i v,
+    __m256i& ok) noexcept
+{
+    __m256i const d = _mm256_sub_epi8(
+        v, _mm256_set1_epi8('0'));
+    __m256i const is_d = _mm256_cmpeq_epi8(
+        _mm256_min_epu8(d, _mm256_set1_epi8(9)), d);
+    __m256i const a = _mm256_sub_epi8(
+        _mm256_or_si256(v, _mm256_set1_epi8(0x20)),
+        _mm256_set1_epi8('a'));
+    __m256i const is_a = _mm256_cmpeq_epi8(
+        _mm256_min_epu8(a, _mm256_set1_epi8(5)), a);
+    ok = _mm256_or_si256(is_d, is_a);
+    return _mm256_or_si256(
+        _mm256_and_si256(is_d, d),
+        _mm256_and_si256(is_a, _mm256_add_epi8(
+            a, _mm256_set1_epi8(10))));
+}
+
+// Each lane holds the 5 escapes in 15 of
+// 16 chars, so the lanes are loaded from
+// first and first + 15.
+BOOST_URL_TARGET_AVX2
+static
+std::size_t
+decode_pct_avx2(
+    char* dest,
+    char const* first,
+    char const* last) noexcept
+{
+    __m256i const pi = _mm256_setr_epi8(
+        0, 3, 6, 9, 12, -1, -1, -1,
+        -1, -1, -1, -1, -1, -1, -1, -1,
+        0, 3, 6, 9, 12, -1, -1, -1,
+        -1, -1, -1, -1, -1, -1, -1, -1);
+    __m256i const hi = _mm256_setr_epi8(
+        1, 4, 7, 10, 13, -1, -1, -1,
+        -1, -1, -1, -1, -1, -1, -1, -1,
+        1, 4, 7, 10, 13, -1, -1, -1,
+        -1, -1, -1, -1, -1, -1, -1, -1);
+    __m256i const lo = _mm256_setr_epi8(
+        2, 5, 8, 11, 14, -1, -1, -1,
+        -1, -1, -1, -1, -1, -1, -1, -1,
+        2, 5, 8, 11, 14, -1, -1, -1,
+        -1, -1, -1, -1, -1, -1, -1, -1);
+    std::size_t n = 0;
+    while(last - first >= 31)
+    {
+        __m256i const v = _mm256_inserti128_si256(
+            _mm256_castsi128_si256(_mm_loadu_si128(
+                reinterpret_cast<
+                    __m128i const*>(first))),
+            _mm_loadu_si128(reinterpret_cast<
+                __m128i const*>(first + 15)), 1);
+        __m256i ok0;
+        __m256i ok1;
+        __m256i const d0 = hex_values(
+            _mm256_shuffle_epi8(v, hi), ok0);
+        __m256i const d1 = hex_values(
+            _mm256_shuffle_epi8(v, lo), ok1);
+        __m256i const ok = _mm256_and_si256(
+            _mm256_and_si256(ok0, ok1),
+            _mm256_cmpeq_epi8(
+                _mm256_shuffle_epi8(v, pi),
+                _mm256_set1_epi8('%')));
+        char tmp[32];
+        _mm256_storeu_si256(
+            reinterpret_cast<__m256i*>(tmp),
+            _mm256_or_si256(
+                _mm256_slli_epi16(d0, 4), d1));
+        std::uint32_t const m =
+            static_cast<std::uint32_t>(
+                _mm256_movemask_epi8(ok)) &
+                    0x1f001f;
+        if(m != 0x1f001f)
+        {
+            // the valid escapes
+            // before the first invalid
+            auto k = static_cast<
+                std::size_t>(boost::core::
+                    countr_zero(~m));
+            if(k < 5)
+            {
+                std::memcpy(dest, tmp, k);
+                return n + k;
+            }
+            k = static_cast<std::size_t>(
+                boost::core::countr_zero(
+                    ~(m >> 16)));
+            std::memcpy(dest, tmp, 5);
+            std::memcpy(dest + 5, tmp + 16, k);
+            return n + 5 + k;
+        }
+        std::memcpy(dest, tmp, 5);
+        std::memcpy(dest + 5, tmp + 16, 5);
+        dest += 10;
+        first += 30;
+        n += 10;
+    }
+    return n + decode_pct_ssse3(
+        dest, first, last);
+}
+
+#endif
+
+//------------------------------------------------
+
+static
+std::size_t
+encoded_size_scalar(
+    unsigned char const* tab,
+    bool plus,
+    char const* first,
+    char const* last) noexcept
+{
+    std::size_t n = 0;
+    while(first != last)
+    {
+        if( bnf::detail::lut_test(
+                tab, *first) ||
+            (plus && *first == ' '))
+            ++n;
+        else
+            n += 3;
+        ++first;
+    }
+    return n;
+}
+
+static
+char*
+encode_pct_scalar(
+    unsigned char const* tab,
+    bool plus,
+    char* dest,
+    char const* end,
+    char const*& first,
+    char const* last) noexcept
+{
+    static constexpr char hex[] =
+        "0123456789abcdef";
+    while(first != last)
+    {
+        auto const c = *first;
+        if(bnf::detail::lut_test(tab, c))
+        {
+            if(dest == end)
+                break;
+            *dest++ = c;
+        }
+        else if(plus && c == ' ')
+        {
+            if(dest == end)
+                break;
+            *dest++ = '+';
+        }
+        else
+        {
+            if(end - dest < 3)
+                break;
+            auto const u = static_cast<
+                unsigned char>(c);
+            dest[0] = '%';
+            dest[1] = hex[u >> 4];
+            dest[2] = hex[u & 15];
+            dest += 3;
+        }
+        ++first;
+    }
+    return dest;
+}
+
+#if defined(BOOST_URL_USE_SSSE3) || \
+    defined(BOOST_URL_USE_DISPATCH)
+
+// Returns the chars of v with the spaces
+// replaced by '+', adding the spaces to
+// the members in m.
+BOOST_URL_TARGET_SSSE3
+static
+inline
+__m128i
+space_to_plus(
+    __m128i v,
+    unsigned& m) noexcept
+{
+    __m128i const sp = _mm_cmpeq_epi8(
+        v, _mm_set1_epi8(' '));
+    m |= static_cast<unsigned>(
+        _mm_movemask_epi8(sp));
+    return _mm_or_si128(
+        _mm_andnot_si128(sp, v),
+        _mm_and_si128(sp,
+            _mm_set1_epi8('+')));
+}
+
+BOOST_URL_TARGET_SSSE3
+static
+std::size_t
+encoded_size_ssse3(
+    unsigned char const* tab,
+    bool plus,
+    char const* first,
+    char const* last) noexcept
+{
+    __m128i const t0 = _mm_loadu_si128(
+        reinterpret_cast<
+            __m128i const*>(tab));
+    __m128i const t1 = _mm_loadu_si128(
+        reinterpret_cast<
+            __m128i const*>(tab + 16));
+    std::size_t n = 0;
+    while(last - first >= 16)
+    {
+        __m128i const v = _mm_loadu_si128(
+            reinterpret_cast<
+                __m128i const*>(first));
+        unsigned m = bnf::detail::lut_members(
+            v, t0, t1);
+        if(plus)
+            space_to_plus(v, m);
+        // each escape adds two chars
+        n += 16 + 2 * static_cast<
+            std::size_t>(boost::core::popcount(
+                ~m & 0xffffu));
+        first += 16;
+    }
+    return n + encoded_size_scalar(
+        tab, plus, first, last);
+}
+
+/*  Escapes are expanded four chars at a
+    time. The chars, the two hex digits of
+    each char, and four '%' are gathered
+    into one register, and a shuffle chosen
+    by the membership of the four chars
+    writes each char, or its escape.
+*/
+BOOST_URL_TARGET_SSSE3
+static
+inline
+char*
+expand_pct(
+    char* dest,
+    __m128i v,
+    unsigned m) noexcept
+{
+    // from the layout
+    //  0..3    chars
+    //  4..7    high hex digits
+    //  8..11   low hex digits
+    //  12..15  '%'
+    static signed char const shuf[16][16] = {
+        { 12, 4, 8, 12, 5, 9, 12, 6, 10, 12, 7, 11, -1, -1, -1, -1 },
+        { 0, 12, 5, 9, 12, 6, 10, 12, 7, 11, -1, -1, -1, -1, -1, -1 },
+        { 12, 4, 8, 1, 12, 6, 10, 12, 7, 11, -1, -1, -1, -1, -1, -1 },
+        { 0, 1, 12, 6, 10, 12, 7, 11, -1, -1, -1, -1, -1, -1, -1, -1 },
+        { 12, 4, 8, 12, 5, 9, 2, 12, 7, 11, -1, -1, -1, -1, -1, -1 },
+        { 0, 12, 5, 9, 2, 12, 7, 11, -1, -1, -1, -1, -1, -1, -1, -1 },
+        { 12, 4, 8, 1, 2, 12, 7, 11, -1, -1, -1, -1, -1, -1, -1, -1 },
+        { 0, 1, 2, 12, 7, 11, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1 },
+        { 12, 4, 8, 12, 5, 9, 12, 6, 10, 3, -1, -1, -1, -1, -1, -1 },
+        { 0, 12, 5, 9, 12, 6, 10, 3, -1, -1, -1, -1, -1, -1, -1, -1 },
+        { 12, 4, 8, 1, 12, 6, 10, 3, -1, -1, -1, -1, -1, -1, -1, -1 },
+        { 0, 1, 12, 6, 10, 3, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1 },
+        { 12, 4, 8, 12, 5, 9, 2, 3, -1, -1, -1, -1, -1, -1, -1, -1 },
+        { 0, 12, 5, 9, 2, 3, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1 },
+        { 12, 4, 8, 1, 2, 3, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1 },
+        { 0, 1, 2, 3, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1 } };
+    __m128i const hex = _mm_setr_epi8(
+        '0', '1', '2', '3', '4', '5', '6', '7',
+        '8', '9', 'a', 'b', 'c', 'd', 'e', 'f');
+    __m128i const lo = _mm_set1_epi8(0x0f);
+    __m128i const h = _mm_shuffle_epi8(hex,
+        _mm_and_si128(_mm_srli_epi16(v, 4), lo));
+    __m128i const l = _mm_shuffle_epi8(hex,
+        _mm_and_si128(v, lo));
+    __m128i const p = _mm_set1_epi8('%');
+    __m128i const vh0 = _mm_unpacklo_epi32(v, h);
+    __m128i const vh1 = _mm_unpackhi_epi32(v, h);
+    __m128i const lp0 = _mm_unpacklo_epi32(l, p);
+    __m128i const lp1 = _mm_unpackhi_epi32(l, p);
+    __m128i const g[4] = {
+        _mm_unpacklo_epi64(vh0, lp0),
+        _mm_unpackhi_epi64(vh0, lp0),
+        _mm_unpacklo_epi64(vh1, lp1),
+        _mm_unpackhi_epi64(vh1, lp1) };
+    for(int i = 0; i < 4; ++i)
+    {
+        unsigned const k = m & 15;
+        _mm_storeu_si128(
+            reinterpret_cast<__m128i*>(dest),
+            _mm_shuffle_epi8(g[i], _mm_loadu_si128(
+                reinterpret_cast<
+                    __m128i const*>(shuf[k]))));
+        dest += 12 - 2 *
+            boost::core::popcount(k);
+        m >>= 4;
+    }
+    return dest;
+}
+
+BOOST_URL_TARGET_SSSE3
+static
+char*
+encode_pct_ssse3(
+    unsigned char const* tab,
+    bool plus,
+    char* dest,
+    char const* end,
+    char const*& first,
+    char const* last) noexcept
+{
+    __m128i const t0 = _mm_loadu_si128(
+        reinterpret_cast<
+            __m128i const*>(tab));
+    __m128i const t1 = _mm_loadu_si128(
+        reinterpret_cast<
+            __m128i const*>(tab + 16));
+    // the last store of expand_pct
+    // can end 52 chars past dest
+    while(
+        last - first >= 16 &&
+        end - dest >= 52)
+    {
+        __m128i v = _mm_loadu_si128(
+            reinterpret_cast<
+                __m128i const*>(first));
+        unsigned m = bnf::detail::lut_members(
+            v, t0, t1);
+        if(plus)
+            v = space_to_plus(v, m);
+        if(m == 0xffff)
+        {
+            _mm_storeu_si128(
+                reinterpret_cast<__m128i*>(dest), v);
+            dest += 16;
+        }
+        else
+        {
+            dest = expand_pct(dest, v, m);
+        }
+        first += 16;
+    }
+    return encode_pct_scalar(
+        tab, plus, dest, end, first, last);
+}
+
+#endif
+
+#if defined(BOOST_URL_USE_AVX2) || \
+    defined(BOOST_URL_USE_DISPATCH)
+
+BOOST_URL_TARGET_AVX2
+static
+inline
+__m256i
+space_to_plus(
+    __m256i v,
+    std::uint32_t& m) noexcept
+{
+    __m256i const sp = _mm256_cmpeq_epi8(
+        v, _mm256_set1_epi8(' '));
+    m |= static_cast<std::uint32_t>(
+        _mm256_movemask_epi8(sp));
+    return _mm256_or_si256(
+        _mm256_andnot_si256(sp, v),
+        _mm256_and_si256(sp,
+            _mm256_set1_epi8('+')));
+}
+
+BOOST_URL_TARGET_AVX2
+static
+std::size_t
+encoded_size_avx2(
+    unsigned char const* tab,
+    bool plus,
+    char const* first,
+    char const* last) noexcept
+{
+    __m256i const t0 =
+        _mm256_broadcastsi128_si256(
+            _mm_loadu_si128(
+                reinterpret_cast<
+                    __m128i const*>(tab)));
+    __m256i const t1 =
+        _mm256_broadcastsi128_si256(
+            _mm_loadu_si128(
+                reinterpret_cast<
+                    __m128i const*>(tab + 16)));
+    std::size_t n = 0;
+    while(last - first >= 32)
+    {
+        __m256i const v = _mm256_loadu_si256(
+            reinterpret_cast<
+                __m256i const*>(first));
+        std::uint32_t m =
+            bnf::detail::lut_members(v, t0, t1);
+        if(plus)
+            space_to_plus(v, m);
+        n += 32 + 2 * static_cast<
+            std::size_t>(boost::core::popcount(
+                static_cast<std::uint32_t>(~m)));
+        first += 32;
+    }
+    return n + encoded_size_ssse3(
+        tab, plus, first, last);
+}
+
+// Blocks of 32 members are copied at
+// once, the others are expanded in
+// halves by the SSSE3 kernel.
+BOOST_URL_TARGET_AVX2
+static
+char*
+encode_pct_avx2(
+    unsigned char const* tab,
+    bool plus,
+    char* dest,
+    char const* end,
+    char const*& first,
+    char const* last) noexcept
+{
+    __m256i const t0 =
+        _mm256_broadcastsi128_si256(
+            _mm_loadu_si128(
+                reinterpret_cast<
+                    __m128i const*>(tab)));
+    __m256i const t1 =
+        _mm256_broadcastsi128_si256(
+            _mm_loadu_si128(
+                reinterpret_cast<
+                    __m128i const*>(tab + 16)));
+    // the first half writes at most 48
+    // chars, the second ends 52 past that
+    while(
+        last - first >= 32 &&
+        end - dest >= 100)
+    {
+        __m256i v = _mm256_loadu_si256(
+            reinterpret_cast<
+                __m256i const*>(first));
+        std::uint32_t m =
+            bnf::detail::lut_members(v, t0, t1);
+        if(plus)
+            v = space_to_plus(v, m);
+        if(m == 0xffffffff)
+        {
+            _mm256_storeu_si256(
+                reinterpret_cast<__m256i*>(dest), v);
+            dest += 32;
+        }
+        else
+        {
+            dest = expand_pct(dest,
+                _mm256_castsi256_si128(v),
+                m & 0xffff);
+            dest = expand_pct(dest,
+                _mm256_extracti128_si256(v, 1),
+                m >> 16);
+        }
+        first += 32;
+    }
+    return encode_pct_ssse3(
+        tab, plus, dest, end, first, last);
+}
+
+#endif
+
+//------------------------------------------------
+
+#ifdef BOOST_URL_USE_DISPATCH
+
+static
+void
+cpuid(
+    unsigned leaf,
+    unsigned r[4]) noexcept
+{
+#ifdef _MSC_VER
+    int v[4];
+    __cpuidex(v, static_cast<
+        int>(leaf), 0);
+    for(int i = 0; i < 4; ++i)
+        r[i] = static_cast<
+            unsigned>(v[i]);
+#else
+    __cpuid_count(leaf, 0,
+        r[0], r[1], r[2], r[3]);
+#endif
+}
+
+// returns the register state
+// enabled by the operating system
+static
+std::uint64_t
+xgetbv() noexcept
+{
+#ifdef _MSC_VER
+    return _xgetbv(0);
+#else
+    std::uint32_t lo;
+    std::uint32_t hi;
+    __asm__ __volatile__(
+        "xgetbv" :
+        "=a"(lo), "=d"(hi) : "c"(0));
+    return (static_cast<
+        std::uint64_t>(hi) << 32) | lo;
+#endif
+}
+
+#endif
+
+static
+simd_level
+detect_simd_level() noexcept
+{
+#if defined(BOOST_URL_USE_AVX2)
+    return simd_level::avx2;
+#elif defined(BOOST_URL_USE_DISPATCH)
+    unsigned r[4];
+    cpuid(0, r);
+    unsigned const n = r[0];
+    if(n < 1)
+        return simd_level::sse2;
+    cpuid(1, r);
+    if(! (r[2] & (1u << 9)))
+        return simd_level::sse2;
+    // AVX2 also needs the operating
+    // system to save the YMM registers
+    if( n < 7 ||
+        ! (r[2] & (1u << 27)) ||
+        ! (r[2] & (1u << 28)) ||
+        (xgetbv() & 6) != 6)
+        return simd_level::ssse3;
+    cpuid(7, r);
+    if(! (r[1] & (1u << 5)))
+        return simd_level::ssse3;
+    return simd_level::avx2;
+#elif defined(BOOST_URL_USE_SSSE3)
+    return simd_level::ssse3;
+#elif defined(BOOST_URL_USE_SSE2)
+    return simd_level::sse2;
+#else
+    return simd_level::none;
+#endif
+}
+
+simd_kernels const&
+get_simd_kernels(
+    simd_level v) noexcept
+{
+    static simd_kernels const tab[] = {
+        { simd_level::none,
+            &bnf::detail::find_lut_scalar,
+            &find_pct_scalar,
+            &decode_pct_scalar,
+            &encoded_size_scalar,
+            &encode_pct_scalar },
+#ifdef BOOST_URL_USE_SSE2
+        // find_pct is the only SSE2 kernel,
+        // the others need PSHUFB
+        { simd_level::sse2,
+            &bnf::detail::find_lut_scalar,
+            &find_pct_sse2,
+            &decode_pct_scalar,
+            &encoded_size_scalar,
+            &encode_pct_scalar },
+#endif
+#if defined(BOOST_URL_USE_SSSE3) || \
+    defined(BOOST_URL_USE_DISPATCH)
+        { simd_level::ssse3,
+            &bnf::detail::find_lut_ssse3,
+            &find_pct_sse2,
+            &decode_pct_ssse3,
+            &encoded_size_ssse3,
+            &encode_pct_ssse3 },
+#endif
+#if defined(BOOST_URL_USE_AVX2) || \
+    defined(BOOST_URL_USE_DISPATCH)
+        { simd_level::avx2,
+            &bnf::detail::find_lut_avx2,
+            &find_pct_avx2,
+            &decode_pct_avx2,
+            &encoded_size_avx2,
+            &encode_pct_avx2 },
+#endif
+    };
+    static simd_level const best =
+        detect_simd_level();
+    if(v > best)
+        v = best;
+    auto i = sizeof(tab) / sizeof(tab[0]);
+    while(tab[--i].level > v)
+    {
+    }
+    return tab[i];
+}
+
+simd_kernels const&
+active_simd_kernels() noexcept
+{
+    static simd_kernels const& k =
+        get_simd_kernels(simd_level::avx2);
+    return k;
+}
+
+} // detail
+} // urls
+} // boost
+
+#endif
@@ -10,6 +10,7 @@
 #ifndef BOOST_URL_DETAIL_PATH_HPP
 #define BOOST_URL_DETAIL_PATH_HPP
 
+#include <boost/url/detail/config.hpp>
 #include <boost/url/string.hpp>
 
 namespace boost {
@@ -59,6 +60,7 @@ path_prefix(
 
 // returns the number of adjusted
 // segments based on the malleable prefix.
+BOOST_CXX14_CONSTEXPR
 inline
 std::size_t
 path_segments(
@@ -110,6 +112,22 @@ path_segments(
     return nseg;
 }
 
+// Remove the dot segments from the path
+// [p, p + n) in place, returning the new
+// size and setting nseg to the number of
+// segments. The prefix is chosen so that
+// the result is unambiguous in a URL with
+// or without a scheme and authority.
+// Unmatched ".." are kept (Errata 4547).
+BOOST_URL_DECL
+std::size_t
+remove_dot_segments(
+    char* p,
+    std::size_t n,
+    bool has_scheme,
+    bool has_authority,
+    std::size_t& nseg) noexcept;
+
 // Trim reserved characters from
 // the front of the path.
 inline
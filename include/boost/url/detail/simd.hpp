@@ -0,0 +1,92 @@
+//
+// Copyright (c) 2019 Vinnie Falco (vinnie.falco@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/CPPAlliance/url
+//
+
+#ifndef BOOST_URL_DETAIL_SIMD_HPP
+#define BOOST_URL_DETAIL_SIMD_HPP
+
+#include <boost/url/detail/config.hpp>
+#include <boost/url/simd_level.hpp>
+
+namespace boost {
+namespace urls {
+namespace detail {
+
+// The kernels for one instruction set.
+struct simd_kernels
+{
+    simd_level level;
+
+    // Return the first char in [first, last)
+    // whose membership in the nibble table
+    // `tab` of a lut_chars equals `want`.
+    char const* (*find_lut)(
+        unsigned char const* tab,
+        bool want,
+        char const* first,
+        char const* last);
+
+    // Return the first '%' in [first, last),
+    // or '+' as well if `plus` is true.
+    char const* (*find_pct)(
+        char const* first,
+        char const* last,
+        bool plus);
+
+    // Decode the valid escapes "%XX" at
+    // the start of [first, last) into dest,
+    // and return the number decoded. dest
+    // may point into the input.
+    std::size_t (*decode_pct)(
+        char* dest,
+        char const* first,
+        char const* last);
+
+    // Return the size of [first, last) when
+    // the chars which are not in the nibble
+    // table `tab` are escaped, and a space
+    // becomes '+' if `plus` is true.
+    std::size_t (*encoded_size)(
+        unsigned char const* tab,
+        bool plus,
+        char const* first,
+        char const* last);
+
+    // Escape the chars of [first, last) as
+    // above into [dest, end), until the end
+    // of the input or of the output. first
+    // is advanced past the chars written,
+    // and the new dest is returned.
+    char* (*encode_pct)(
+        unsigned char const* tab,
+        bool plus,
+        char* dest,
+        char const* end,
+        char const*& first,
+        char const* last);
+};
+
+// Return the kernels for the highest
+// instruction set not above `v` which
+// the processor supports.
+BOOST_URL_DECL
+simd_kernels const&
+get_simd_kernels(
+    simd_level v) noexcept;
+
+// Return the kernels chosen for the
+// processor, see active_simd_level.
+BOOST_URL_DECL
+simd_kernels const&
+active_simd_kernels() noexcept;
+
+} // detail
+} // urls
+} // boost
+
+#endif
@@ -0,0 +1,177 @@
+//
+// Copyright (c) 2019 Vinnie Falco (vinnie.falco@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/CPPAlliance/url
+//
+
+#ifndef BOOST_URL_IMPL_LAZY_URL_VIEW_IPP
+#define BOOST_URL_IMPL_LAZY_URL_VIEW_IPP
+
+#include <boost/url/lazy_url_view.hpp>
+#include <boost/url/bnf/charset.hpp>
+#include <boost/url/detail/path.hpp>
+#include <algorithm>
+
+namespace boost {
+namespace urls {
+
+lazy_url_view::
+lazy_url_view(
+    string_view s) noexcept
+    : cs_(s.data())
+{
+    static constexpr bnf::lut_chars scheme_chars(
+        "0123456789" "+-."
+        "ABCDEFGHIJKLMNOPQRSTUVWXYZ"
+        "abcdefghijklmnopqrstuvwxyz");
+    static constexpr bnf::lut_chars auth_end("/?#");
+    static constexpr bnf::lut_chars path_end("?#");
+
+    auto const start = s.data();
+    auto const end = start + s.size();
+    auto it = start;
+
+    // [ scheme ":" ]
+    if( it != end &&
+        bnf::alpha_chars(*it))
+    {
+        auto const p = bnf::find_if_not(
+            it + 1, end, scheme_chars);
+        if( p != end &&
+            *p == ':')
+            it = p + 1;
+    }
+    offset_[id_user] = it - start;
+
+    if( end - it >= 2 &&
+        it[0] == '/' &&
+        it[1] == '/')
+    {
+        // "//" authority, where '@' ends
+        // the userinfo and ':' starts the
+        // port, after any IP-literal
+        it += 2;
+        auto const last =
+            bnf::find_if(it, end, auth_end);
+        auto const at =
+            std::find(it, last, '@');
+        if(at != last)
+        {
+            offset_[id_pass] = std::find(
+                it, at, ':') - start;
+            it = at + 1;
+        }
+        else
+        {
+            offset_[id_pass] = it - start;
+        }
+        offset_[id_host] = it - start;
+        if( it != last &&
+            *it == '[')
+        {
+            it = std::find(it, last, ']');
+            if(it != last)
+                ++it;
+        }
+        offset_[id_port] = std::find(
+            it, last, ':') - start;
+        it = last;
+    }
+    else
+    {
+        offset_[id_pass] = it - start;
+        offset_[id_host] = it - start;
+        offset_[id_port] = it - start;
+    }
+    offset_[id_path] = it - start;
+
+    // path [ "?" query ] [ "#" fragment ]
+    it = bnf::find_if(it, end, path_end);
+    offset_[id_query] = it - start;
+    if( it != end &&
+        *it == '?')
+        it = std::find(it, end, '#');
+    offset_[id_frag] = it - start;
+    offset_[id_end] = s.size();
+}
+
+error_code
+lazy_url_view::
+validate() const noexcept
+{
+    auto const r = parse_uri_reference(
+        string());
+    if(r.has_error())
+        return r.error();
+    return {};
+}
+
+result<url_view>
+lazy_url_view::
+view() const noexcept
+{
+    return parse_uri_reference(
+        string());
+}
+
+urls::scheme
+lazy_url_view::
+scheme_id() const noexcept
+{
+    if(! has_scheme())
+        return urls::scheme::none;
+    return string_to_scheme(scheme());
+}
+
+std::uint16_t
+lazy_url_view::
+port_number() const noexcept
+{
+    // as port_bnf
+    auto const s = port();
+    std::uint16_t u = 0;
+    for(auto c : s)
+    {
+        if(! bnf::digit_chars(c))
+            return 0;
+        std::uint16_t const u0 = u;
+        u = static_cast<std::uint16_t>(
+            10 * u + (c - '0'));
+        if(u < u0)
+            return 0;
+    }
+    return u;
+}
+
+std::size_t
+lazy_url_view::
+segment_count() const noexcept
+{
+    auto const s = encoded_path();
+    if(s.empty())
+        return 0;
+    std::size_t n = std::count(
+        s.begin(), s.end(), '/');
+    if(s[0] != '/')
+        ++n;
+    return detail::path_segments(s, n);
+}
+
+std::size_t
+lazy_url_view::
+param_count() const noexcept
+{
+    if(! has_query())
+        return 0;
+    auto const s = encoded_query();
+    return 1 + std::count(
+        s.begin(), s.end(), '&');
+}
+
+} // urls
+} // boost
+
+#endif
@@ -0,0 +1,59 @@
+//
+// Copyright (c) 2019 Vinnie Falco (vinnie.falco@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/CPPAlliance/url
+//
+
+#ifndef BOOST_URL_IMPL_PARSE_STATS_IPP
+#define BOOST_URL_IMPL_PARSE_STATS_IPP
+
+#include <boost/url/parse_stats.hpp>
+#include <atomic>
+
+namespace boost {
+namespace urls {
+
+namespace detail {
+
+static std::atomic<std::uint64_t> fast_parses{0};
+static std::atomic<std::uint64_t> general_parses{0};
+
+void
+count_parse(bool fast) noexcept
+{
+    // only the totals matter, so
+    // nothing is ordered
+    (fast ? fast_parses : general_parses
+        ).fetch_add(1,
+            std::memory_order_relaxed);
+}
+
+} // detail
+
+parse_stats
+get_parse_stats() noexcept
+{
+    parse_stats st;
+    st.fast = detail::fast_parses.load(
+        std::memory_order_relaxed);
+    st.general = detail::general_parses.load(
+        std::memory_order_relaxed);
+    return st;
+}
+
+void
+reset_parse_stats() noexcept
+{
+    detail::fast_parses.store(0,
+        std::memory_order_relaxed);
+    detail::general_parses.store(0,
+        std::memory_order_relaxed);
+}
+
+} // urls
+} // boost
+
+#endif
@@ -13,8 +13,11 @@
 #include <boost/url/detail/except.hpp>
 #include <boost/url/bnf/charset.hpp>
 #include <boost/url/detail/except.hpp>
+#include <boost/url/detail/simd.hpp>
 #include <boost/assert.hpp>
 #include <boost/static_assert.hpp>
+#include <algorithm>
+#include <cstring>
 
 namespace boost {
 namespace urls {
@@ -33,11 +36,25 @@ validate_pct_encoding(
 
     // can't have % in charset
     BOOST_ASSERT(! cs('%'));
+    // Runs of unreserved chars are skipped
+    // with the charset's find_if_not, unless
+    // they could hide a null.
+    bool const skip =
+        opt.allow_null || ! cs('\0');
     std::size_t n = 0;
     auto it = s.data();
     auto const end = it + s.size();
     while(it != end)
     {
+        if(skip)
+        {
+            auto const p =
+                bnf::find_if_not(it, end, cs);
+            n += p - it;
+            it = p;
+            if(it == end)
+                break;
+        }
         if( opt.plus_to_space &&
             *it == '+')
         {
@@ -135,20 +152,176 @@ pct_decode(
     BOOST_STATIC_ASSERT(
         bnf::is_charset<CharSet>::value);
 
-    auto const n =
-        validate_pct_encoding(
-            s, ec, cs, opt);
-    if(ec.failed())
-        return 0;
-    auto const n1 =
-        pct_decode_unchecked(
-            dest, end, s, opt);
-    if(n1 < n)
+    // can't have % in charset
+    BOOST_ASSERT(! cs('%'));
+    // Validation, counting and output
+    // happen in the same pass. The output
+    // never gets ahead of the input, so
+    // dest may point into s.
+    bool const skip =
+        opt.allow_null || ! cs('\0');
+    bool const plus =
+        opt.plus_to_space && cs('+');
+    // decoded escapes need no
+    // checks with these options
+    bool const fast =
+        opt.allow_null &&
+        ! opt.non_normal_is_error;
+    auto const decode_pct =
+        detail::active_simd_kernels().decode_pct;
+    auto const dest0 = dest;
+    auto it = s.data();
+    auto const last = it + s.size();
+    while(it != last)
+    {
+        if(skip)
+        {
+            auto p =
+                bnf::find_if_not(it, last, cs);
+            bool const full =
+                p - it > end - dest;
+            if(full)
+                p = it + (end - dest);
+            if(p != it)
+            {
+                if(dest != it)
+                    std::memmove(
+                        dest, it, p - it);
+                if(plus)
+                {
+                    // plus in the charset
+                    // still becomes space
+                    auto q = dest;
+                    auto const e =
+                        dest + (p - it);
+                    while((q = static_cast<
+                        char*>(std::memchr(
+                            q, '+', e - q))))
+                        *q++ = ' ';
+                }
+                dest += p - it;
+                it = p;
+            }
+            if( full ||
+                it == last)
+                break;
+        }
+        if( fast &&
+            *it == '%' &&
+            last - it >= 9 &&
+            it[3] == '%' &&
+            it[6] == '%')
+        {
+            // run of escapes, limited by
+            // the space for output. Only
+            // valid escapes are decoded.
+            auto const n = (std::min)(
+                (last - it) / 3,
+                end - dest);
+            auto const n1 = decode_pct(
+                dest, it, it + 3 * n);
+            if(n1 > 0)
+            {
+                dest += n1;
+                it += 3 * n1;
+                continue;
+            }
+        }
+        // the input is consumed only
+        // once the output is written
+        char c;
+        std::size_t n = 1;
+        if( opt.plus_to_space &&
+            *it == '+')
+        {
+            // plus to space
+            c = ' ';
+        }
+        else if(
+            ! opt.allow_null &&
+            *it == '\0')
+        {
+            // null in input
+            ec = BOOST_URL_ERR(
+                error::illegal_null);
+            return 0;
+        }
+        else if(cs(*it))
+        {
+            // unreserved
+            c = *it;
+        }
+        else if(*it == '%')
+        {
+            // escaped
+            if(last - it < 3)
+            {
+                // missing HEXDIG
+                ec = BOOST_URL_ERR(
+                    error::missing_pct_hexdig);
+                return 0;
+            }
+            auto const d0 =
+                bnf::hexdig_value(it[1]);
+            auto const d1 =
+                bnf::hexdig_value(it[2]);
+            if( d0 == -1 ||
+                d1 == -1)
+            {
+                // expected HEXDIG
+                ec = BOOST_URL_ERR(
+                    error::bad_pct_hexdig);
+                return 0;
+            }
+            c = static_cast<char>(
+                ((static_cast<
+                    unsigned char>(d0) << 4) +
+                (static_cast<
+                    unsigned char>(d1))));
+            if( ! opt.allow_null &&
+                c == '\0')
+            {
+                // escaped null
+                ec = BOOST_URL_ERR(
+                    error::illegal_null);
+                return 0;
+            }
+            if( opt.non_normal_is_error &&
+                cs(c))
+            {
+                // escaped unreserved char
+                ec = BOOST_URL_ERR(
+                    error::non_canonical);
+                return 0;
+            }
+            n = 3;
+        }
+        else
+        {
+            // reserved character in input
+            ec = BOOST_URL_ERR(
+                error::illegal_reserved_char);
+            return 0;
+        }
+        if(dest == end)
+            break;
+        *dest++ = c;
+        it += n;
+    }
+    if(it == last)
     {
-        ec = error::no_space;
-        return n1;
+        ec = {};
+        return dest - dest0;
     }
-    return n1;
+    // dest too small, but
+    // invalid input comes first
+    validate_pct_encoding(
+        string_view(it, last - it),
+            ec, cs, opt);
+    if(ec.failed())
+        return 0;
+    ec = BOOST_URL_ERR(error::no_space);
+    return dest - dest0;
 }
 
 //------------------------------------------------
@@ -174,17 +347,17 @@ pct_decode(
             Allocator> r(a);
     if(s.empty())
         return r;
+    // the output is never
+    // longer than the input
+    r.resize(s.size());
     error_code ec;
-    auto const n =
-        validate_pct_encoding(
-            s, ec, cs, opt);
+    auto const n = pct_decode(
+        &r[0], &r[0] + r.size(),
+            s, ec, opt, cs);
     if(ec.failed())
         detail::throw_invalid_argument(
             BOOST_CURRENT_LOCATION);
     r.resize(n);
-    pct_decode_unchecked(
-        &r[0], &r[0] + r.size(),
-            s, opt);
     return r;
 }
 
@@ -206,17 +379,21 @@ pct_decode_to_value(
 
     if(s.empty())
         return string_value();
+    // the output is never
+    // longer than the input
+    char* dest;
+    string_value r(s.size(), a, dest);
     error_code ec;
-    auto const n =
-        validate_pct_encoding(
-            s, ec, cs, opt);
+    auto const n = pct_decode(
+        dest, dest + s.size(),
+            s, ec, opt, cs);
     if(ec.failed())
         detail::throw_invalid_argument(
             BOOST_CURRENT_LOCATION);
-    char* dest;
-    string_value r(n, a, dest);
-    pct_decode_unchecked(
-        dest, dest + n, s, opt);
+    // the allocation remembers its
+    // own size, so the view may shrink
+    static_cast<string_view&>(r) =
+        string_view(dest, n);
     return r;
 }
 
@@ -255,31 +432,40 @@ pct_encode_bytes(
     BOOST_STATIC_ASSERT(
         bnf::is_charset<CharSet>::value);
 
-    std::size_t n = 0;
-    auto it = s.data();
-    auto const end = it + s.size();
-    if(! opt.space_to_plus)
-    {
-        while(it != end)
-        {
-            if(cs(*it))
-                ++n;
-            else
-                n += 3;
-            ++it;
-        }
-        return n;
-    }
     // If you are converting space
     // to plus, then space should
     // be in the list of reserved
     // characters!
-    BOOST_ASSERT(! cs(' '));
+    BOOST_ASSERT(
+        ! opt.space_to_plus ||
+        ! cs(' '));
+    auto const tab =
+        bnf::detail::nibble_table(cs);
+    if( tab &&
+        s.size() >= 16)
+    {
+        // count the escapes
+        // a block at a time
+        return detail::active_simd_kernels()
+            .encoded_size(tab,
+                opt.space_to_plus,
+                s.data(),
+                s.data() + s.size());
+    }
+    std::size_t n = 0;
+    auto it = s.data();
+    auto const end = it + s.size();
     while(it != end)
     {
-        if(*it == ' ')
-            ++n;
-        else if(cs(*it))
+        // unreserved
+        auto const p =
+            bnf::find_if_not(it, end, cs);
+        n += p - it;
+        it = p;
+        if(it == end)
+            break;
+        if( opt.space_to_plus &&
+            *it == ' ')
             ++n;
         else
             n += 3;
@@ -306,49 +492,55 @@ pct_encode(
     // Can't have % in charset
     BOOST_ASSERT(! cs('%'));
 
+    // If you are converting space
+    // to plus, then space should
+    // be in the list of reserved
+    // characters!
+    BOOST_ASSERT(
+        ! opt.space_to_plus ||
+        ! cs(' '));
+
     static constexpr char hex[] =
         "0123456789abcdef";
     auto const dest0 = dest;
     auto p = s.data();
     auto const last = p + s.size();
-    auto const end3 = end - 3;
-    if(! opt.space_to_plus)
+    auto const tab =
+        bnf::detail::nibble_table(cs);
+    if( tab &&
+        s.size() >= 16)
     {
-        while(p != last)
-        {
-            if(cs(*p))
-            {
-                if(dest == end)
-                    return dest - dest0;
-                *dest++ = *p++;
-                continue;
-            }
-            if(dest > end3)
-                return dest - dest0;
-            *dest++ = '%';
-            auto const u = static_cast<
-                unsigned char>(*p);
-            *dest++ = hex[u>>4];
-            *dest++ = hex[u&0xf];
-            ++p;
-        }
+        // expand the escapes
+        // a block at a time
+        dest = detail::active_simd_kernels()
+            .encode_pct(tab,
+                opt.space_to_plus,
+                dest, end, p, last);
         return dest - dest0;
     }
-    // If you are converting space
-    // to plus, then space should
-    // be in the list of reserved
-    // characters!
-    BOOST_ASSERT(! cs(' '));
+    auto const end3 = end - 3;
     while(p != last)
     {
-        if(cs(*p))
+        // unreserved
+        auto const q = bnf::find_if_not(
+            p, last, cs);
+        if(q - p > end - dest)
         {
-            if(dest == end)
-                return dest - dest0;
-            *dest++ = *p++;
-            continue;
+            // dest too small
+            if(dest != end)
+                std::memcpy(dest, p, end - dest);
+            return end - dest0;
+        }
+        if(q != p)
+        {
+            std::memcpy(dest, p, q - p);
+            dest += q - p;
+            p = q;
         }
-        if(*p == ' ')
+        if(p == last)
+            break;
+        if( opt.space_to_plus &&
+            *p == ' ')
         {
             if(dest == end)
                 return dest - dest0;
@@ -12,6 +12,9 @@
 
 #include <boost/url/pct_encoding.hpp>
 #include <boost/url/bnf/charset.hpp>
+#include <boost/url/detail/simd.hpp>
+#include <algorithm>
+#include <cstring>
 #include <memory>
 
 namespace boost {
@@ -21,19 +24,19 @@ std::size_t
 pct_decode_bytes_unchecked(
     string_view s) noexcept
 {
+    auto const find_pct =
+        detail::active_simd_kernels().find_pct;
     auto it = s.data();
     auto const end =
         it + s.size();
     std::size_t n = 0;
     while(it < end)
     {
-        if(*it != '%')
-        {
-            // unescaped
-            ++it;
-            ++n;
-            continue;
-        }
+        // unescaped
+        auto const p =
+            find_pct(it, end, false);
+        n += p - it;
+        it = p;
         if(end - it < 3)
             return n;
         it += 3;
@@ -62,73 +65,68 @@ pct_decode_unchecked(
             (static_cast<
                 unsigned char>(d1))));
     };
+    auto const& k =
+        detail::active_simd_kernels();
     auto it = s.data();
     auto const last = it + s.size();
     auto dest = dest0;
-
-    if(opt.plus_to_space)
+    while(it != last)
     {
-        while(it != last)
+        // unescaped
+        auto p = k.find_pct(it, last,
+            opt.plus_to_space);
+        if(p - it > end - dest)
+            p = it + (end - dest);
+        if(p != it)
         {
-            if(dest == end)
-            {
-                // dest too small
-                return dest - dest0;
-            }
-            if(*it == '+')
-            {
-                // plus to space
-                *dest++ = ' ';
-                ++it;
-                continue;
-            }
-            if(*it == '%')
-            {
-                // escaped
-                ++it;
-                if(last - it < 2)
-                {
-                    // missing input,
-                    // initialize output
-                    std::memset(dest,
-                        0, end - dest);
-                    return dest - dest0;
-                }
-                *dest++ = decode_hex(it);
-                it += 2;
-                continue;
-            }
-            // unescaped
-            *dest++ = *it++;
+            std::memcpy(dest, it, p - it);
+            dest += p - it;
+            it = p;
         }
-        return dest - dest0;
-    }
-
-    while(it != last)
-    {
+        if(it == last)
+            break;
         if(dest == end)
         {
             // dest too small
             return dest - dest0;
         }
-        if(*it == '%')
+        if(*it == '+')
         {
-            // escaped
+            // plus to space
+            *dest++ = ' ';
             ++it;
-            if(last - it < 2)
+            continue;
+        }
+        if( last - it >= 9 &&
+            it[3] == '%' &&
+            it[6] == '%')
+        {
+            // run of escapes, limited
+            // by the space for output
+            auto const n = (std::min)(
+                (last - it) / 3,
+                end - dest);
+            auto const n1 = k.decode_pct(
+                dest, it, it + 3 * n);
+            if(n1 > 0)
             {
-                // missing input,
-                // initialize output
-                std::memset(dest,
-                    0, end - dest);
-                return dest - dest0;
+                dest += n1;
+                it += 3 * n1;
+                continue;
             }
-            *dest++ = decode_hex(it);
-            it += 2;
-            continue;
         }
-        // unescaped
-        *dest++ = *it++;
+        // escaped
+        ++it;
+        if(last - it < 2)
+        {
+            // missing input,
+            // initialize output
+            std::memset(dest,
+                0, end - dest);
+            return dest - dest0;
+        }
+        *dest++ = decode_hex(it);
+        it += 2;
     }
     return dest - dest0;
 }
@@ -0,0 +1,62 @@
+//
+// Copyright (c) 2019 Vinnie Falco (vinnie.falco@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/CPPAlliance/url
+//
+
+#ifndef BOOST_URL_IMPL_RESOLVER_HPP
+#define BOOST_URL_IMPL_RESOLVER_HPP
+
+namespace boost {
+namespace urls {
+
+template<class InputIt, class OutputIt>
+OutputIt
+resolver::
+resolve(
+    InputIt first,
+    InputIt last,
+    OutputIt dest) const
+{
+    for(;first != last; ++first)
+    {
+        url& u = *dest;
+        resolve(*first, u);
+        ++dest;
+    }
+    return dest;
+}
+
+template<
+    class InputIt,
+    class OutputIt>
+OutputIt
+resolver::
+resolve(
+    InputIt first,
+    InputIt last,
+    char*& dest,
+    char const* end,
+    OutputIt views,
+    error_code& ec) const
+{
+    ec = {};
+    for(;first != last; ++first)
+    {
+        auto const v = resolve(
+            *first, dest, end, ec);
+        if(ec.failed())
+            break;
+        *views = v;
+        ++views;
+    }
+    return views;
+}
+
+} // urls
+} // boost
+
+#endif
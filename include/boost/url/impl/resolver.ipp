@@ -0,0 +1,235 @@
+//
+// Copyright (c) 2019 Vinnie Falco (vinnie.falco@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/CPPAlliance/url
+//
+
+#ifndef BOOST_URL_IMPL_RESOLVER_IPP
+#define BOOST_URL_IMPL_RESOLVER_IPP
+
+#include <boost/url/resolver.hpp>
+#include <boost/url/pct_encoding.hpp>
+#include <boost/url/detail/except.hpp>
+#include <boost/url/detail/path.hpp>
+#include <cstring>
+
+namespace boost {
+namespace urls {
+
+resolver::
+resolver(
+    url_view const& base)
+    : base_(base)
+{
+    if(! base.has_scheme())
+        detail::throw_invalid_argument(
+            BOOST_CURRENT_LOCATION);
+
+    // 5.2.3. Merge Paths
+    auto const p = base.encoded_path();
+    if( base.has_authority() &&
+        p.empty())
+    {
+        dir_ = "/";
+    }
+    else
+    {
+        auto const n = p.find_last_of('/');
+        if(n != string_view::npos)
+            dir_ = p.substr(0, n + 1);
+    }
+}
+
+// Return the size of the result
+// before dot segments are removed
+std::size_t
+resolver::
+max_size(
+    url_view const& ref) const noexcept
+{
+    using id = detail::parts_base;
+    if(ref.has_scheme())
+        return ref.size();
+    if(ref.has_authority())
+        return base_.len(id::id_scheme) +
+            ref.size();
+    auto n = base_.len(
+        id::id_scheme, id::id_path);
+    if(ref.encoded_path().empty())
+    {
+        n += base_.len(id::id_path);
+        if(ref.has_query())
+            return n + ref.size();
+        return n + base_.len(id::id_query) +
+            ref.len(id::id_frag);
+    }
+    if(ref.encoded_path().starts_with('/'))
+        return n + ref.size();
+    return n + dir_.size() + ref.size();
+}
+
+// Write the result, which must fit,
+// and set everything in u but the
+// characters and the table.
+void
+resolver::
+write(
+    url_view const& ref,
+    url_view& u,
+    char* dest) const noexcept
+{
+    using id = detail::parts_base;
+
+    //
+    // 5.2.2. Transform References
+    // https://datatracker.ietf.org/doc/html/rfc3986#section-5.2.2
+    //
+    // Choose where each part comes from,
+    // the path is the concatenation of
+    // p0 and p1.
+    //
+
+    url_view const* scheme = &base_;
+    url_view const* auth = &base_;
+    url_view const* query = &ref;
+    string_view p0;
+    string_view p1 = ref.encoded_path();
+    if(ref.has_scheme())
+    {
+        scheme = &ref;
+        auth = &ref;
+    }
+    else if(ref.has_authority())
+    {
+        auth = &ref;
+    }
+    else if(p1.empty())
+    {
+        p1 = base_.encoded_path();
+        if(! ref.has_query())
+            query = &base_;
+    }
+    else if(! p1.starts_with('/'))
+    {
+        p0 = dir_;
+    }
+
+    // Write each part once, in order
+    auto const start = dest;
+
+    // scheme
+    auto const ns =
+        scheme->len(id::id_scheme);
+    std::memcpy(dest, scheme->cs_, ns);
+    dest += ns;
+    u.scheme_ = scheme->scheme_;
+
+    // authority
+    auto const na = auth->len(
+        id::id_user, id::id_path);
+    std::memcpy(dest, auth->cs_ +
+        auth->offset(id::id_user), na);
+    dest += na;
+    for(int i = id::id_user;
+        i < id::id_path; ++i)
+    {
+        u.offset_[i] = ns +
+            auth->offset(i) -
+            auth->offset(id::id_user);
+        u.decoded_[i] = auth->decoded_[i];
+    }
+    u.host_type_ = auth->host_type_;
+    u.port_number_ = auth->port_number_;
+    std::memcpy(u.ip_addr_,
+        auth->ip_addr_, sizeof(u.ip_addr_));
+
+    // path, with the dot
+    // segments removed
+    u.offset_[id::id_path] = ns + na;
+    if(! p0.empty())
+        std::memcpy(dest,
+            p0.data(), p0.size());
+    dest += p0.size();
+    if(! p1.empty())
+        std::memcpy(dest,
+            p1.data(), p1.size());
+    dest += p1.size();
+    auto const path = start + ns + na;
+    std::size_t nseg;
+    dest = path + detail::remove_dot_segments(
+        path, dest - path,
+        ns > 0, na > 0, nseg);
+    u.nseg_ = nseg;
+    u.decoded_[id::id_path] =
+        pct_decode_bytes_unchecked(string_view(
+            path, dest - path));
+
+    // query
+    u.offset_[id::id_query] = dest - start;
+    auto const nq =
+        query->len(id::id_query);
+    std::memcpy(dest, query->cs_ +
+        query->offset(id::id_query), nq);
+    dest += nq;
+    u.decoded_[id::id_query] =
+        query->decoded_[id::id_query];
+    u.nparam_ = query->nparam_;
+
+    // fragment
+    u.offset_[id::id_frag] = dest - start;
+    auto const nf = ref.len(id::id_frag);
+    std::memcpy(dest, ref.cs_ +
+        ref.offset(id::id_frag), nf);
+    dest += nf;
+    u.decoded_[id::id_frag] =
+        ref.decoded_[id::id_frag];
+    u.offset_[id::id_end] = dest - start;
+}
+
+void
+resolver::
+resolve(
+    url_view const& ref,
+    url& dest) const
+{
+    dest.ensure_space(
+        max_size(ref),
+        base_.nseg_ + ref.nseg_ + 1,
+        base_.nparam_ > ref.nparam_ ?
+            base_.nparam_ : ref.nparam_);
+    write(ref, dest.base(), dest.s_);
+    dest.cs_ = dest.s_;
+    dest.s_[dest.size()] = '\0';
+    dest.build_tab();
+    dest.check_invariants();
+}
+
+url_view
+resolver::
+resolve(
+    url_view const& ref,
+    char*& dest,
+    char const* end,
+    error_code& ec) const noexcept
+{
+    if(max_size(ref) > std::size_t(
+        end - dest))
+    {
+        ec = error::no_space;
+        return {};
+    }
+    ec = {};
+    url_view u;
+    write(ref, u, dest);
+    u.cs_ = dest;
+    dest += u.size();
+    return u;
+}
+
+} // urls
+} // boost
+
+#endif
@@ -0,0 +1,113 @@
+//
+// Copyright (c) 2019 Vinnie Falco (vinnie.falco@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/CPPAlliance/url
+//
+
+#ifndef BOOST_URL_IMPL_SHARED_URL_IPP
+#define BOOST_URL_IMPL_SHARED_URL_IPP
+
+#include <boost/url/shared_url.hpp>
+#include <boost/url/small_url.hpp>
+#include <boost/url/detail/except.hpp>
+#include <boost/url/detail/over_allocator.hpp>
+#include <boost/align/align_up.hpp>
+
+namespace boost {
+namespace urls {
+
+// the characters and the table
+// follow the object, in the same
+// allocation as the reference count
+struct shared_url::impl :
+    small_url_base
+{
+    virtual
+    ~impl()
+    {
+    }
+
+    impl(
+        std::size_t cap,
+        url_view const& u)
+        : small_url_base(reinterpret_cast<
+            char*>(this + 1), cap)
+    {
+        copy(u);
+    }
+};
+
+std::shared_ptr<url>
+shared_url::
+make(url_view const& u)
+{
+    using T = impl;
+    using Alloc = std::allocator<char>;
+    auto const cap = alignment::align_up(
+        url::capacity_for(
+            u.size(),
+            u.encoded_segments().size(),
+            u.encoded_params().size()),
+        alignof(pos_t));
+    Alloc a;
+    return std::allocate_shared<T>(
+        detail::over_allocator<T, Alloc>(
+            cap, a), cap, u);
+}
+
+shared_url::
+shared_url(url_view const& u)
+    : p_(make(u))
+{
+}
+
+shared_url::
+shared_url(string_view s)
+{
+    auto r = parse_uri_reference(s);
+    if(r.has_error())
+        detail::throw_invalid_argument(
+            BOOST_CURRENT_LOCATION);
+    p_ = make(r.value());
+}
+
+shared_url&
+shared_url::
+operator=(url_view const& u)
+{
+    // u may refer to our buffer
+    p_ = make(u);
+    return *this;
+}
+
+url_view const&
+shared_url::
+view() const noexcept
+{
+    static url_view const empty;
+    if(p_)
+        return *p_;
+    return empty;
+}
+
+url&
+shared_url::
+edit()
+{
+    // use_count cannot rise to 2 while
+    // it is 1, since no other object
+    // refers to the buffer
+    if(! p_)
+        p_ = make(url_view());
+    else if(p_.use_count() > 1)
+        p_ = make(*p_);
+    return *p_;
+}
+
+} // urls
+} // boost
+
+#endif
@@ -0,0 +1,43 @@
+//
+// Copyright (c) 2019 Vinnie Falco (vinnie.falco@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/CPPAlliance/url
+//
+
+#ifndef BOOST_URL_IMPL_SIMD_LEVEL_IPP
+#define BOOST_URL_IMPL_SIMD_LEVEL_IPP
+
+#include <boost/url/simd_level.hpp>
+#include <boost/url/detail/simd.hpp>
+
+namespace boost {
+namespace urls {
+
+simd_level
+active_simd_level() noexcept
+{
+    return detail::active_simd_kernels().level;
+}
+
+string_view
+to_string(simd_level v) noexcept
+{
+    switch(v)
+    {
+    case simd_level::none:  return "none";
+    case simd_level::sse2:  return "sse2";
+    case simd_level::ssse3: return "ssse3";
+    case simd_level::avx2:  return "avx2";
+    default:
+        break;
+    }
+    return "<unknown>";
+}
+
+} // urls
+} // boost
+
+#endif
@@ -0,0 +1,102 @@
+//
+// Copyright (c) 2019 Vinnie Falco (vinnie.falco@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/CPPAlliance/url
+//
+
+#ifndef BOOST_URL_IMPL_SMALL_URL_IPP
+#define BOOST_URL_IMPL_SMALL_URL_IPP
+
+#include <boost/url/small_url.hpp>
+#include <boost/url/url_view.hpp>
+#include <boost/url/detail/except.hpp>
+#include <boost/assert.hpp>
+#include <cstring>
+
+namespace boost {
+namespace urls {
+
+small_url_base::
+~small_url_base()
+{
+    // prevent url from
+    // deallocating memory
+    if(s_ == buf_)
+        s_ = nullptr;
+}
+
+small_url_base::
+small_url_base(
+    char* buf,
+    std::size_t cap) noexcept
+    : url(buf, cap)
+    , buf_(buf)
+    , buf_cap_(cap)
+{
+}
+
+void
+small_url_base::
+construct(string_view s)
+{
+    auto r = parse_uri_reference(s);
+    if(r.has_error())
+        detail::throw_invalid_argument(
+            BOOST_CURRENT_LOCATION);
+    this->url::operator=(r.value());
+}
+
+/*  Both objects have inline buffers of
+    the same size, and dynamic storage is
+    always larger than the inline buffer,
+    so inline contents are copied without
+    going through ensure_space.
+*/
+void
+small_url_base::
+move(small_url_base& u) noexcept
+{
+    if(this == &u)
+        return;
+    if(u.s_ != u.buf_)
+    {
+        // take the dynamic storage
+        if(s_ != buf_)
+            url::deallocate(s_);
+        base() = u;
+        s_ = u.s_;
+        cap_ = u.cap_;
+        cs_ = s_;
+        u.base() = {};
+        u.s_ = u.buf_;
+        u.cap_ = u.buf_cap_;
+        u.s_[0] = '\0';
+        u.cs_ = u.s_;
+        return;
+    }
+    BOOST_ASSERT(cap_ >= u.cap_);
+    auto const tb = u.table_bytes();
+    std::memcpy(s_ + cap_ - tb,
+        u.s_ + u.cap_ - tb, tb);
+    std::memcpy(s_, u.s_,
+        u.size() + 1);
+    base() = u;
+    cs_ = s_;
+    u.clear();
+}
+
+void
+small_url_base::
+deallocate(char* s)
+{
+    if(s != buf_)
+        url::deallocate(s);
+}
+
+} // urls
+} // boost
+
+#endif
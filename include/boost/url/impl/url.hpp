@@ -13,6 +13,55 @@
 namespace boost {
 namespace urls {
 
+/*  The table
+
+    The positions of the separators in the
+    path and the query are kept at the end
+    of the buffer, in an array which grows
+    downward from tab_end(). The entries for
+    the path and the query are interleaved,
+    so each table may grow or shrink without
+    moving the other:
+
+        [ ... | p(2) | s(2) | p(1) | s(1) ] end
+
+    s(i) is the offset of the '/' before
+    segment i from the start of the path,
+    for 0 < i < nseg_. p(i) is the offset of
+    the '&' before param i from the start of
+    the query, for 0 < i < nparam_. Since the
+    entries are relative, resizing other
+    parts of the URL leaves them unchanged.
+*/
+
+pos_t*
+url::
+tab_end() const noexcept
+{
+    return reinterpret_cast<
+        pos_t*>(s_ + cap_);
+}
+
+pos_t&
+url::
+seg_tab(
+    std::size_t i) const noexcept
+{
+    BOOST_ASSERT(i > 0);
+    return *(tab_end() - (2 * i - 1));
+}
+
+pos_t&
+url::
+param_tab(
+    std::size_t i) const noexcept
+{
+    BOOST_ASSERT(i > 0);
+    return *(tab_end() - 2 * i);
+}
+
+//------------------------------------------------
+
 template<class Allocator>
 urls::segments
 url::
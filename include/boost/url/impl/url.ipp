@@ -12,12 +12,15 @@
 
 #include <boost/url/url.hpp>
 #include <boost/url/error.hpp>
+#include <boost/url/resolver.hpp>
 #include <boost/url/scheme.hpp>
 #include <boost/url/url_view.hpp>
 #include <boost/url/bnf/parse.hpp>
 #include <boost/url/detail/except.hpp>
+#include <boost/url/detail/path.hpp>
 #include <boost/url/detail/pct_encoding.hpp>
 #include <boost/url/detail/print.hpp>
+#include <boost/url/detail/simd.hpp>
 #include <boost/url/rfc/authority_bnf.hpp>
 #include <boost/url/rfc/charsets.hpp>
 #include <boost/url/rfc/fragment_bnf.hpp>
@@ -36,6 +39,38 @@
 namespace boost {
 namespace urls {
 
+namespace detail {
+
+// return the default port
+// of a scheme, or zero
+inline
+std::uint16_t
+default_port(
+    urls::scheme s) noexcept
+{
+    switch(s)
+    {
+    case urls::scheme::ftp:   return 21;
+    case urls::scheme::http:  return 80;
+    case urls::scheme::https: return 443;
+    case urls::scheme::ws:    return 80;
+    case urls::scheme::wss:   return 443;
+    default:
+        break;
+    }
+    return 0;
+}
+
+inline
+char
+ascii_toupper(char c) noexcept
+{
+    return (c >= 'a' && c <= 'z')
+        ? c - ('a' - 'A') : c;
+}
+
+} // detail
+
 // construct from static storage
 url::
 url(char* buf,
@@ -70,6 +105,7 @@ copy(url_view const& u)
     std::memcpy(s_,
         u.data(), u.size());
     s_[size()] = '\0';
+    build_tab();
 }
 
 // allocate n aligned up
@@ -173,13 +209,7 @@ reserve_bytes(
 {
     if(bytes <= capacity_in_bytes())
         return;
-    std::size_t n = 0;
-    if(nseg_ > 1)
-        n += sizeof(pos_t) *
-            (nseg_ - 1);
-    if(nparam_ > 0)
-        n += 2 * sizeof(pos_t) *
-            nparam_;
+    auto const n = table_bytes();
     BOOST_ASSERT(n <= bytes);
     bytes -= n;
     if(bytes > 0)
@@ -241,6 +271,11 @@ set_scheme_impl(
             return false;
         if(src[1] != '/')
             return false;
+        // keep "./" if it also protects
+        // an empty first segment
+        if( len(id_path) > 2 &&
+            src[2] == '/')
+            return false;
         return true;
     }();
 
@@ -262,6 +297,7 @@ set_scheme_impl(
             id_path,
             len(id_path) - 2);
         s_[size()] = '\0';
+        shift_segments(0 - 2);
     }
 
     auto dest = resize_impl(
@@ -325,7 +361,6 @@ remove_scheme() noexcept
         s_ + p - (n - 2),
         s_ + p,
         offset(id_end) - p);
-    // VFALCO adjust table
     // adjust part offsets.
     // (p is invalidated)
     adjust(id_user, id_path, 0-n);
@@ -333,6 +368,7 @@ remove_scheme() noexcept
     auto dest = s_ + offset(id_path);
     dest[0] = '.';
     dest[1] = '/';
+    shift_segments(2);
     s_[size()] = '\0';
     scheme_ = urls::scheme::none;
     check_invariants();
@@ -895,6 +931,7 @@ remove_authority() noexcept
         split(id_pass, 0);
         split(id_host, 0);
         split(id_port, 0);
+        shift_segments(2);
     }
     else
     {
@@ -931,7 +968,7 @@ set_encoded_authority(string_view s)
     if(need_slash)
     {
         dest[n - 1] = '/';
-        // VFALCO adjust table
+        shift_segments(1);
     }
     if(t.has_userinfo)
     {
@@ -1053,6 +1090,7 @@ remove_origin() noexcept
         split(id_pass, 0);
         split(id_host, 0);
         split(id_port, 0);
+        shift_segments(1);
         return *this;
     }
     if( s.empty() ||
@@ -1089,6 +1127,7 @@ remove_origin() noexcept
     split(id_pass, 0);
     split(id_host, 0);
     split(id_port, 0);
+    shift_segments(2);
     return *this;
 }
 
@@ -1110,23 +1149,7 @@ segment(
     if(i == nseg_)
         return offset(id_query);
     BOOST_ASSERT(i < nseg_);
-    auto it = s_ + offset(id_path) +
-        detail::path_prefix(
-            get(id_path));
-    BOOST_ASSERT(it < s_ +
-        offset(id_query));
-    for(;;)
-    {
-        while(*it != '/')
-            ++it;
-        BOOST_ASSERT(it < s_ +
-            offset(id_query));
-        --i;
-        if(i == 0)
-            break;
-        ++it;
-    }
-    return it - s_;
+    return offset(id_path) + seg_tab(i);
 }
 
 /*  Remove segments [first, last) and make
@@ -1183,14 +1206,46 @@ edit_segments(
         nseg1,
         nparam_);
 
+    // Table entries before p0 are kept,
+    // entries from p1 on are shifted and
+    // renumbered. The caller fills in the
+    // entries for the new segments.
+    std::size_t k = i1 > 0 ? i1 : 1;
+    if( k < nseg_ &&
+        offset(id_path) + seg_tab(k) < p1)
+        ++k;
+    auto const move_tab =
+        [this, k, nseg1, n, n0]
+    {
+        if(k >= nseg_)
+            return;
+        auto const nt = nseg_ - k;
+        auto const k1 = nseg1 - nt;
+        if(k1 > k)
+            for(auto i = nt; i-- > 0;)
+                seg_tab(k1 + i) =
+                    seg_tab(k + i) + n - n0;
+        else
+            for(std::size_t i = 0; i < nt; ++i)
+                seg_tab(k1 + i) =
+                    seg_tab(k + i) + n - n0;
+    };
+
     // start of output
     auto dest = s_ + p0;
 
-    // move and size
+    // move and size. When the chars
+    // shrink, the table may grow into
+    // their old space, otherwise the
+    // chars may grow into the table's.
+    if(n >= n0)
+        move_tab();
     std::memmove(
         dest + n,
         s_ + p1,
         size() - p1);
+    if(n < n0)
+        move_tab();
     set_size(
         id_path,
         len(id_path) -
@@ -1260,6 +1315,26 @@ edit_segments(
         2 = "./"
         3 = "/./"
 */
+    // The segment which will be first,
+    // and the new number of segments,
+    // which determine the prefix.
+    std::size_t const nseg1 =
+        nseg_ + nseg - (i1 - i0);
+    string_view front = it0.front;
+    if( i0 == 0 &&
+        nseg == 0 &&
+        i1 < nseg_)
+    {
+        auto const p = i1 > 0 ?
+            segment(i1) + 1 :
+            offset(id_path) +
+                detail::path_prefix(
+                    get(id_path));
+        front = string_view(
+            s_ + p, segment(i1 + 1) - p);
+    }
+    bool const root =
+        abs || has_authority();
     int prefix;
     if(i0 > 0)
     {
@@ -1268,57 +1343,36 @@ edit_segments(
         else
             prefix = 0;
     }
+    else if(nseg1 == 0)
+    {
+        prefix = abs ? 1 : 0;
+    }
     else if(
-        it0.front == "." &&
-        nseg > 1)
+        front == "." &&
+        nseg1 > 1)
     {
-        if( abs ||
-            has_authority())
-            prefix = 3;
-        else
-            prefix = 2;
+        prefix = root ? 3 : 2;
     }
-    else if(has_authority())
+    else if(front.empty())
     {
-        if(nseg == 0)
-            prefix = abs ? 1 : 0;
-        else if(! it0.front.empty())
-            prefix = 1;
-        else
-            prefix = 3;
+        // a leading "//" would
+        // begin an authority
+        prefix = root ? 3 : 2;
     }
-    else if(
-        nseg > 1 &&
-        it0.front.empty())
+    else if(root)
     {
-        prefix = 3;
+        prefix = 1;
     }
     else if(
-        ! abs &&
         ! has_scheme() &&
-        (
-            it0.front.find_first_of(
-                ':') != string_view::npos ||
-            it0.front.empty()))
+        front.find_first_of(
+            ':') != string_view::npos)
     {
-        BOOST_ASSERT(nseg > 0);
         prefix = 2;
     }
-    else if(
-        abs &&
-        nseg > 0 &&
-        it0.front.empty())
-    {
-        BOOST_ASSERT(
-            ! has_authority());
-        prefix = 3;
-    }
     else
     {
-        if(abs)
-            prefix = 1;
-        else
-            prefix = 0;
+        prefix = 0;
     }
 
 /*  Calculate suffix
@@ -1326,11 +1380,12 @@ edit_segments(
         1 = "/"
 */
     int suffix;
-    //if( nseg > 0 &&
-        //i1 + 1 < nseg_)
+    // Only needed when inserting before
+    // the first segment, otherwise the
+    // slash before segment i1 is kept.
     if( nseg > 0 &&
-        i0 == 0 &&
-        i1 + 1 < nseg_)
+        i1 == 0 &&
+        nseg_ > 0)
     {
         suffix = 1;
     }
@@ -1343,6 +1398,7 @@ edit_segments(
     n += prefix + suffix;
     auto dest = edit_segments(
         i0, i1, n, nseg);
+    auto const dest0 = dest;
     auto const last = dest + n;
 
 /*  Write all characters in the destination:
@@ -1385,6 +1441,23 @@ edit_segments(
     }
     if(suffix == 1)
         *dest++ = '/';
+
+    // add the new separators to the table
+    auto const p = s_ + offset(id_path);
+    auto it = dest0;
+    if(i0 == 0)
+    {
+        auto const q = p +
+            detail::path_prefix(
+                get(id_path));
+        if(it < q)
+            it = q;
+    }
+    std::size_t j = i0 > 0 ? i0 : 1;
+    for(; it < last; ++it)
+        if(*it == '/')
+            seg_tab(j++) = it - p;
+    check_invariants();
 }
 
 //------------------------------------------------
@@ -1400,7 +1473,6 @@ set_path_absolute(bool absolute)
         auto dest = resize_impl(
             id_path, 1);
         *dest = '/';
-        // VFALCO Update table
         return true;
     }
 
@@ -1414,7 +1486,7 @@ set_path_absolute(bool absolute)
         auto n = len(id_port);
         split(id_port, n + 1);
         resize_impl(id_port, n);
-        // VFALCO Update table
+        shift_segments(0 - 1);
         return true;
     }
 
@@ -1425,7 +1497,7 @@ set_path_absolute(bool absolute)
         id_port, n + 1) + n;
     split(id_port, n);
     *dest = '/';
-    // VFALCO Update table
+    shift_segments(1);
     return true;
 }
 
@@ -1501,33 +1573,14 @@ param(
         return { offset(id_query), 0, 0 };
     if(i == nparam_)
         return { offset(id_frag), 0, 0 };
-    BOOST_ASSERT(i <= nparam_);
-    auto n = len(id_query);
-    if(nparam_ < 2)
-        return make_param(
-            offset(id_query), n);
-    auto it = s_ + offset(id_query);
-    auto start = it;
-    auto const last =
-        s_ + offset(id_frag);
-    BOOST_ASSERT(n > 0);
-    for(;;)
-    {
-        for(;;)
-        {
-            ++it;
-            if(it == last)
-                break;
-            if(*it == '&')
-                break;
-        }
-        if(i == 0)
-            break;
-        start = it;
-        --i;
-    }
-    return make_param(
-        start - s_, it - start);
+    BOOST_ASSERT(i < nparam_);
+    auto const p = offset(id_query);
+    auto const pos = i == 0 ?
+        p : p + param_tab(i);
+    auto const end = i + 1 == nparam_ ?
+        offset(id_frag) :
+        p + param_tab(i + 1);
+    return make_param(pos, end - pos);
 }
 
 char*
@@ -1558,14 +1611,53 @@ edit_params(
         nseg_,
         nparam1);
 
+    // Table entries before r0 are kept,
+    // entries from r1 on are shifted and
+    // renumbered. The caller fills in the
+    // entries for the new params.
+    std::size_t k = i1 > 0 ? i1 : 1;
+    if( k < nparam_ &&
+        offset(id_query) +
+            param_tab(k) < r1.pos)
+        ++k;
+    auto const move_tab =
+        [this, k, nparam1, n, n0]
+    {
+        if(k >= nparam_)
+            return;
+        auto k0 = k;
+        auto nt = nparam_ - k0;
+        auto k1 = nparam1 - nt;
+        if(k1 == 0)
+        {
+            // param i1 becomes the
+            // first, which has no entry
+            ++k0;
+            ++k1;
+            --nt;
+        }
+        if(k1 > k0)
+            for(auto i = nt; i-- > 0;)
+                param_tab(k1 + i) =
+                    param_tab(k0 + i) + n - n0;
+        else
+            for(std::size_t i = 0; i < nt; ++i)
+                param_tab(k1 + i) =
+                    param_tab(k0 + i) + n - n0;
+    };
+
     // start of output
     auto dest = s_ + r0.pos;
 
-    // move and size
+    // move and size, see edit_segments
+    if(n >= n0)
+        move_tab();
     std::memmove(
         dest + n,
         s_ + r1.pos,
         size() - r1.pos);
+    if(n < n0)
+        move_tab();
     set_size(
         id_query,
         len(id_query) + (
@@ -1622,6 +1714,14 @@ edit_params(
             ++n;
         }
     }
+    else if(
+        i0 == 0 &&
+        i1 < nparam_)
+    {
+        // the first remaining param
+        // takes over the '?' below
+        prefix = false;
+    }
     else if(
         i0 == 0 &&
         set_hint)
@@ -1634,9 +1734,20 @@ edit_params(
         prefix = false;
     }
 
+    // params after the range
+    bool const tail = i1 < nparam_;
+
     // copy
     auto dest = edit_params(
         i0, i1, n, nparam);
+    auto const dest0 = dest;
+    if( i0 == 0 && tail)
+    {
+        // the separator of the first
+        // remaining param changes
+        dest[n] = nparam > 0 ?
+            '&' : '?';
+    }
     if(prefix)
         *dest++ = '?';
     if(nparam > 0)
@@ -1653,6 +1764,18 @@ edit_params(
         }
     }
 
+    // add the new separators to the
+    // table, including the one after
+    // the range when it was changed
+    auto const p = s_ + offset(id_query);
+    std::size_t j = i0 > 0 ? i0 : 1;
+    auto const end = dest0 + n + (
+        i0 == 0 && tail);
+    for(auto it = dest0;
+        it < end; ++it)
+        if(*it == '&')
+            param_tab(j++) = it - p;
+
     check_invariants();
 }
 
@@ -1779,209 +1902,13 @@ resolve(
     url_view const& ref,
     error_code& ec)
 {
-    auto const remove_dot_segments =
-        [this]
-    {
-        auto segs = encoded_segments();
-        if(segs.empty())
-            return;
-        auto it = segs.begin();
-        int n = 0;
-        for(;;)
-        {
-            if(*it == ".")
-            {
-                if(it != segs.end() - 1)
-                    it = segs.erase(it);
-                else
-                    segs.replace(it, "");
-            }
-            else if(it == segs.begin())
-            {
-            #if 0
-                if(*it == "..")
-                    it = segs.erase(it);
-                else
-                    ++it;
-            #else
-            /*  Errata 4547
-                https://www.rfc-editor.org/errata/eid4547
-            */
-                if(*it != "..")
-                    ++n;
-                ++it;
-            #endif
-            }
-            else if(*it == "..")
-            {
-                if(n > 0)
-                {
-                    it = segs.erase(it - 1);
-                    if( it == segs.begin() ||
-                        it != segs.end() - 1)
-                        it = segs.erase(it);
-                    else
-                        segs.replace(it, "");
-                    --n;
-                }
-                else
-                {
-                    ++it;
-                }
-            }
-            else
-            {
-                ++n;
-                ++it;
-            }
-            if(it == segs.end())
-                break;
-        }
-    };
-
     if(! base.has_scheme())
     {
         ec = error::not_a_base;
         return false;
     }
-
     ec = {};
-
-    //
-    // 5.2.2. Transform References
-    // https://datatracker.ietf.org/doc/html/rfc3986#section-5.2.2
-    //
-
-    if(ref.has_scheme())
-    {
-        ensure_space(
-            ref.size(),
-            ref.nseg_,
-            ref.nparam_);
-        copy(ref);
-        remove_dot_segments();
-        return true;
-    }
-    if(ref.has_authority())
-    {
-        ensure_space(
-            base.offset(id_user) +
-                ref.size(),
-            ref.nseg_,
-            ref.nparam_);
-        clear();
-        set_scheme(base.scheme());
-        set_encoded_authority(
-            ref.encoded_authority());
-        set_encoded_path(
-            ref.encoded_path());
-        remove_dot_segments();
-        if(ref.has_query())
-            set_encoded_query(
-                ref.encoded_query());
-        if(ref.has_fragment())
-            set_encoded_fragment(
-                ref.encoded_fragment());
-        return true;
-    }
-    if(ref.encoded_path().empty())
-    {
-        if(ref.has_query())
-        {
-            ensure_space(
-                base.offset(id_query) +
-                    ref.size(),
-                base.nseg_,
-                ref.nparam_);
-            clear();
-            set_scheme(base.scheme());
-            if(base.has_authority())
-                set_encoded_authority(
-                    base.encoded_authority());
-            set_encoded_path(
-                base.encoded_path());
-            remove_dot_segments();
-            set_encoded_query(
-                ref.encoded_query());
-        }
-        else
-        {
-            ensure_space(
-                base.offset(id_query) +
-                    ref.size(),
-                base.nseg_,
-                base.nparam_);
-            clear();
-            set_scheme(base.scheme());
-            if(base.has_authority())
-                set_encoded_authority(
-                    base.encoded_authority());
-            set_encoded_path(
-                base.encoded_path());
-            remove_dot_segments();
-            if(base.has_query())
-                set_encoded_query(
-                    base.encoded_query());
-        }
-        if(ref.has_fragment())
-            set_encoded_fragment(
-                ref.encoded_fragment());
-        return true;
-    }
-    if(ref.encoded_path().starts_with('/'))
-    {
-        ensure_space(
-            base.offset(id_path) +
-                ref.size(),
-            ref.nseg_,
-            ref.nparam_);
-        clear();
-        set_scheme(base.scheme());
-        if(base.has_authority())
-            set_encoded_authority(
-                base.encoded_authority());
-        set_encoded_path(
-            ref.encoded_path());
-        remove_dot_segments();
-        if(ref.has_query())
-            set_encoded_query(
-                ref.encoded_query());
-        if(ref.has_fragment())
-            set_encoded_fragment(
-                ref.encoded_fragment());
-        return true;
-    }
-    ensure_space(
-        base.offset(id_query) +
-            ref.size(),
-        base.nseg_ + ref.nseg_,
-        ref.nparam_);
-    clear();
-    set_scheme(base.scheme());
-    if(base.has_authority())
-        set_encoded_authority(
-            base.encoded_authority());
-    {
-        // 5.2.3. Merge Paths
-        auto es = encoded_segments();
-        if(base.nseg_ > 0)
-        {
-            set_encoded_path(
-                base.encoded_path());
-            if(nseg_ > 0)
-                es.pop_back();
-        }
-        es.insert(es.end(),
-            ref.encoded_segments().begin(),
-            ref.encoded_segments().end());
-    }
-    remove_dot_segments();
-    if(ref.has_query())
-        set_encoded_query(
-            ref.encoded_query());
-    if(ref.has_fragment())
-        set_encoded_fragment(
-            ref.encoded_fragment());
+    resolver(base).resolve(ref, *this);
     return true;
 }
 
@@ -1993,24 +1920,117 @@ resolve(
 
 url&
 url::
-normalize()
+normalize() noexcept
 {
-#if 0
+    check_invariants();
+    // nothing to do, and
+    // maybe no buffer
+    if(size() == 0)
+        return *this;
+
     // scheme
-    {
-        char* it = s_
-            + offset(id_scheme);
-        auto last = it + offset(id_user);
-        if(it < last)
+    for(auto it = s_, last = s_ +
+        offset(id_user); it != last; ++it)
+        *it = bnf::ascii_tolower(*it);
+
+    // an empty or default port
+    bool const drop_port =
+        len(id_port) == 1 || (
+        has_port() &&
+        port_number_ != 0 &&
+        port_number_ ==
+            detail::default_port(scheme_));
+
+    // Percent-encodings and host case, in
+    // one pass. Decoding only ever shrinks
+    // the string, so the output is written
+    // behind the input in the same buffer.
+    auto const& k =
+        detail::active_simd_kernels();
+    char* dest = s_ + offset(id_user);
+    for(int id = id_user; id < id_end; ++id)
+    {
+        char const* it = s_ + offset(id);
+        char const* const last =
+            s_ + offset(id + 1);
+        offset_[id] = static_cast<
+            pos_t>(dest - s_);
+        if( id == id_port &&
+            drop_port)
+            continue;
+        bool const lower =
+            id == id_host && (
+            host_type_ == urls::host_type::name ||
+            host_type_ == urls::host_type::ipv6);
+        while(it != last)
         {
-            --last;
-            while(it != last)
+            if(! lower)
             {
-                // to upper
+                // copy the run up to
+                // the next escape
+                auto const p =
+                    k.find_pct(it, last, false);
+                if(dest != it)
+                    std::memmove(
+                        dest, it, p - it);
+                dest += p - it;
+                it = p;
+                if(it == last)
+                    break;
             }
+            else if(*it != '%')
+            {
+                *dest++ = bnf::ascii_tolower(*it++);
+                continue;
+            }
+            BOOST_ASSERT(last - it >= 3);
+            char const c = static_cast<char>(
+                (bnf::hexdig_value(it[1]) << 4) +
+                    bnf::hexdig_value(it[2]));
+            if(unreserved_chars(c))
+            {
+                *dest++ = lower ?
+                    bnf::ascii_tolower(c) : c;
+            }
+            else
+            {
+                dest[0] = '%';
+                dest[1] = detail::ascii_toupper(it[1]);
+                dest[2] = detail::ascii_toupper(it[2]);
+                dest += 3;
+            }
+            it += 3;
         }
     }
-#endif
+    offset_[id_end] = static_cast<
+        pos_t>(dest - s_);
+    *dest = '\0';
+    if(drop_port)
+        port_number_ = 0;
+
+    // decoding may have made
+    // the name an IPv4 address
+    if(host_type_ ==
+        urls::host_type::name)
+    {
+        auto r = parse_ipv4_address(
+            get(id_host));
+        if(! r.has_error())
+        {
+            auto const bytes =
+                r.value().to_bytes();
+            std::memcpy(ip_addr_,
+                bytes.data(), bytes.size());
+            host_type_ =
+                urls::host_type::ipv4;
+            decoded_[id_host] =
+                len(id_host);
+        }
+    }
+
+    remove_dot_segments();
+    build_tab();
+    check_invariants();
     return *this;
 }
 
@@ -2056,37 +2076,53 @@ check_invariants() const noexcept
         len(id_frag) == 0 ||
         get(id_frag).starts_with('#'));
     BOOST_ASSERT(c_str()[size()] == '\0');
-    // validate segments
-#if 0
-    if(nseg > 0)
+#ifndef NDEBUG
+    // validate the table
+    if(nseg_ > 1)
     {
-        auto it = cs_ +
-            offset(id_path);
-        auto const end = s_ +
-            offset(id_query);
-        error_code ec;
-        pct_encoded_str t;
-        auto start = it;
-        if(get(id_path).starts_with('/'))
-            path_abempty_bnf::begin(
-                it, end, ec, t);
-        else
-            path_rootless_bnf::begin(
-                it, end, ec, t);
-        for(std::size_t i = 0;;++i)
+        auto const s = get(id_path);
+        auto const end =
+            s.data() + s.size();
+        auto it = s.data() +
+            detail::path_prefix(s);
+        for(std::size_t i = 1;
+            i < nseg_; ++i)
         {
-            if(ec == error::end)
-                break;
-            BOOST_ASSERT(! ec.failed());
-            if(ec.failed())
+            while( it != end &&
+                    *it != '/')
+                ++it;
+            // too many segments
+            BOOST_ASSERT(it != end);
+            if(it == end)
                 break;
             BOOST_ASSERT(
-                cs_ + segment_pos(i) == start);
+                seg_tab(i) ==
+                    pos_t(it - s.data()));
+            ++it;
+        }
+        BOOST_ASSERT(std::memchr(it, '/',
+            end - it) == nullptr);
+    }
+    if(nparam_ > 1)
+    {
+        auto const s = get(id_query);
+        auto const end =
+            s.data() + s.size();
+        auto it = s.data();
+        for(std::size_t i = 1;
+            i < nparam_; ++i)
+        {
+            while( ++it != end &&
+                    *it != '&')
+            {
+            }
+            // too many params
+            BOOST_ASSERT(it != end);
+            if(it == end)
+                break;
             BOOST_ASSERT(
-                start + segment_len(i) == it);
-            start = it;
-            path_abempty_bnf::increment(
-                it, end, ec, t);
+                param_tab(i) ==
+                    pos_t(it - s.data()));
         }
     }
 #endif
@@ -2096,68 +2132,79 @@ void
 url::
 build_tab() noexcept
 {
-#if 0
     // path
     if(nseg_ > 1)
     {
-        error_code ec;
-        // path table
-        pos_t* tab = tab_end() - 1;
-        auto s = get(id_path);
-        auto it = s.data();
-        auto const end = it + s.size();
-        pct_encoded_str t;
-        if( s.starts_with('/') ||
-            s.empty())
-            path_abempty_bnf::begin(
-                it, end, ec, t);
-        else
-            path_rootless_bnf::begin(
-                it, end, ec, t);
-        for(;;)
+        auto const s = get(id_path);
+        auto it = s.data() +
+            detail::path_prefix(s);
+        auto const end =
+            s.data() + s.size();
+        for(std::size_t i = 1;
+            i < nseg_; ++i)
         {
-            if(ec == error::end)
-                break;
-            if(ec)
-                detail::throw_system_error(ec,
-                    BOOST_CURRENT_LOCATION);
-            *tab = it - s_;
-            tab -= 2;
-            path_abempty_bnf::increment(
-                it, end, ec, t);
+            it = static_cast<
+                char const*>(std::memchr(
+                    it, '/', end - it));
+            BOOST_ASSERT(it != nullptr);
+            seg_tab(i) = it - s.data();
+            ++it;
         }
     }
     // query
     if(nparam_ > 1)
     {
-        error_code ec;
-        // query table
-        pos_t* tab = tab_end() - 2;
-        auto s = get(id_query);
+        auto const s = get(id_query);
         auto it = s.data();
-        auto const end = it + s.size();
-        query_param t;
-        query_bnf::begin(
-            it, end, ec, t);
-        for(;;)
+        auto const end =
+            s.data() + s.size();
+        for(std::size_t i = 1;
+            i < nparam_; ++i)
         {
-            if(ec == error::end)
-                break;
-            if(ec)
-                detail::throw_system_error(ec,
-                    BOOST_CURRENT_LOCATION);
-            *tab = it - s_;
-            tab -= 2;
-            query_bnf::increment(
-                it, end, ec, t);
+            it = static_cast<
+                char const*>(std::memchr(
+                    it, '&', end - it));
+            BOOST_ASSERT(it != nullptr);
+            param_tab(i) = it - s.data();
+            ++it;
         }
     }
-#endif
 }
 
+// Remove the dot segments from the path,
+// in place, and set the number of segments
+// and the decoded size from the result.
 void
 url::
-ensure_space(
+remove_dot_segments() noexcept
+{
+    std::size_t nseg;
+    auto const n = detail::remove_dot_segments(
+        s_ + offset(id_path), len(id_path),
+        has_scheme(), has_authority(), nseg);
+    nseg_ = nseg;
+    resize_impl(id_path, n);
+    decoded_[id_path] =
+        pct_decode_bytes_unchecked(
+            get(id_path));
+}
+
+// adjust the path table after n chars
+// are added to, or removed from, the
+// front of the path (n may wrap)
+void
+url::
+shift_segments(
+    std::size_t n) noexcept
+{
+    for(std::size_t i = 1;
+        i < nseg_; ++i)
+        seg_tab(i) += n;
+}
+
+std::size_t
+url::
+capacity_for(
     std::size_t nchar, // excluding null
     std::size_t nseg,
     std::size_t nparam)
@@ -2169,18 +2216,33 @@ ensure_space(
         detail::throw_length_error(
             "nchar > max_size",
             BOOST_CURRENT_LOCATION);
-    std::size_t new_cap = nchar + 1;
-    if(nseg_ > 1)
-        new_cap += sizeof(pos_t) *
-            (nseg - 1);
-    if(nparam > 0)
-        new_cap += 2 * sizeof(pos_t) *
-            nparam;
+    std::size_t n = nchar + 1;
+    {
+        // see url_view::table_bytes
+        auto const nt =
+            nseg > nparam ? nseg : nparam;
+        if(nt > 1)
+            n += 2 * sizeof(pos_t) *
+                (nt - 1);
+    }
+    return n;
+}
+
+void
+url::
+ensure_space(
+    std::size_t nchar, // excluding null
+    std::size_t nseg,
+    std::size_t nparam)
+{
+    std::size_t new_cap =
+        capacity_for(nchar, nseg, nparam);
     if(new_cap <= cap_)
         return;
     char* s;
     if(s_ != nullptr)
     {
+        auto const cap0 = cap_;
         // 50% growth policy
         auto n = cap_ + (cap_ / 2);
         if(n < cap_)
@@ -2193,7 +2255,16 @@ ensure_space(
             new_cap = n;
         s = allocate(new_cap);
         std::memcpy(s, s_, size());
+        // the table is at the end
+        auto const tb = table_bytes();
+        std::memcpy(s + cap_ - tb,
+            s_ + cap0 - tb, tb);
+        // deallocate sees the
+        // capacity of s_
+        auto const cap1 = cap_;
+        cap_ = cap0;
         deallocate(s_);
+        cap_ = cap1;
     }
     else
     {
@@ -2220,6 +2291,10 @@ resize_impl(
     int last,
     std::size_t new_len)
 {
+    // The table is relative to the start
+    // of the path and query, so callers
+    // which change the contents of either
+    // update it themselves.
     auto const n0 = len(first, last);
     if(new_len == 0 && n0 == 0)
         return s_ + offset(first);
@@ -2241,29 +2316,6 @@ resize_impl(
         // shift (last, end) left
         adjust(
             last, id_end, 0 - n);
-#if 0
-        // update table
-        if( nseg > 1 &&
-            first <= id_path)
-        {
-            // adjust segments
-            auto const tab =
-                tab_end() - 1;
-            for(std::size_t i = 0;
-                i < nseg - 1; ++i)
-                tab[0-2*i] += 0 - n;
-        }
-        if( nparam > 1 &&
-            first <= id_query)
-        {
-            // adjust params
-            auto const tab =
-                tab_end() - 2;
-            for(std::size_t i = 0;
-                i < nparam - 1; ++i)
-                tab[0-2*i] += 0 - n;
-        }
-#endif
         s_[size()] = '\0';
         return s_ + offset(first);
     }
@@ -2285,31 +2337,6 @@ resize_impl(
         offset(last) + n);
     // shift (last, end) right
     adjust(last, id_end, n);
-#if 0
-    // update table
-    if( nseg > 1 &&
-        last > id_path &&
-        first < id_path)
-    {
-        // adjust segments
-        auto const tab =
-            tab_end() - 1;
-        for(std::size_t i = 0;
-            i < nseg - 1; ++i)
-            tab[0-2*i] += n;
-    }
-    if( nparam > 1 &&
-        last > id_query &&
-        first < id_query)
-    {
-        // adjust params
-        auto const tab =
-            tab_end() - 2;
-        for(std::size_t i = 0;
-            i < nparam - 1; ++i)
-            tab[0-2*i] += n;
-    }
-#endif
     s_[size()] = '\0';
     return s_ + offset(first);
 }
@@ -0,0 +1,496 @@
+//
+// Copyright (c) 2019 Vinnie Falco (vinnie.falco@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/CPPAlliance/url
+//
+
+#ifndef BOOST_URL_IMPL_URL_BUILDER_IPP
+#define BOOST_URL_IMPL_URL_BUILDER_IPP
+
+#include <boost/url/url_builder.hpp>
+#include <boost/url/pct_encoding.hpp>
+#include <boost/url/bnf/parse.hpp>
+#include <boost/url/detail/except.hpp>
+#include <boost/url/detail/print.hpp>
+#include <boost/url/rfc/charsets.hpp>
+#include <boost/url/rfc/scheme_bnf.hpp>
+#include <cstring>
+
+namespace boost {
+namespace urls {
+
+namespace detail {
+namespace builder {
+
+constexpr bnf::lut_chars user_chars =
+    unreserved_chars + subdelim_chars;
+constexpr bnf::lut_chars pass_chars =
+    user_chars + ':';
+// sub-delims are not
+// in this reg-name
+constexpr bnf::lut_chars host_chars =
+    unreserved_chars;
+constexpr bnf::lut_chars key_chars =
+    urls::query_chars - '&' - '=';
+constexpr bnf::lut_chars value_chars =
+    urls::query_chars - '&';
+
+} // builder
+} // detail
+
+void
+url_builder::
+clear() noexcept
+{
+    segs_.clear();
+    params_.clear();
+    host_type_ = urls::host_type::none;
+    port_ = 0;
+    has_scheme_ = false;
+    has_user_ = false;
+    has_pass_ = false;
+    has_port_ = false;
+    has_frag_ = false;
+    abs_ = false;
+}
+
+url_builder&
+url_builder::
+set_scheme(string_view s) noexcept
+{
+    scheme_ = s;
+    has_scheme_ = true;
+    return *this;
+}
+
+url_builder&
+url_builder::
+set_scheme(urls::scheme id) noexcept
+{
+    BOOST_ASSERT(
+        id != urls::scheme::unknown);
+    if(id == urls::scheme::none)
+    {
+        has_scheme_ = false;
+        return *this;
+    }
+    return set_scheme(to_string(id));
+}
+
+url_builder&
+url_builder::
+set_user(string_view s) noexcept
+{
+    user_ = s;
+    has_user_ = true;
+    if(host_type_ == urls::host_type::none)
+    {
+        host_ = {};
+        host_type_ = urls::host_type::name;
+    }
+    return *this;
+}
+
+url_builder&
+url_builder::
+set_password(string_view s) noexcept
+{
+    pass_ = s;
+    has_pass_ = true;
+    if(host_type_ == urls::host_type::none)
+    {
+        host_ = {};
+        host_type_ = urls::host_type::name;
+    }
+    return *this;
+}
+
+url_builder&
+url_builder::
+set_host(string_view s) noexcept
+{
+    // try ipv4
+    {
+        auto r = parse_ipv4_address(s);
+        if(! r.has_error())
+            return set_host(r.value());
+    }
+    host_ = s;
+    host_type_ = urls::host_type::name;
+    return *this;
+}
+
+url_builder&
+url_builder::
+set_host(ipv4_address const& addr) noexcept
+{
+    ip_n_ = addr.to_buffer(ip_buf_,
+        sizeof(ip_buf_)).size();
+    auto const bytes = addr.to_bytes();
+    std::memcpy(ip_addr_,
+        bytes.data(), bytes.size());
+    host_type_ = urls::host_type::ipv4;
+    return *this;
+}
+
+url_builder&
+url_builder::
+set_host(ipv6_address const& addr) noexcept
+{
+    ip_n_ = 2 + addr.to_buffer(ip_buf_ + 1,
+        sizeof(ip_buf_) - 2).size();
+    ip_buf_[0] = '[';
+    ip_buf_[ip_n_ - 1] = ']';
+    auto const bytes = addr.to_bytes();
+    std::memcpy(ip_addr_,
+        bytes.data(), bytes.size());
+    host_type_ = urls::host_type::ipv6;
+    return *this;
+}
+
+url_builder&
+url_builder::
+set_port(std::uint16_t n) noexcept
+{
+    port_ = n;
+    has_port_ = true;
+    if(host_type_ == urls::host_type::none)
+    {
+        host_ = {};
+        host_type_ = urls::host_type::name;
+    }
+    return *this;
+}
+
+url_builder&
+url_builder::
+set_path_absolute(bool absolute) noexcept
+{
+    abs_ = absolute;
+    return *this;
+}
+
+url_builder&
+url_builder::
+add_segment(string_view s)
+{
+    segs_.push_back(s);
+    return *this;
+}
+
+url_builder&
+url_builder::
+add_param(string_view key)
+{
+    params_.push_back({ key, {}, false });
+    return *this;
+}
+
+url_builder&
+url_builder::
+add_param(
+    string_view key,
+    string_view value)
+{
+    params_.push_back({ key, value, true });
+    return *this;
+}
+
+url_builder&
+url_builder::
+set_fragment(string_view s) noexcept
+{
+    frag_ = s;
+    has_frag_ = true;
+    return *this;
+}
+
+//------------------------------------------------
+
+/*  The path is the segments joined by
+    slashes, after a prefix which keeps
+    the segments when the URL is parsed.
+    An absolute path whose first segment
+    is empty begins with "/./" so it is
+    not taken for an authority, or for
+    no segments at all. A relative path
+    begins with "./" when its first segment
+    is empty, or when it has a colon and
+    could be taken for a scheme. A first
+    segment of "." is itself read as a
+    prefix, so it gets one as well.
+*/
+std::size_t
+url_builder::
+path_prefix() const noexcept
+{
+    bool const has_auth =
+        host_type_ != urls::host_type::none;
+    if(segs_.empty())
+        return abs_ ? 1 : 0;
+    bool const dot =
+        segs_[0].empty() ||
+        segs_[0] == ".";
+    if(abs_ || has_auth)
+        return dot ? 3 : 1;
+    if(dot)
+        return 2;
+    if( ! has_scheme_ &&
+        segs_[0].find(':') !=
+            string_view::npos)
+        return 2;
+    return 0;
+}
+
+std::size_t
+url_builder::
+size() const
+{
+    using namespace detail::builder;
+    std::size_t n = 0;
+    if(has_scheme_)
+    {
+        scheme_bnf b;
+        error_code ec;
+        bnf::parse_string(scheme_, ec, b);
+        if(ec.failed())
+            detail::throw_invalid_argument(
+                BOOST_CURRENT_LOCATION);
+        n += scheme_.size() + 1;
+    }
+    if(host_type_ != urls::host_type::none)
+    {
+        n += 2;
+        if(has_user_)
+            n += pct_encode_bytes(
+                user_, user_chars);
+        if(has_pass_)
+            n += 1 + pct_encode_bytes(
+                pass_, pass_chars);
+        if(has_user_ || has_pass_)
+            n += 1;
+        if(host_type_ == urls::host_type::name)
+            n += pct_encode_bytes(
+                host_, host_chars);
+        else
+            n += ip_n_;
+        if(has_port_)
+            n += 1 + detail::make_printed(
+                port_).string().size();
+    }
+    n += path_prefix();
+    if(! segs_.empty())
+    {
+        n += segs_.size() - 1;
+        for(auto const& s : segs_)
+            n += pct_encode_bytes(s, pchars);
+    }
+    if(! params_.empty())
+    {
+        n += params_.size();
+        for(auto const& p : params_)
+        {
+            n += pct_encode_bytes(
+                p.key, key_chars);
+            if(p.has_value)
+                n += 1 + pct_encode_bytes(
+                    p.value, value_chars);
+        }
+    }
+    if(has_frag_)
+        n += 1 + pct_encode_bytes(
+            frag_, fragment_chars);
+    return n;
+}
+
+void
+url_builder::
+build(url& u) const
+{
+    using namespace detail::builder;
+    auto const n = size();
+    if(n == 0)
+    {
+        u.clear();
+        return;
+    }
+
+    // strong guarantee: nothing
+    // is changed before this
+    auto const new_cap = url::capacity_for(
+        n, segs_.size(), params_.size());
+    char* const s0 = u.s_;
+    auto const cap0 = u.cap_;
+    bool const grow = new_cap > cap0;
+    if(grow)
+        u.s_ = u.allocate(new_cap);
+    char* const s = u.s_;
+
+    // each part is written once,
+    // into its final position
+    auto const end = s + n;
+    auto dest = s;
+    auto const put = [&dest](
+        string_view v)
+    {
+        std::memcpy(dest,
+            v.data(), v.size());
+        dest += v.size();
+    };
+    url_view& v = u.base();
+    std::memset(v.decoded_, 0,
+        sizeof(v.decoded_));
+    std::memset(v.ip_addr_, 0,
+        sizeof(v.ip_addr_));
+    if(has_scheme_)
+    {
+        put(scheme_);
+        *dest++ = ':';
+        v.scheme_ =
+            string_to_scheme(scheme_);
+    }
+    else
+    {
+        v.scheme_ = urls::scheme::none;
+    }
+    v.offset_[url::id_user] = dest - s;
+    v.host_type_ = host_type_;
+    v.port_number_ = 0;
+    if(host_type_ != urls::host_type::none)
+    {
+        *dest++ = '/';
+        *dest++ = '/';
+        if(has_user_)
+        {
+            dest += pct_encode(dest, end,
+                user_, user_chars);
+            v.decoded_[url::id_user] =
+                user_.size();
+        }
+        v.offset_[url::id_pass] = dest - s;
+        if(has_pass_)
+        {
+            *dest++ = ':';
+            dest += pct_encode(dest, end,
+                pass_, pass_chars);
+            v.decoded_[url::id_pass] =
+                pass_.size();
+        }
+        if(has_user_ || has_pass_)
+            *dest++ = '@';
+        v.offset_[url::id_host] = dest - s;
+        if(host_type_ == urls::host_type::name)
+        {
+            dest += pct_encode(dest, end,
+                host_, host_chars);
+            v.decoded_[url::id_host] =
+                host_.size();
+        }
+        else
+        {
+            put(string_view(ip_buf_, ip_n_));
+            v.decoded_[url::id_host] = ip_n_;
+            std::memcpy(v.ip_addr_,
+                ip_addr_, sizeof(ip_addr_));
+        }
+        v.offset_[url::id_port] = dest - s;
+        if(has_port_)
+        {
+            *dest++ = ':';
+            put(detail::make_printed(
+                port_).string());
+            v.port_number_ = port_;
+        }
+    }
+    else
+    {
+        v.offset_[url::id_pass] = dest - s;
+        v.offset_[url::id_host] = dest - s;
+        v.offset_[url::id_port] = dest - s;
+    }
+
+    // the segment table is written
+    // with the path, see build_tab
+    v.offset_[url::id_path] = dest - s;
+    v.nseg_ = segs_.size();
+    switch(path_prefix())
+    {
+    case 3: put("/./"); break;
+    case 2: put("./"); break;
+    case 1: *dest++ = '/'; break;
+    default: break;
+    }
+    for(std::size_t i = 0;
+        i < segs_.size(); ++i)
+    {
+        if(i > 0)
+        {
+            u.seg_tab(i) = (dest - s) -
+                v.offset_[url::id_path];
+            *dest++ = '/';
+        }
+        dest += pct_encode(dest, end,
+            segs_[i], pchars);
+    }
+
+    v.offset_[url::id_query] = dest - s;
+    v.nparam_ = params_.size();
+    for(std::size_t i = 0;
+        i < params_.size(); ++i)
+    {
+        if(i > 0)
+            u.param_tab(i) = (dest - s) -
+                v.offset_[url::id_query];
+        *dest++ = i > 0 ? '&' : '?';
+        auto const& p = params_[i];
+        dest += pct_encode(dest, end,
+            p.key, key_chars);
+        if(p.has_value)
+        {
+            *dest++ = '=';
+            dest += pct_encode(dest, end,
+                p.value, value_chars);
+        }
+    }
+
+    v.offset_[url::id_frag] = dest - s;
+    if(has_frag_)
+    {
+        *dest++ = '#';
+        dest += pct_encode(dest, end,
+            frag_, fragment_chars);
+        v.decoded_[url::id_frag] =
+            frag_.size();
+    }
+    BOOST_ASSERT(dest == end);
+    v.offset_[url::id_end] = n;
+    s[n] = '\0';
+    v.cs_ = s;
+    if(grow && s0)
+    {
+        // deallocate sees the
+        // capacity of s0
+        auto const cap1 = u.cap_;
+        u.cap_ = cap0;
+        u.deallocate(s0);
+        u.cap_ = cap1;
+    }
+    u.check_invariants();
+}
+
+url
+url_builder::
+build() const
+{
+    url u;
+    build(u);
+    return u;
+}
+
+} // urls
+} // boost
+
+#endif
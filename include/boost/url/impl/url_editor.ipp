@@ -0,0 +1,576 @@
+//
+// Copyright (c) 2019 Vinnie Falco (vinnie.falco@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/CPPAlliance/url
+//
+
+#ifndef BOOST_URL_IMPL_URL_EDITOR_IPP
+#define BOOST_URL_IMPL_URL_EDITOR_IPP
+
+#include <boost/url/url_editor.hpp>
+#include <boost/url/pct_encoding.hpp>
+#include <boost/url/url_stream_parser.hpp>
+#include <boost/url/detail/except.hpp>
+#include <boost/url/detail/print.hpp>
+#include <boost/url/rfc/charsets.hpp>
+#include <algorithm>
+#include <cstring>
+#include <iterator>
+
+namespace boost {
+namespace urls {
+
+char*
+url_editor::
+set_impl(
+    int id,
+    std::size_t n)
+{
+    auto& v = v_[id];
+    v.pos = buf_.size();
+    v.len = n;
+    v.st = st_set;
+    buf_.resize(v.pos + n);
+    if( id >= p_user &&
+        id <= p_port)
+        auth_ = st_set;
+    return &buf_[v.pos];
+}
+
+void
+url_editor::
+set_impl(
+    int id,
+    string_view s)
+{
+    auto const dest =
+        set_impl(id, s.size());
+    if(! s.empty())
+        std::memcpy(dest,
+            s.data(), s.size());
+}
+
+// the characters of a part, without
+// its delimiters, in the committed URL
+string_view
+url_editor::
+get(int id) const noexcept
+{
+    auto const& v = v_[id];
+    if(v.st == st_set)
+        return { buf_.data() + v.pos, v.len };
+    if(v.st == st_remove)
+        return {};
+    switch(id)
+    {
+    case p_scheme:
+        return u_.scheme();
+    case p_user:
+        return u_.encoded_user();
+    case p_pass:
+        return u_.encoded_password();
+    case p_host:
+        return u_.encoded_host();
+    case p_port:
+        return u_.port();
+    case p_path:
+        return u_.encoded_path();
+    case p_query:
+        return u_.encoded_query();
+    default:
+    case p_frag:
+        return u_.encoded_fragment();
+    }
+}
+
+bool
+url_editor::
+empty() const noexcept
+{
+    if(auth_ != st_keep)
+        return false;
+    for(auto const& v : v_)
+        if(v.st != st_keep)
+            return false;
+    return true;
+}
+
+void
+url_editor::
+reset() noexcept
+{
+    buf_.clear();
+    for(auto& v : v_)
+        v = slot();
+    auth_ = st_keep;
+}
+
+/*  The new URL is a list of pieces, each
+    either a delimiter, a recorded part, or
+    a part of the old URL. The pieces are
+    parsed as they are to validate the
+    result and build its table, and then
+    written once. When the capacity is
+    enough the pieces of the old URL are
+    moved in place: those moving left in
+    order, then those moving right in
+    reverse order, so none overwrites a
+    piece not yet moved.
+*/
+void
+url_editor::
+commit()
+{
+    bool const has_scheme =
+        v_[p_scheme].st == st_keep ?
+            u_.has_scheme() :
+            v_[p_scheme].st == st_set;
+    bool const has_auth =
+        auth_ == st_keep ?
+            u_.has_authority() :
+            auth_ == st_set;
+    bool const has_pass =
+        v_[p_pass].st == st_keep ?
+            u_.has_password() :
+            v_[p_pass].st == st_set;
+    bool const has_userinfo =
+        v_[p_user].st == st_set ||
+        v_[p_pass].st == st_set ? true :
+        v_[p_user].st == st_remove ? false :
+            u_.has_userinfo();
+    bool const has_port =
+        v_[p_port].st == st_keep ?
+            u_.has_port() :
+            v_[p_port].st == st_set;
+    bool const has_query =
+        v_[p_query].st == st_keep ?
+            u_.has_query() :
+            v_[p_query].st == st_set;
+    bool const has_frag =
+        v_[p_frag].st == st_keep ?
+            u_.has_fragment() :
+            v_[p_frag].st == st_set;
+
+    // the pieces, and the offsets
+    // of the parts as in url_view
+    string_view v[15];
+    std::size_t nv = 0;
+    pos_t off[detail::parts_base::id_end + 1];
+    std::size_t n = 0;
+    auto const add =
+        [&v, &nv, &n](string_view s)
+    {
+        if(s.empty())
+            return;
+        v[nv++] = s;
+        n += s.size();
+    };
+    if(has_scheme)
+    {
+        add(get(p_scheme));
+        add(":");
+    }
+    off[detail::parts_base::id_user] = n;
+    if(has_auth)
+    {
+        add("//");
+        add(get(p_user));
+    }
+    off[detail::parts_base::id_pass] = n;
+    if(has_auth && has_pass)
+    {
+        add(":");
+        add(get(p_pass));
+    }
+    if(has_auth && has_userinfo)
+        add("@");
+    off[detail::parts_base::id_host] = n;
+    if(has_auth)
+        add(get(p_host));
+    off[detail::parts_base::id_port] = n;
+    if(has_auth && has_port)
+    {
+        add(":");
+        add(get(p_port));
+    }
+    off[detail::parts_base::id_path] = n;
+    add(get(p_path));
+    off[detail::parts_base::id_query] = n;
+    if(has_query)
+    {
+        add("?");
+        add(get(p_query));
+    }
+    off[detail::parts_base::id_frag] = n;
+    if(has_frag)
+    {
+        add("#");
+        add(get(p_frag));
+    }
+    off[detail::parts_base::id_end] = n;
+
+    if(n == 0)
+    {
+        u_.clear();
+        reset();
+        return;
+    }
+
+    url_stream_parser p;
+    error_code ec;
+    for(std::size_t i = 0; i < nv; ++i)
+    {
+        p.write(v[i], ec);
+        if(ec.failed())
+            detail::throw_invalid_argument(
+                BOOST_CURRENT_LOCATION);
+    }
+    p.finish(ec);
+    if(ec.failed())
+        detail::throw_invalid_argument(
+            BOOST_CURRENT_LOCATION);
+    if(! std::equal(
+            std::begin(off),
+            std::end(off),
+            std::begin(p.offset_)))
+        detail::throw_invalid_argument(
+            BOOST_CURRENT_LOCATION);
+
+    // strong guarantee: nothing
+    // is changed before this
+    auto const new_cap = url::capacity_for(
+        n, p.nseg_, p.nparam_);
+    char* const s0 = u_.s_;
+    auto const n0 = u_.size();
+    auto const in_old =
+        [s0, n0](string_view s)
+    {
+        return s0 &&
+            s.data() >= s0 &&
+            s.data() < s0 + n0;
+    };
+    if(new_cap > u_.cap_)
+    {
+        // one allocation, then each
+        // piece is copied into place
+        auto const cap0 = u_.cap_;
+        char* const s = u_.allocate(new_cap);
+        auto dest = s;
+        for(std::size_t i = 0; i < nv; ++i)
+        {
+            std::memcpy(dest,
+                v[i].data(), v[i].size());
+            dest += v[i].size();
+        }
+        if(s0)
+        {
+            // deallocate sees the
+            // capacity of s0
+            auto const cap1 = u_.cap_;
+            u_.cap_ = cap0;
+            u_.deallocate(s0);
+            u_.cap_ = cap1;
+        }
+        u_.s_ = s;
+    }
+    else
+    {
+        char* const s = u_.s_;
+        std::size_t d[15];
+        {
+            std::size_t pos = 0;
+            for(std::size_t i = 0; i < nv; ++i)
+            {
+                d[i] = pos;
+                pos += v[i].size();
+            }
+        }
+        for(std::size_t i = 0; i < nv; ++i)
+        {
+            if( in_old(v[i]) &&
+                s + d[i] < v[i].data())
+                std::memmove(s + d[i],
+                    v[i].data(), v[i].size());
+        }
+        for(std::size_t i = nv; i-- > 0;)
+        {
+            if( in_old(v[i]) &&
+                s + d[i] > v[i].data())
+                std::memmove(s + d[i],
+                    v[i].data(), v[i].size());
+        }
+        for(std::size_t i = 0; i < nv; ++i)
+        {
+            if(! in_old(v[i]))
+                std::memcpy(s + d[i],
+                    v[i].data(), v[i].size());
+        }
+    }
+    u_.s_[n] = '\0';
+    u_.base() = p.view(
+        string_view(u_.s_, n));
+    u_.cs_ = u_.s_;
+    u_.build_tab();
+    u_.check_invariants();
+    reset();
+}
+
+//------------------------------------------------
+
+url_editor&
+url_editor::
+set_scheme(string_view s)
+{
+    set_impl(p_scheme, s);
+    return *this;
+}
+
+url_editor&
+url_editor::
+remove_scheme() noexcept
+{
+    v_[p_scheme] = slot();
+    v_[p_scheme].st = st_remove;
+    return *this;
+}
+
+url_editor&
+url_editor::
+set_user(string_view s)
+{
+    static constexpr auto cs =
+        unreserved_chars +
+        subdelim_chars;
+    set_impl(p_user, pct_encode_bytes(
+        s, cs));
+    auto& v = v_[p_user];
+    pct_encode(&buf_[v.pos],
+        &buf_[v.pos] + v.len, s, cs);
+    return *this;
+}
+
+url_editor&
+url_editor::
+set_encoded_user(string_view s)
+{
+    set_impl(p_user, s);
+    return *this;
+}
+
+url_editor&
+url_editor::
+set_password(string_view s)
+{
+    static constexpr auto cs =
+        unreserved_chars +
+        subdelim_chars + ':';
+    set_impl(p_pass, pct_encode_bytes(
+        s, cs));
+    auto& v = v_[p_pass];
+    pct_encode(&buf_[v.pos],
+        &buf_[v.pos] + v.len, s, cs);
+    return *this;
+}
+
+url_editor&
+url_editor::
+set_encoded_password(string_view s)
+{
+    set_impl(p_pass, s);
+    return *this;
+}
+
+url_editor&
+url_editor::
+remove_userinfo() noexcept
+{
+    v_[p_user] = slot();
+    v_[p_user].st = st_remove;
+    v_[p_pass] = slot();
+    v_[p_pass].st = st_remove;
+    return *this;
+}
+
+url_editor&
+url_editor::
+set_host(string_view s)
+{
+    {
+        auto r = parse_ipv4_address(s);
+        if(! r.has_error())
+            return set_host(r.value());
+    }
+    static constexpr auto cs =
+        unreserved_chars +
+        subdelim_chars;
+    set_impl(p_host, pct_encode_bytes(
+        s, cs));
+    auto& v = v_[p_host];
+    pct_encode(&buf_[v.pos],
+        &buf_[v.pos] + v.len, s, cs);
+    return *this;
+}
+
+url_editor&
+url_editor::
+set_host(ipv4_address const& addr)
+{
+    char buf[ipv4_address::max_str_len];
+    set_impl(p_host, addr.to_buffer(
+        buf, sizeof(buf)));
+    return *this;
+}
+
+url_editor&
+url_editor::
+set_host(ipv6_address const& addr)
+{
+    char buf[2 + ipv6_address::max_str_len];
+    auto s = addr.to_buffer(
+        buf + 1, sizeof(buf) - 2);
+    buf[0] = '[';
+    buf[s.size() + 1] = ']';
+    set_impl(p_host, string_view(
+        buf, s.size() + 2));
+    return *this;
+}
+
+url_editor&
+url_editor::
+set_encoded_host(string_view s)
+{
+    set_impl(p_host, s);
+    return *this;
+}
+
+url_editor&
+url_editor::
+set_port(std::uint16_t n)
+{
+    auto s = detail::make_printed(n);
+    set_impl(p_port, s.string());
+    return *this;
+}
+
+url_editor&
+url_editor::
+set_port(string_view s)
+{
+    set_impl(p_port, s);
+    return *this;
+}
+
+url_editor&
+url_editor::
+remove_port() noexcept
+{
+    v_[p_port] = slot();
+    v_[p_port].st = st_remove;
+    return *this;
+}
+
+url_editor&
+url_editor::
+remove_authority() noexcept
+{
+    for(int id = p_user;
+        id <= p_port; ++id)
+    {
+        v_[id] = slot();
+        v_[id].st = st_remove;
+    }
+    auth_ = st_remove;
+    return *this;
+}
+
+url_editor&
+url_editor::
+set_path(string_view s)
+{
+    static constexpr auto cs =
+        pchars + '/';
+    set_impl(p_path, pct_encode_bytes(
+        s, cs));
+    auto& v = v_[p_path];
+    pct_encode(&buf_[v.pos],
+        &buf_[v.pos] + v.len, s, cs);
+    return *this;
+}
+
+url_editor&
+url_editor::
+set_encoded_path(string_view s)
+{
+    set_impl(p_path, s);
+    return *this;
+}
+
+url_editor&
+url_editor::
+set_query(string_view s)
+{
+    static constexpr auto cs =
+        pchars + '/' + '?';
+    set_impl(p_query, pct_encode_bytes(
+        s, cs));
+    auto& v = v_[p_query];
+    pct_encode(&buf_[v.pos],
+        &buf_[v.pos] + v.len, s, cs);
+    return *this;
+}
+
+url_editor&
+url_editor::
+set_encoded_query(string_view s)
+{
+    set_impl(p_query, s);
+    return *this;
+}
+
+url_editor&
+url_editor::
+remove_query() noexcept
+{
+    v_[p_query] = slot();
+    v_[p_query].st = st_remove;
+    return *this;
+}
+
+url_editor&
+url_editor::
+set_fragment(string_view s)
+{
+    static constexpr auto cs =
+        pchars + '/' + '?';
+    set_impl(p_frag, pct_encode_bytes(
+        s, cs));
+    auto& v = v_[p_frag];
+    pct_encode(&buf_[v.pos],
+        &buf_[v.pos] + v.len, s, cs);
+    return *this;
+}
+
+url_editor&
+url_editor::
+set_encoded_fragment(string_view s)
+{
+    set_impl(p_frag, s);
+    return *this;
+}
+
+url_editor&
+url_editor::
+remove_fragment() noexcept
+{
+    v_[p_frag] = slot();
+    v_[p_frag].st = st_remove;
+    return *this;
+}
+
+} // urls
+} // boost
+
+#endif
@@ -0,0 +1,128 @@
+//
+// Copyright (c) 2019 Vinnie Falco (vinnie.falco@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/CPPAlliance/url
+//
+
+#ifndef BOOST_URL_IMPL_URL_PIECES_HPP
+#define BOOST_URL_IMPL_URL_PIECES_HPP
+
+namespace boost {
+namespace urls {
+
+namespace detail {
+
+// true if T is a buffer
+template<class T, class = void>
+struct is_url_buffer : std::false_type
+{
+};
+
+template<class T>
+struct is_url_buffer<T, boost::void_t<
+    decltype(
+    std::declval<void const*&>() =
+        std::declval<T const&>().data(),
+    std::declval<std::size_t&>() =
+        std::declval<T const&>().size()
+            ) > > : std::true_type
+{
+};
+
+// true if T is a range of buffers. This is
+// checked first, as a range such as a vector
+// of buffers has data() and size() too.
+template<class T, class = void>
+struct is_url_buffers : std::false_type
+{
+};
+
+template<class T>
+struct is_url_buffers<T, boost::void_t<
+    decltype(
+        std::begin(std::declval<T const&>()),
+        std::end(std::declval<T const&>())
+            ) > >
+    : is_url_buffer<typename std::decay<
+        decltype(*std::begin(
+            std::declval<T const&>()))>::type>
+{
+};
+
+template<class Buffer>
+string_view
+to_url_piece(Buffer const& b) noexcept
+{
+    void const* const p = b.data();
+    return string_view(
+        static_cast<char const*>(p),
+        b.size());
+}
+
+} // detail
+
+template<class Buffers>
+result<url_pieces>
+url_pieces::
+parse(
+    Buffers const& buffers,
+    std::true_type)
+{
+    url_stream_parser p;
+    error_code ec;
+    for(auto const& b : buffers)
+    {
+        p.write(detail::to_url_piece(b), ec);
+        if(ec.failed())
+            return ec;
+    }
+    p.finish(ec);
+    if(ec.failed())
+        return ec;
+    url_pieces u(p);
+    for(auto const& b : buffers)
+        u.add(detail::to_url_piece(b));
+    return u;
+}
+
+template<class Buffer>
+result<url_pieces>
+url_pieces::
+parse(
+    Buffer const& buffer,
+    std::false_type)
+{
+    static_assert(
+        detail::is_url_buffer<Buffer>::value,
+        "Buffers requirements not met");
+    auto const s =
+        detail::to_url_piece(buffer);
+    url_stream_parser p;
+    error_code ec;
+    p.write(s, ec);
+    if(ec.failed())
+        return ec;
+    p.finish(ec);
+    if(ec.failed())
+        return ec;
+    url_pieces u(p);
+    u.add(s);
+    return u;
+}
+
+template<class Buffers>
+result<url_pieces>
+parse_uri_reference_buffers(
+    Buffers const& buffers)
+{
+    return url_pieces::parse(buffers,
+        detail::is_url_buffers<Buffers>{});
+}
+
+} // urls
+} // boost
+
+#endif
@@ -0,0 +1,97 @@
+//
+// Copyright (c) 2019 Vinnie Falco (vinnie.falco@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/CPPAlliance/url
+//
+
+#ifndef BOOST_URL_IMPL_URL_PIECES_IPP
+#define BOOST_URL_IMPL_URL_PIECES_IPP
+
+#include <boost/url/url_pieces.hpp>
+#include <algorithm>
+
+namespace boost {
+namespace urls {
+
+url_pieces::
+url_pieces(
+    url_stream_parser const& p)
+    : size_(p.size())
+    , port_number_(p.port_number())
+    , host_type_(p.host_type())
+    , scheme_(p.scheme_id())
+    , has_scheme_(p.has_scheme())
+    , has_authority_(p.has_authority())
+    , has_port_(p.has_port())
+    , has_query_(p.has_query())
+    , has_fragment_(p.has_fragment())
+{
+    for(std::size_t i = 0; i < npart; ++i)
+    {
+        auto const k = static_cast<part>(i);
+        start_[i] = p.offset(k);
+        len_[i] = p.length(k);
+        own_[i] = npos;
+    }
+}
+
+/*  Called with each buffer in order. The
+    parts are disjoint and in order, so the
+    chars of a part which straddles buffers
+    are appended to buf_ without those of
+    any other part in between.
+*/
+void
+url_pieces::
+add(string_view s)
+{
+    auto const first = pos_;
+    auto const last = pos_ + s.size();
+    pos_ = last;
+    for(std::size_t i = 0; i < npart; ++i)
+    {
+        auto const b = start_[i];
+        auto const e = b + len_[i];
+        if( b == e ||
+            e <= first ||
+            b >= last)
+            continue;
+        if( b >= first &&
+            e <= last)
+        {
+            ref_[i] = s.data() + (b - first);
+            continue;
+        }
+        if(own_[i] == npos)
+            own_[i] = buf_.size();
+        auto const b0 = (std::max)(b, first);
+        auto const e0 = (std::min)(e, last);
+        buf_.append(
+            s.data() + (b0 - first),
+            e0 - b0);
+    }
+}
+
+string_view
+url_pieces::
+get(part k) const noexcept
+{
+    auto const i =
+        static_cast<std::size_t>(k);
+    if(own_[i] != npos)
+        return string_view(
+            buf_.data() + own_[i],
+            len_[i]);
+    if(len_[i] == 0)
+        return {};
+    return string_view(
+        ref_[i], len_[i]);
+}
+
+} // urls
+} // boost
+
+#endif
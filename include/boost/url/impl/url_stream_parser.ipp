@@ -0,0 +1,1096 @@
+//
+// Copyright (c) 2019 Vinnie Falco (vinnie.falco@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/CPPAlliance/url
+//
+
+#ifndef BOOST_URL_IMPL_URL_STREAM_PARSER_IPP
+#define BOOST_URL_IMPL_URL_STREAM_PARSER_IPP
+
+#include <boost/url/url_stream_parser.hpp>
+#include <boost/url/ipv6_address.hpp>
+#include <boost/url/bnf/parse.hpp>
+#include <boost/url/detail/except.hpp>
+#include <boost/url/detail/path.hpp>
+#include <boost/url/rfc/charsets.hpp>
+#include <boost/url/rfc/reg_name_bnf.hpp>
+#include <algorithm>
+#include <cstring>
+
+namespace boost {
+namespace urls {
+
+/*  The parser follows url_view::parse_reference,
+    which decides the same URLs as the grammar.
+    Where that function scans ahead and backs
+    up, as for the userinfo or an IPv4 address
+    which turns out to be a reg-name, each
+    candidate is run here as a small machine
+    fed one character at a time, and the
+    character which none of them accepts
+    ends the authority.
+*/
+
+namespace {
+
+// states of the host and port
+enum : unsigned char
+{
+    hp_host,
+    hp_port,
+    hp_literal,
+    hp_literal_done,
+    hp_dead
+};
+
+// states of the IPv4 machine
+enum : unsigned char
+{
+    ip4_failed,
+    ip4_running,
+    ip4_complete
+};
+
+// states of the IP-literal machine
+enum : unsigned char
+{
+    lit_start,
+    lit_ipv6,
+    lit_major0,
+    lit_major,
+    lit_minor0,
+    lit_minor
+};
+
+} // (anon)
+
+url_stream_parser::
+url_stream_parser() noexcept
+{
+    reset();
+}
+
+void
+url_stream_parser::
+reset() noexcept
+{
+    for(auto& v : offset_)
+        v = 0;
+    for(auto& v : decoded_)
+        v = 0;
+    nseg_ = 0;
+    nparam_ = 0;
+    std::memset(ip_addr_, 0,
+        sizeof(ip_addr_));
+    port_number_ = 0;
+    host_type_ = urls::host_type::none;
+    scheme_ = urls::scheme::none;
+    ec_ = {};
+    n_ = 0;
+    st_ = st_start;
+    pct_ = 0;
+    scheme_n_ = 0;
+    path_n_ = 0;
+    has_auth_ = false;
+    has_userinfo_ = false;
+    user_ok_ = false;
+    hp_ = hp_dead;
+    auth_ = 0;
+    host_ = 0;
+    colon_ = 0;
+    esc_[0] = 0;
+    esc_[1] = 0;
+    ip4_ = ip4_failed;
+    ip4_idx_ = 0;
+    ip4_digits_ = 0;
+    ip4_val_ = 0;
+    port_ = 0;
+    port_ovf_ = false;
+    lit_ = lit_start;
+    lit_n_ = 0;
+}
+
+//------------------------------------------------
+
+std::size_t
+url_stream_parser::
+fail(
+    char const* p,
+    char const* data,
+    error_code& ec,
+    error e) noexcept
+{
+    ec_ = BOOST_URL_ERR(e);
+    ec = ec_;
+    st_ = st_error;
+    n_ += p - data;
+    return p - data;
+}
+
+std::size_t
+url_stream_parser::
+stop(
+    char const* p,
+    char const* data,
+    error_code& ec) noexcept
+{
+    ec = {};
+    n_ += p - data;
+    end_url(n_);
+    st_ = st_done;
+    return p - data;
+}
+
+void
+url_stream_parser::
+add_scheme(
+    char const* first,
+    char const* last) noexcept
+{
+    // longer schemes are unknown,
+    // so only count past the buffer
+    while(
+        first != last &&
+        scheme_n_ <= sizeof(scheme_buf_))
+    {
+        if(scheme_n_ < sizeof(scheme_buf_))
+            scheme_buf_[scheme_n_] = *first;
+        ++scheme_n_;
+        ++first;
+    }
+}
+
+void
+url_stream_parser::
+add_path(
+    char const* first,
+    char const* last) noexcept
+{
+    while(
+        first != last &&
+        path_n_ < sizeof(path_buf_))
+        path_buf_[path_n_++] = *first++;
+}
+
+bool
+url_stream_parser::
+accepting() const noexcept
+{
+    if(pct_ != 0)
+        return false;
+    if(st_ != st_auth)
+        return true;
+    return
+        hp_ == hp_host ||
+        hp_ == hp_port ||
+        hp_ == hp_literal_done;
+}
+
+void
+url_stream_parser::
+begin_host(std::size_t pos) noexcept
+{
+    hp_ = hp_host;
+    host_ = pos;
+    colon_ = std::size_t(-1);
+    esc_[0] = 0;
+    esc_[1] = 0;
+    ip4_ = ip4_running;
+    ip4_idx_ = 0;
+    ip4_digits_ = 0;
+    ip4_val_ = 0;
+    port_ = 0;
+    port_ovf_ = false;
+    host_type_ = urls::host_type::none;
+    decoded_[id_host] = 0;
+    std::memset(ip_addr_, 0,
+        sizeof(ip_addr_));
+}
+
+void
+url_stream_parser::
+begin_port(std::size_t pos) noexcept
+{
+    if(host_type_ == urls::host_type::none)
+    {
+        host_type_ = urls::host_type::name;
+        decoded_[id_host] =
+            (pos - host_) - 2 * esc_[0];
+    }
+    hp_ = hp_port;
+    colon_ = pos;
+}
+
+// Feed one char to the IPv4 machine.
+// Returns true if it is part of the
+// address. Otherwise the address is
+// complete or failed before c.
+bool
+url_stream_parser::
+ip4_char(char c) noexcept
+{
+    if(bnf::digit_chars(c))
+    {
+        unsigned const d = c - '0';
+        switch(ip4_digits_)
+        {
+        case 0:
+            ip4_val_ = d;
+            ip4_digits_ = 1;
+            return true;
+
+        case 1:
+            // leading zero
+            if(ip4_val_ == 0)
+                break;
+            ip4_val_ = 10 * ip4_val_ + d;
+            ip4_digits_ = 2;
+            return true;
+
+        case 2:
+            if(ip4_val_ > 25)
+                break;
+            ip4_val_ = 10 * ip4_val_ + d;
+            if(ip4_val_ > 255)
+                break;
+            ip4_digits_ = 3;
+            return true;
+
+        default:
+            break;
+        }
+        if( ip4_idx_ < 3 ||
+            ip4_digits_ < 3)
+        {
+            ip4_ = ip4_failed;
+            return false;
+        }
+    }
+    else if(
+        c == '.' &&
+        ip4_digits_ != 0 &&
+        ip4_idx_ < 3)
+    {
+        ip4_buf_[ip4_idx_++] =
+            static_cast<unsigned char>(
+                ip4_val_);
+        ip4_digits_ = 0;
+        return true;
+    }
+    // like the grammar, a complete
+    // address is not a reg-name
+    if( ip4_idx_ == 3 &&
+        ip4_digits_ != 0)
+    {
+        ip4_buf_[3] = static_cast<
+            unsigned char>(ip4_val_);
+        ip4_ = ip4_complete;
+        return false;
+    }
+    ip4_ = ip4_failed;
+    return false;
+}
+
+// Feed one char to the IP-literal machine,
+// after the '['. Returns false without
+// changing the state if c cannot follow.
+bool
+url_stream_parser::
+literal_char(char c) noexcept
+{
+    static constexpr auto minor_chars =
+        unreserved_chars +
+        subdelim_chars + ':';
+
+    switch(lit_)
+    {
+    case lit_start:
+        if(c == 'v')
+        {
+            lit_ = lit_major0;
+            return true;
+        }
+        BOOST_FALLTHROUGH;
+
+    case lit_ipv6:
+    {
+        if(c == ']')
+        {
+            // the address is only
+            // parsed when complete
+            lit_buf_[lit_n_] = ']';
+            char const* it = lit_buf_;
+            char const* const end =
+                lit_buf_ + lit_n_ + 1;
+            error_code ec;
+            ipv6_address a;
+            if( ! bnf::parse(
+                    it, end, ec, a, ']') ||
+                it != end)
+                return false;
+            auto const bytes = a.to_bytes();
+            std::memcpy(&ip_addr_[0],
+                bytes.data(), 16);
+            host_type_ =
+                urls::host_type::ipv6;
+            hp_ = hp_literal_done;
+            return true;
+        }
+        if( lit_n_ < ipv6_address::max_str_len - 1 &&
+            ( bnf::hexdig_chars(c) ||
+              c == ':' || c == '.'))
+        {
+            lit_buf_[lit_n_++] = c;
+            lit_ = lit_ipv6;
+            return true;
+        }
+        return false;
+    }
+
+    case lit_major0:
+    case lit_major:
+        if(bnf::hexdig_chars(c))
+        {
+            lit_ = lit_major;
+            return true;
+        }
+        if( c == '.' &&
+            lit_ == lit_major)
+        {
+            lit_ = lit_minor0;
+            return true;
+        }
+        return false;
+
+    case lit_minor0:
+    case lit_minor:
+        if(minor_chars(c))
+        {
+            lit_ = lit_minor;
+            return true;
+        }
+        if( c == ']' &&
+            lit_ == lit_minor)
+        {
+            host_type_ =
+                urls::host_type::ipvfuture;
+            hp_ = hp_literal_done;
+            return true;
+        }
+        return false;
+
+    default:
+        return false;
+    }
+}
+
+// Feed one char of the authority to the
+// host and port machine. Returns false
+// without leaving the state if c cannot
+// continue them, so the authority can
+// still end before c.
+bool
+url_stream_parser::
+host_char(
+    char c,
+    std::size_t pos) noexcept
+{
+    switch(hp_)
+    {
+    case hp_host:
+        if(ip4_ == ip4_running)
+        {
+            if(ip4_char(c))
+                return true;
+            if(ip4_ == ip4_complete)
+            {
+                if(c != ':')
+                    return false;
+                std::memcpy(&ip_addr_[0],
+                    ip4_buf_, 4);
+                host_type_ =
+                    urls::host_type::ipv4;
+                begin_port(pos);
+                return true;
+            }
+        }
+        if( c == '[' &&
+            pos == host_)
+        {
+            lit_ = lit_start;
+            lit_n_ = 0;
+            hp_ = hp_literal;
+            return true;
+        }
+        if( reg_name_chars(c) ||
+            c == '%')
+            return true;
+        if(c == ':')
+        {
+            begin_port(pos);
+            return true;
+        }
+        return false;
+
+    case hp_port:
+        if(! bnf::digit_chars(c))
+            return false;
+        if(! port_ovf_)
+        {
+            // as port_bnf
+            std::uint16_t const u0 = port_;
+            port_ = static_cast<std::uint16_t>(
+                10 * port_ + (c - '0'));
+            if(port_ < u0)
+                port_ovf_ = true;
+        }
+        return true;
+
+    case hp_literal:
+        return literal_char(c);
+
+    case hp_literal_done:
+        if(c != ':')
+            return false;
+        begin_port(pos);
+        return true;
+
+    default:
+        return false;
+    }
+}
+
+void
+url_stream_parser::
+end_authority(std::size_t pos) noexcept
+{
+    BOOST_ASSERT(accepting());
+    switch(hp_)
+    {
+    case hp_host:
+        if( ip4_ == ip4_complete ||
+            ( ip4_ == ip4_running &&
+              ip4_idx_ == 3 &&
+              ip4_digits_ != 0))
+        {
+            ip4_buf_[3] = static_cast<
+                unsigned char>(ip4_val_);
+            std::memcpy(&ip_addr_[0],
+                ip4_buf_, 4);
+            host_type_ =
+                urls::host_type::ipv4;
+        }
+        else
+        {
+            host_type_ =
+                urls::host_type::name;
+            decoded_[id_host] =
+                (pos - host_) - 2 * esc_[0];
+        }
+        offset_[id_port] = pos;
+        break;
+
+    case hp_port:
+        offset_[id_port] = colon_;
+        if( pos - colon_ > 1 &&
+            ! port_ovf_)
+            port_number_ = port_;
+        break;
+
+    default:
+        BOOST_ASSERT(
+            hp_ == hp_literal_done);
+        offset_[id_port] = pos;
+        break;
+    }
+    if(! has_userinfo_)
+    {
+        offset_[id_pass] = auth_;
+        offset_[id_host] = auth_;
+    }
+    offset_[id_path] = pos;
+    has_auth_ = true;
+    user_ok_ = false;
+    hp_ = hp_dead;
+}
+
+void
+url_stream_parser::
+end_url(std::size_t pos) noexcept
+{
+    switch(st_)
+    {
+    case st_scheme:
+        // the scheme was the path
+        add_path(scheme_buf_,
+            scheme_buf_ + (std::min)(
+                scheme_n_, static_cast<
+                    unsigned char>(3)));
+        nseg_ = 1;
+        break;
+
+    case st_slash:
+        add_path("/", "/" + 1);
+        nseg_ = 1;
+        break;
+
+    case st_auth:
+        end_authority(pos);
+        break;
+
+    default:
+        break;
+    }
+    if(! has_auth_)
+    {
+        offset_[id_pass] = offset_[id_user];
+        offset_[id_host] = offset_[id_user];
+        offset_[id_port] = offset_[id_user];
+        offset_[id_path] = offset_[id_user];
+    }
+    switch(st_)
+    {
+    case st_query:
+        offset_[id_frag] = pos;
+        break;
+
+    case st_frag:
+        decoded_[id_frag] =
+            (pos - offset_[id_frag] - 1) -
+                2 * esc_[0];
+        break;
+
+    default:
+        offset_[id_query] = pos;
+        offset_[id_frag] = pos;
+        break;
+    }
+    offset_[id_end] = pos;
+    nseg_ = detail::path_segments(
+        string_view(path_buf_, path_n_),
+        nseg_);
+}
+
+//------------------------------------------------
+
+std::size_t
+url_stream_parser::
+write_some(
+    char const* const data,
+    std::size_t size,
+    error_code& ec)
+{
+    static constexpr bnf::lut_chars scheme_chars(
+        "0123456789" "+-."
+        "ABCDEFGHIJKLMNOPQRSTUVWXYZ"
+        "abcdefghijklmnopqrstuvwxyz");
+    static constexpr auto user_chars =
+        unreserved_chars + subdelim_chars;
+    static constexpr auto nc_chars =
+        pchars - ':';
+    static constexpr auto path_chars =
+        pchars + '/';
+    static constexpr auto param_chars =
+        query_chars - '&';
+
+    if(st_ == st_error)
+    {
+        ec = ec_;
+        return 0;
+    }
+    ec = {};
+    if(st_ == st_done)
+        return 0;
+
+    auto const base = n_;
+    auto const end = data + size;
+    auto p = data;
+    auto const pos =
+        [base, data](char const* q)
+    {
+        return base + (q - data);
+    };
+
+    while(p != end)
+    {
+        if(pct_ != 0)
+        {
+            // hex digit of an escape
+            if(! bnf::hexdig_chars(*p))
+                return fail(p, data, ec,
+                    error::bad_pct_hexdig);
+            if( st_ == st_noscheme ||
+                st_ == st_rootless ||
+                st_ == st_path)
+                add_path(p, p + 1);
+            ++p;
+            --pct_;
+            continue;
+        }
+
+        switch(st_)
+        {
+        case st_start:
+            if(bnf::alpha_chars(*p))
+            {
+                st_ = st_scheme;
+                continue;
+            }
+            if(*p == '/')
+            {
+                ++p;
+                st_ = st_slash;
+                continue;
+            }
+            if( *p == '?' ||
+                *p == '#')
+            {
+                st_ = st_path;
+                continue;
+            }
+            st_ = st_noscheme;
+            continue;
+
+        case st_scheme:
+        {
+            auto const p0 = p;
+            p = bnf::find_if_not(
+                p, end, scheme_chars);
+            add_scheme(p0, p);
+            if(p == end)
+                break;
+            if(*p == ':')
+            {
+                scheme_ = scheme_n_ <=
+                    sizeof(scheme_buf_) ?
+                    string_to_scheme(string_view(
+                        scheme_buf_, scheme_n_)) :
+                    urls::scheme::unknown;
+                ++p;
+                offset_[id_user] = pos(p);
+                st_ = st_after_scheme;
+                continue;
+            }
+
+            // not a scheme, so it
+            // starts path-noscheme
+            add_path(scheme_buf_,
+                scheme_buf_ + (std::min)(
+                    scheme_n_, static_cast<
+                        unsigned char>(3)));
+            nseg_ = 1;
+            st_ = st_noscheme;
+            continue;
+        }
+
+        case st_noscheme:
+        case st_rootless:
+        {
+            auto const p0 = p;
+            p = bnf::find_if_not(p, end,
+                st_ == st_noscheme ?
+                    nc_chars : pchars);
+            add_path(p0, p);
+            if(p != p0)
+                nseg_ = 1;
+            if(p == end)
+                break;
+            if(*p == '%')
+            {
+                add_path(p, p + 1);
+                ++p;
+                pct_ = 2;
+                nseg_ = 1;
+                continue;
+            }
+            if( *p == '/' ||
+                *p == '?' ||
+                *p == '#')
+            {
+                st_ = st_path;
+                continue;
+            }
+            return stop(p, data, ec);
+        }
+
+        case st_after_scheme:
+            if(*p == '/')
+            {
+                ++p;
+                st_ = st_slash;
+                continue;
+            }
+            if( pchars(*p) ||
+                *p == '%')
+            {
+                st_ = st_rootless;
+                continue;
+            }
+            // path-rootless
+            // can't be empty
+            if( *p == '?' ||
+                *p == '#')
+                return fail(p, data, ec,
+                    error::syntax);
+            return stop(p, data, ec);
+
+        case st_slash:
+            if(*p == '/')
+            {
+                // "//" authority
+                ++p;
+                auth_ = pos(p);
+                user_ok_ = true;
+                begin_host(auth_);
+                st_ = st_auth;
+                continue;
+            }
+            add_path("/", "/" + 1);
+            nseg_ = 1;
+            st_ = st_path;
+            continue;
+
+        case st_auth:
+        {
+            // runs which both the userinfo
+            // and the reg-name accept, or
+            // the userinfo alone
+            if( ( hp_ == hp_host &&
+                  ip4_ == ip4_failed) ||
+                ( hp_ == hp_dead &&
+                  user_ok_))
+            {
+                auto const p0 = p;
+                p = bnf::find_if_not(
+                    p, end, unreserved_chars);
+                if(p != p0)
+                    continue;
+            }
+
+            auto const c = *p;
+            if( c == '/' ||
+                c == '?' ||
+                c == '#')
+            {
+                if(! accepting())
+                    return fail(p, data, ec,
+                        error::syntax);
+                end_authority(pos(p));
+                st_ = st_path;
+                continue;
+            }
+            if( user_ok_ &&
+                c == '@')
+            {
+                auto const at = pos(p);
+                bool const has_pass =
+                    colon_ != std::size_t(-1);
+                offset_[id_pass] =
+                    has_pass ? colon_ : at;
+                offset_[id_host] = at + 1;
+                decoded_[id_user] =
+                    (offset_[id_pass] - auth_) -
+                        2 * esc_[0];
+                decoded_[id_pass] = has_pass ?
+                    (at - colon_ - 1) - 2 * esc_[1] :
+                    0;
+                has_userinfo_ = true;
+                user_ok_ = false;
+                ++p;
+                begin_host(at + 1);
+                continue;
+            }
+
+            bool used = false;
+            if(user_ok_)
+            {
+                if(c == ':')
+                {
+                    if(colon_ == std::size_t(-1))
+                        colon_ = pos(p);
+                    used = true;
+                }
+                else if(
+                    c == '%' ||
+                    user_chars(c))
+                {
+                    used = true;
+                }
+                else
+                {
+                    user_ok_ = false;
+                }
+            }
+            if(host_char(c, pos(p)))
+            {
+                used = true;
+            }
+            else if(used)
+            {
+                // only the userinfo
+                // is left
+                hp_ = hp_dead;
+            }
+            else
+            {
+                if(! accepting())
+                    return fail(p, data, ec,
+                        error::syntax);
+                return stop(p, data, ec);
+            }
+            if(c == '%')
+            {
+                ++esc_[colon_ !=
+                    std::size_t(-1)];
+                pct_ = 2;
+            }
+            ++p;
+            continue;
+        }
+
+        case st_path:
+        {
+            auto const p0 = p;
+            p = bnf::find_if_not(
+                p, end, path_chars);
+            add_path(p0, p);
+            nseg_ += std::count(p0, p, '/');
+            if(p == end)
+                break;
+            if(*p == '%')
+            {
+                add_path(p, p + 1);
+                ++p;
+                pct_ = 2;
+                continue;
+            }
+            if(*p == '?')
+            {
+                offset_[id_query] = pos(p);
+                ++p;
+                nparam_ = 1;
+                st_ = st_query;
+                continue;
+            }
+            if(*p == '#')
+            {
+                offset_[id_query] = pos(p);
+                offset_[id_frag] = pos(p);
+                ++p;
+                esc_[0] = 0;
+                st_ = st_frag;
+                continue;
+            }
+            return stop(p, data, ec);
+        }
+
+        case st_query:
+            p = bnf::find_if_not(
+                p, end, param_chars);
+            if(p == end)
+                break;
+            if(*p == '&')
+            {
+                ++nparam_;
+                ++p;
+                continue;
+            }
+            if(*p == '%')
+            {
+                ++p;
+                pct_ = 2;
+                continue;
+            }
+            if(*p == '#')
+            {
+                offset_[id_frag] = pos(p);
+                ++p;
+                esc_[0] = 0;
+                st_ = st_frag;
+                continue;
+            }
+            return stop(p, data, ec);
+
+        case st_frag:
+            p = bnf::find_if_not(
+                p, end, fragment_chars);
+            if(p == end)
+                break;
+            if(*p == '%')
+            {
+                ++esc_[0];
+                ++p;
+                pct_ = 2;
+                continue;
+            }
+            return stop(p, data, ec);
+
+        default:
+            BOOST_ASSERT(false);
+            break;
+        }
+    }
+    n_ += size;
+    if(n_ > url_view::max_size())
+        detail::throw_length_error(
+            "url_view::max_size exceeded",
+            BOOST_CURRENT_LOCATION);
+    return size;
+}
+
+std::size_t
+url_stream_parser::
+write(
+    char const* data,
+    std::size_t size,
+    error_code& ec)
+{
+    auto const n =
+        write_some(data, size, ec);
+    if( ! ec &&
+        n < size)
+    {
+        ec_ = BOOST_URL_ERR(
+            error::leftover_input);
+        ec = ec_;
+        st_ = st_error;
+    }
+    return n;
+}
+
+void
+url_stream_parser::
+finish(error_code& ec) noexcept
+{
+    if(st_ == st_error)
+    {
+        ec = ec_;
+        return;
+    }
+    ec = {};
+    if(st_ == st_done)
+        return;
+    if(! accepting())
+    {
+        if(pct_ != 0)
+            ec_ = BOOST_URL_ERR(
+                error::incomplete_pct_encoding);
+        else
+            ec_ = BOOST_URL_ERR(
+                error::incomplete);
+        ec = ec_;
+        st_ = st_error;
+        return;
+    }
+    end_url(n_);
+    st_ = st_done;
+}
+
+std::size_t
+url_stream_parser::
+offset(part p) const noexcept
+{
+    BOOST_ASSERT(done());
+    switch(p)
+    {
+    case part::scheme:
+        return 0;
+    case part::user:
+        return has_authority() ?
+            offset_[id_user] + 2 :
+            offset_[id_user];
+    case part::password:
+        return offset_[id_host] -
+            offset_[id_pass] > 1 ?
+                offset_[id_pass] + 1 :
+                offset_[id_pass];
+    case part::host:
+        return offset_[id_host];
+    case part::port:
+        return has_port() ?
+            offset_[id_port] + 1 :
+            offset_[id_port];
+    case part::path:
+        return offset_[id_path];
+    case part::query:
+        return has_query() ?
+            offset_[id_query] + 1 :
+            offset_[id_query];
+    default:
+    case part::fragment:
+        return has_fragment() ?
+            offset_[id_frag] + 1 :
+            offset_[id_frag];
+    }
+}
+
+std::size_t
+url_stream_parser::
+length(part p) const noexcept
+{
+    BOOST_ASSERT(done());
+    switch(p)
+    {
+    case part::scheme:
+        return has_scheme() ?
+            offset_[id_user] - 1 : 0;
+    case part::user:
+        return offset_[id_pass] -
+            offset(p);
+    case part::password:
+        return offset_[id_host] -
+            offset_[id_pass] > 1 ?
+                offset_[id_host] -
+                    offset_[id_pass] - 2 :
+                0;
+    case part::host:
+        return offset_[id_port] -
+            offset_[id_host];
+    case part::port:
+        return offset_[id_path] -
+            offset(p);
+    case part::path:
+        return offset_[id_query] -
+            offset_[id_path];
+    case part::query:
+        return offset_[id_frag] -
+            offset(p);
+    default:
+    case part::fragment:
+        return offset_[id_end] -
+            offset(p);
+    }
+}
+
+url_view
+url_stream_parser::
+view(string_view s) const noexcept
+{
+    BOOST_ASSERT(done());
+    BOOST_ASSERT(s.size() == n_);
+    url_view u(0, s.data());
+    std::copy(
+        std::begin(offset_),
+        std::end(offset_),
+        std::begin(u.offset_));
+    std::copy(
+        std::begin(decoded_),
+        std::end(decoded_),
+        std::begin(u.decoded_));
+    u.nseg_ = nseg_;
+    u.nparam_ = nparam_;
+    std::memcpy(u.ip_addr_,
+        ip_addr_, sizeof(ip_addr_));
+    u.port_number_ = port_number_;
+    u.host_type_ = host_type_;
+    u.scheme_ = scheme_;
+    return u;
+}
+
+} // urls
+} // boost
+
+#endif
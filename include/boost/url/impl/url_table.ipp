@@ -0,0 +1,486 @@
+//
+// Copyright (c) 2019 Vinnie Falco (vinnie.falco@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/CPPAlliance/url
+//
+
+#ifndef BOOST_URL_IMPL_URL_TABLE_IPP
+#define BOOST_URL_IMPL_URL_TABLE_IPP
+
+#include <boost/url/url_table.hpp>
+#include <boost/url/detail/except.hpp>
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <limits>
+#include <memory>
+#include <system_error>
+#include <thread>
+
+namespace boost {
+namespace urls {
+
+namespace detail {
+
+// The chunks [first, last) left to one
+// thread, packed into one word. The
+// owner pops from the front and other
+// threads steal from the back.
+class chunk_range
+{
+    std::atomic<std::uint64_t> v_{0};
+
+    static
+    std::uint64_t
+    pack(
+        std::uint32_t first,
+        std::uint32_t last) noexcept
+    {
+        return (static_cast<
+            std::uint64_t>(first) << 32) | last;
+    }
+
+public:
+    void
+    assign(
+        std::uint32_t first,
+        std::uint32_t last) noexcept
+    {
+        v_.store(pack(first, last));
+    }
+
+    std::uint32_t
+    size() const noexcept
+    {
+        auto const v = v_.load(
+            std::memory_order_relaxed);
+        auto const first =
+            static_cast<std::uint32_t>(v >> 32);
+        auto const last =
+            static_cast<std::uint32_t>(v);
+        return first < last ?
+            last - first : 0;
+    }
+
+    bool
+    pop(std::uint32_t& c) noexcept
+    {
+        auto v = v_.load();
+        for(;;)
+        {
+            auto const first =
+                static_cast<std::uint32_t>(v >> 32);
+            auto const last =
+                static_cast<std::uint32_t>(v);
+            if(first >= last)
+                return false;
+            if(v_.compare_exchange_weak(
+                    v, pack(first + 1, last)))
+            {
+                c = first;
+                return true;
+            }
+        }
+    }
+
+    // Take the back half, leaving the
+    // owner at least one chunk, so a
+    // range is never emptied by a thief
+    bool
+    steal(
+        std::uint32_t& first,
+        std::uint32_t& last) noexcept
+    {
+        auto v = v_.load();
+        for(;;)
+        {
+            auto const f =
+                static_cast<std::uint32_t>(v >> 32);
+            auto const l =
+                static_cast<std::uint32_t>(v);
+            if( f >= l ||
+                l - f < 2)
+                return false;
+            auto const m = l - (l - f) / 2;
+            if(v_.compare_exchange_weak(
+                    v, pack(f, m)))
+            {
+                first = m;
+                last = l;
+                return true;
+            }
+        }
+    }
+};
+
+// Call f(k, c) for every chunk c in
+// [0, n), where k is the thread doing
+// the work. Thread 0 is the caller.
+// Returns the number of threads used.
+template<class F>
+std::size_t
+for_each_chunk(
+    std::size_t threads,
+    std::uint32_t n,
+    std::vector<parse_lines_stats>& stats,
+    F const& f)
+{
+    using clock_type =
+        std::chrono::steady_clock;
+
+    stats.assign(threads, {});
+    std::unique_ptr<chunk_range[]> ranges(
+        new chunk_range[threads]);
+    for(std::size_t k = 0; k < threads; ++k)
+        ranges[k].assign(
+            static_cast<std::uint32_t>(
+                n * k / threads),
+            static_cast<std::uint32_t>(
+                n * (k + 1) / threads));
+
+    auto const work =
+        [&](std::size_t k) noexcept
+    {
+        auto const t0 = clock_type::now();
+        auto& st = stats[k];
+        std::uint32_t c;
+        for(;;)
+        {
+            while(ranges[k].pop(c))
+            {
+                f(k, c);
+                ++st.chunks;
+            }
+
+            // steal from the
+            // thread with the most
+            std::size_t victim = k;
+            std::uint32_t most = 1;
+            for(std::size_t j = 0;
+                j < threads; ++j)
+            {
+                auto const m = ranges[j].size();
+                if(m > most)
+                {
+                    most = m;
+                    victim = j;
+                }
+            }
+            if(victim == k)
+                break;
+            std::uint32_t first;
+            std::uint32_t last;
+            if(ranges[victim].steal(
+                    first, last))
+            {
+                ranges[k].assign(first, last);
+                ++st.steals;
+            }
+        }
+        st.elapsed = clock_type::now() - t0;
+    };
+
+    std::vector<std::thread> pool;
+    pool.reserve(threads - 1);
+    try
+    {
+        for(std::size_t k = 1;
+            k < threads; ++k)
+            pool.emplace_back(work, k);
+    }
+    catch(std::system_error const&)
+    {
+    }
+    work(0);
+
+    // the chunks of threads
+    // which did not start
+    std::uint32_t c;
+    for(std::size_t k = pool.size() + 1;
+        k < threads; ++k)
+    {
+        while(ranges[k].pop(c))
+        {
+            f(0, c);
+            ++stats[0].chunks;
+        }
+    }
+    for(auto& t : pool)
+        t.join();
+    stats.resize(pool.size() + 1);
+    return stats.size();
+}
+
+} // detail
+
+//------------------------------------------------
+
+void
+url_table::
+clear() noexcept
+{
+    s_.clear();
+    ec_.clear();
+    scheme_.clear();
+    host_type_.clear();
+    port_number_.clear();
+    nseg_.clear();
+    nparam_.clear();
+    for(auto& v : offset_)
+        v.clear();
+}
+
+void
+url_table::
+reserve(std::size_t n)
+{
+    s_.reserve(n);
+    ec_.reserve(n);
+    scheme_.reserve(n);
+    host_type_.reserve(n);
+    port_number_.reserve(n);
+    nseg_.reserve(n);
+    nparam_.reserve(n);
+    for(auto& v : offset_)
+        v.reserve(n);
+}
+
+url_view
+url_table::
+view(std::size_t i) const noexcept
+{
+    BOOST_ASSERT(! ec_[i]);
+    url_view u(0, s_[i].data());
+    if(! u.parse_reference(s_[i]))
+        return {};
+    return u;
+}
+
+void
+url_table::
+resize(std::size_t n)
+{
+    s_.resize(n);
+    ec_.resize(n);
+    scheme_.resize(n);
+    host_type_.resize(n);
+    port_number_.resize(n);
+    nseg_.resize(n);
+    nparam_.resize(n);
+    for(auto& v : offset_)
+        v.resize(n);
+}
+
+// Parse the strings of the rows [first, last)
+// into the other columns. Different ranges
+// may be parsed by different threads.
+std::size_t
+url_table::
+parse_rows(
+    std::size_t first,
+    std::size_t last) noexcept
+{
+    // the stores below could alias
+    // the vectors, so keep the
+    // columns in locals
+    auto const s = s_.data();
+    auto const ec = ec_.data();
+    auto const scheme = scheme_.data();
+    auto const host_type = host_type_.data();
+    auto const port_number = port_number_.data();
+    auto const nseg = nseg_.data();
+    auto const nparam = nparam_.data();
+    pos32_t* offset[id_end + 1];
+    for(int k = 0; k <= id_end; ++k)
+        offset[k] = offset_[k].data();
+
+    std::size_t nvalid = 0;
+    for(auto i = first; i < last; ++i)
+    {
+        url_view u(0, s[i].data());
+        if(u.parse_reference(s[i]))
+        {
+            ec[i] = {};
+            scheme[i] = u.scheme_;
+            host_type[i] = u.host_type_;
+            port_number[i] = u.port_number_;
+            nseg[i] = static_cast<
+                pos32_t>(u.nseg_);
+            nparam[i] = static_cast<
+                pos32_t>(u.nparam_);
+            for(int k = 0; k <= id_end; ++k)
+                offset[k][i] = static_cast<
+                    pos32_t>(u.offset_[k]);
+            ++nvalid;
+            continue;
+        }
+
+        // the grammar reports the error
+        ec[i] = parse_uri_reference(
+            s[i]).error();
+        scheme[i] = urls::scheme::none;
+        host_type[i] = urls::host_type::none;
+        port_number[i] = 0;
+        nseg[i] = 0;
+        nparam[i] = 0;
+        for(int k = 0; k <= id_end; ++k)
+            offset[k][i] = 0;
+    }
+    return nvalid;
+}
+
+//------------------------------------------------
+
+std::size_t
+parse_uri_reference(
+    string_view const* v,
+    std::size_t n,
+    url_table& t)
+{
+    for(std::size_t i = 0; i < n; ++i)
+        if(v[i].size() > url_view::max_size())
+            detail::throw_length_error(
+                "url_view::max_size exceeded",
+                BOOST_CURRENT_LOCATION);
+
+    // every column has n elements,
+    // then each row is written once
+    t.resize(n);
+    std::copy(v, v + n, t.s_.begin());
+    return t.parse_rows(0, n);
+}
+
+std::size_t
+parse_uri_reference_lines(
+    string_view s,
+    url_table& t,
+    parse_lines_opts const& opt,
+    std::vector<parse_lines_stats>* stats)
+{
+    std::size_t threads = opt.threads;
+    if(threads == 0)
+        threads = std::thread::
+            hardware_concurrency();
+    if(threads == 0)
+        threads = 1;
+    auto const chunk_size = (std::max)(
+        opt.chunk_size, std::size_t(1));
+    auto const nc = (std::max)(
+        (s.size() + chunk_size - 1) /
+            chunk_size, std::size_t(1));
+    if(nc >= (std::numeric_limits<
+            std::uint32_t>::max)())
+        detail::throw_length_error(
+            "too many chunks",
+            BOOST_CURRENT_LOCATION);
+    threads = (std::min)(threads, nc);
+
+    // each chunk starts after an LF,
+    // so lines are not split
+    std::vector<std::size_t> pos(nc + 1);
+    pos[0] = 0;
+    pos[nc] = s.size();
+    for(std::size_t c = 1; c < nc; ++c)
+    {
+        auto const p = c * chunk_size;
+        if(p <= pos[c - 1])
+        {
+            pos[c] = pos[c - 1];
+            continue;
+        }
+        auto const q = static_cast<
+            char const*>(std::memchr(
+                s.data() + p - 1, '\n',
+                s.size() - p + 1));
+        pos[c] = q ?
+            q - s.data() + 1 : s.size();
+    }
+
+    // count the lines in each chunk,
+    // then each chunk knows its rows
+    std::vector<std::size_t> row(nc + 1);
+    std::vector<std::size_t> longest(nc);
+    std::vector<parse_lines_stats> st;
+    detail::for_each_chunk(threads,
+        static_cast<std::uint32_t>(nc), st,
+        [&](std::size_t, std::uint32_t c)
+        {
+            auto p = s.data() + pos[c];
+            auto const end =
+                s.data() + pos[c + 1];
+            std::size_t n = 0;
+            std::size_t m = 0;
+            while(p != end)
+            {
+                auto q = static_cast<
+                    char const*>(std::memchr(
+                        p, '\n', end - p));
+                if(! q)
+                    q = end;
+                m = (std::max)(m,
+                    static_cast<std::size_t>(
+                        q - p));
+                ++n;
+                p = q == end ? end : q + 1;
+            }
+            row[c + 1] = n;
+            longest[c] = m;
+        });
+    for(std::size_t c = 0; c < nc; ++c)
+    {
+        if(longest[c] > url_view::max_size())
+            detail::throw_length_error(
+                "url_view::max_size exceeded",
+                BOOST_CURRENT_LOCATION);
+        row[c + 1] += row[c];
+    }
+
+    // parse each chunk into its rows
+    t.resize(row[nc]);
+    std::vector<std::size_t> nvalid(threads);
+    threads = detail::for_each_chunk(threads,
+        static_cast<std::uint32_t>(nc), st,
+        [&](std::size_t k, std::uint32_t c)
+        {
+            auto p = s.data() + pos[c];
+            auto const end =
+                s.data() + pos[c + 1];
+            auto i = row[c];
+            while(p != end)
+            {
+                auto q = static_cast<
+                    char const*>(std::memchr(
+                        p, '\n', end - p));
+                if(! q)
+                    q = end;
+                auto e = q;
+                if( q != end &&
+                    e != p &&
+                    e[-1] == '\r')
+                    --e;
+                t.s_[i++] = string_view(
+                    p, e - p);
+                p = q == end ? end : q + 1;
+            }
+            BOOST_ASSERT(i == row[c + 1]);
+            nvalid[k] += t.parse_rows(
+                row[c], row[c + 1]);
+            st[k].lines += row[c + 1] - row[c];
+            st[k].bytes += pos[c + 1] - pos[c];
+        });
+
+    std::size_t n = 0;
+    for(std::size_t k = 0; k < threads; ++k)
+        n += nvalid[k];
+    if(stats)
+        *stats = std::move(st);
+    return n;
+}
+
+} // urls
+} // boost
+
+#endif
@@ -32,12 +32,14 @@ std::size_t
 url_view::
 table_bytes() const noexcept
 {
-    std::size_t n = 0;
-    if(nseg_ > 1)
-        n += nseg_ - 1;
-    if(nparam_ > 1)
-        n += nparam_ - 1;
-    return n * sizeof(pos_t);
+    // the path and query
+    // tables are interleaved
+    std::size_t const n =
+        nseg_ > nparam_ ?
+            nseg_ : nparam_;
+    if(n < 2)
+        return 0;
+    return 2 * (n - 1) * sizeof(pos_t);
 }
 
 // return length of [first, last)
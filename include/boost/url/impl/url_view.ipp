@@ -12,18 +12,27 @@
 
 #include <boost/url/url_view.hpp>
 #include <boost/url/error.hpp>
+#include <boost/url/parse_stats.hpp>
+#include <boost/url/detail/http_dfa.hpp>
 #include <boost/url/detail/over_allocator.hpp>
 #include <boost/url/bnf/parse.hpp>
 #include <boost/url/rfc/authority_bnf.hpp>
 #include <boost/url/rfc/fragment_bnf.hpp>
 #include <boost/url/rfc/host_bnf.hpp>
+#include <boost/url/rfc/ip_literal_bnf.hpp>
 #include <boost/url/rfc/paths_bnf.hpp>
+#include <boost/url/rfc/port_bnf.hpp>
 #include <boost/url/rfc/pct_encoded_bnf.hpp>
 #include <boost/url/rfc/query_bnf.hpp>
+#include <boost/url/rfc/reg_name_bnf.hpp>
+#include <boost/url/rfc/detail/char_table.hpp>
 #include <boost/url/rfc/relative_ref_bnf.hpp>
 #include <boost/url/rfc/scheme_bnf.hpp>
 #include <boost/url/rfc/uri_bnf.hpp>
+#include <boost/url/rfc/uri_reference_bnf.hpp>
+#include <algorithm>
 #include <array>
+#include <cstring>
 #include <ostream>
 
 namespace boost {
@@ -616,6 +625,503 @@ apply(
     }
 }
 
+//------------------------------------------------
+
+namespace detail {
+
+// Advance it past the chars in cs and
+// the escapes, adding the decoded size
+// to n. Returns false on a bad escape.
+template<class CharSet>
+bool
+skip_pct_encoded(
+    char const*& it,
+    char const* const end,
+    CharSet const& cs,
+    std::size_t& n) noexcept
+{
+    for(;;)
+    {
+        auto const it0 = it;
+        it = bnf::find_if_not(
+            it0, end, cs);
+        n += it - it0;
+        if( it == end ||
+            *it != '%')
+            return true;
+        do
+        {
+            if( end - it < 3 ||
+                ! detail::is_hexdig2(
+                    it[1], it[2]))
+                return false;
+            it += 3;
+            ++n;
+        }
+        while(
+            it != end &&
+            *it == '%');
+    }
+}
+
+/*  Return the number of c in [first, last),
+    eight chars at a time. The bytes equal
+    to c are the zero bytes of the word
+    xor c, which are found without carries
+    between the bytes.
+*/
+inline
+std::size_t
+count_char(
+    char const* first,
+    char const* last,
+    char c) noexcept
+{
+    constexpr std::uint64_t ones =
+        0x0101010101010101;
+    constexpr std::uint64_t low7 =
+        0x7f7f7f7f7f7f7f7f;
+    auto const cs = ones *
+        static_cast<unsigned char>(c);
+    std::size_t n = 0;
+    while(last - first >= 8)
+    {
+        std::uint64_t w;
+        std::memcpy(&w, first, 8);
+        w ^= cs;
+        auto const t =
+            ((w & low7) + low7) | w;
+        n += static_cast<std::size_t>(
+            (((~t >> 7) & ones) * ones) >> 56);
+        first += 8;
+    }
+    while(first != last)
+        n += *first++ == c;
+    return n;
+}
+
+} // detail
+
+/*  Parse the common http and https URLs
+    with a DFA, stepping only on the chars
+    which may change the state.
+    Returns false, having changed nothing,
+    for the other strings, or the ones the
+    DFA does not handle, which are given
+    to the general parser.
+*/
+bool
+url_view::
+parse_http(
+    string_view s) noexcept
+{
+    namespace dfa = detail::http_dfa;
+
+    std::size_t p;
+    urls::scheme id;
+    if( s.size() >= 7 &&
+        std::memcmp(
+            s.data(), "http://", 7) == 0)
+    {
+        p = 7;
+        id = urls::scheme::http;
+    }
+    else if(
+        s.size() >= 8 &&
+        std::memcmp(
+            s.data(), "https://", 8) == 0)
+    {
+        p = 8;
+        id = urls::scheme::https;
+    }
+    else
+    {
+        return false;
+    }
+
+    // end[st] is one past the last char
+    // in state st. The runs of chars and
+    // escapes which stay in the part are
+    // skipped with the vectorized find,
+    // and the table gives the state after
+    // each run.
+    auto const start = s.data();
+    auto const last = start + s.size();
+    auto it = start + p;
+    std::size_t end[dfa::st_count] = {};
+    std::size_t nslash = 0;
+    std::size_t namp = 0;
+    std::size_t nfrag = 0;
+    std::size_t nd = 0;
+    unsigned char st = dfa::st_host0;
+    for(;;)
+    {
+        auto const it0 = it;
+        switch(st)
+        {
+        case dfa::st_host:
+            it = bnf::find_if_not(
+                it, last,
+                detail::reg_name_chars);
+            break;
+
+        case dfa::st_port:
+            it = bnf::find_if_not(
+                it, last, bnf::digit_chars);
+            break;
+
+        case dfa::st_slash:
+        case dfa::st_path:
+            if(! detail::skip_pct_encoded(
+                    it, last,
+                    detail::path_chars, nd))
+                return false;
+            nslash += detail::count_char(
+                it0, it, '/');
+            break;
+
+        case dfa::st_query0:
+        case dfa::st_amp:
+        case dfa::st_query:
+            if(! detail::skip_pct_encoded(
+                    it, last,
+                    detail::query_chars, nd))
+                return false;
+            namp += detail::count_char(
+                it0, it, '&');
+            break;
+
+        case dfa::st_frag0:
+        case dfa::st_frag:
+            if(! detail::skip_pct_encoded(
+                    it, last,
+                    detail::fragment_chars,
+                    nfrag))
+                return false;
+            break;
+
+        default:
+            break;
+        }
+        end[st] = it - start;
+        if(it == last)
+            break;
+        st = dfa::tab.next[
+            st * dfa::cc_count +
+            dfa::tab.cls[static_cast<
+                unsigned char>(*it)]];
+        if(st == dfa::st_bail)
+            return false;
+        ++it;
+        nslash += st == dfa::st_slash;
+        namp += st == dfa::st_amp;
+    }
+    if(! dfa::is_final(st))
+        return false;
+
+    // the parts are in order, and
+    // each ends where the last char
+    // in one of its states is
+    auto const n = s.size();
+    auto const host_end =
+        (std::max)(p, end[dfa::st_host]);
+    auto const port_end =
+        (std::max)(host_end, end[dfa::st_port]);
+    auto const path_end = (std::max)({
+        port_end,
+        end[dfa::st_slash],
+        end[dfa::st_path] });
+    auto const query_end = (std::max)({
+        path_end,
+        end[dfa::st_query0],
+        end[dfa::st_amp],
+        end[dfa::st_query] });
+
+    scheme_ = id;
+    host_type_ = urls::host_type::name;
+    offset_[id_user] = p - 2;
+    offset_[id_pass] = p;
+    offset_[id_host] = p;
+    offset_[id_port] = host_end;
+    offset_[id_path] = port_end;
+    offset_[id_query] = path_end;
+    offset_[id_frag] = query_end;
+    offset_[id_end] = n;
+    decoded_[id_host] = host_end - p;
+
+    // as port_bnf
+    if(port_end - host_end > 1)
+    {
+        std::uint16_t u = 0;
+        auto i = host_end + 1;
+        for(; i < port_end; ++i)
+        {
+            auto const u0 = u;
+            u = static_cast<
+                std::uint16_t>(10 * u +
+                    start[i] - '0');
+            if(u < u0)
+                break;
+        }
+        if(i == port_end)
+            port_number_ = u;
+    }
+
+    nseg_ = detail::path_segments(
+        get(id_path), nslash);
+    if(query_end != path_end)
+        nparam_ = 1 + namp;
+    if(n != query_end)
+        decoded_[id_frag] = nfrag;
+    return true;
+}
+
+/*  Parse a URI-reference in one pass,
+    writing each part as it is found.
+
+    The result is the same as applying
+    uri_reference_bnf, including where
+    the grammar is stricter than rfc3986.
+    Input rejected here is rejected by the
+    grammar too, which is only used to
+    report the error.
+*/
+bool
+url_view::
+parse_reference(
+    string_view s) noexcept
+{
+    if(parse_http(s))
+    {
+#ifdef BOOST_URL_PARSE_STATS
+        detail::count_parse(true);
+#endif
+        return true;
+    }
+#ifdef BOOST_URL_PARSE_STATS
+    detail::count_parse(false);
+#endif
+
+    auto const start = s.data();
+    auto const end = start + s.size();
+    auto it = start;
+    // decoded_ has no size for the path
+    // or query, as in parse_http and the
+    // grammar, so their count is dropped
+    std::size_t discard = 0;
+
+    // [ scheme ":" ]
+    if( it != end &&
+        bnf::alpha_chars(*it))
+    {
+        auto const p = bnf::find_if_not(
+            it + 1, end, detail::scheme_chars);
+        if( p != end &&
+            *p == ':')
+        {
+            scheme_ = string_to_scheme(
+                string_view(it, p - it));
+            it = p + 1;
+        }
+    }
+    bool const has_scheme = it != start;
+    offset_[id_user] = it - start;
+
+    std::size_t nseg = 0;
+    if( end - it >= 2 &&
+        it[0] == '/' &&
+        it[1] == '/')
+    {
+        // "//" authority
+        it += 2;
+        auto const auth = it;
+
+        // [ userinfo "@" ]
+        std::size_t nuser = 0;
+        std::size_t npass = 0;
+        if(! detail::skip_pct_encoded(
+                it, end, detail::user_chars, nuser))
+            return false;
+        auto const user_end = it;
+        if( it != end &&
+            *it == ':')
+        {
+            ++it;
+            if(! detail::skip_pct_encoded(
+                    it, end, detail::pass_chars, npass))
+                return false;
+        }
+        if( it != end &&
+            *it == '@')
+        {
+            decoded_[id_user] = nuser;
+            decoded_[id_pass] = npass;
+            offset_[id_pass] = user_end - start;
+            ++it;
+        }
+        else
+        {
+            it = auth;
+            offset_[id_pass] = it - start;
+        }
+        offset_[id_host] = it - start;
+
+        // host
+        error_code ec;
+        urls::ipv4_address v4;
+        if(it == end)
+        {
+            host_type_ =
+                urls::host_type::name;
+        }
+        else if(*it == '[')
+        {
+            ip_literal_bnf t;
+            if(! parse(it, end, ec, t))
+                return false;
+            if(t.is_ipv6)
+            {
+                host_type_ =
+                    urls::host_type::ipv6;
+                auto const bytes =
+                    t.ipv6.to_bytes();
+                std::memcpy(
+                    &ip_addr_[0],
+                    bytes.data(), 16);
+            }
+            else
+            {
+                host_type_ =
+                    urls::host_type::ipvfuture;
+            }
+        }
+        else if(
+            bnf::digit_chars(*it) &&
+            parse(it, end, ec, v4))
+        {
+            host_type_ =
+                urls::host_type::ipv4;
+            auto const bytes =
+                v4.to_bytes();
+            std::memcpy(
+                &ip_addr_[0],
+                bytes.data(), 4);
+        }
+        else
+        {
+            it = start + offset_[id_host];
+            std::size_t nhost = 0;
+            if(! detail::skip_pct_encoded(
+                    it, end,
+                    detail::reg_name_chars,
+                    nhost))
+                return false;
+            host_type_ =
+                urls::host_type::name;
+            decoded_[id_host] = nhost;
+        }
+        offset_[id_port] = it - start;
+
+        // [ ":" port ]
+        if( it != end &&
+            *it == ':')
+        {
+            ++it;
+            port_bnf t;
+            parse(it, end, ec, t);
+            if(t.has_number)
+                port_number_ = t.number;
+        }
+        offset_[id_path] = it - start;
+    }
+    else
+    {
+        offset_[id_pass] = it - start;
+        offset_[id_host] = it - start;
+        offset_[id_port] = it - start;
+        offset_[id_path] = it - start;
+        if( it != end &&
+            *it != '/')
+        {
+            auto const it0 = it;
+            if(has_scheme)
+            {
+                // path-rootless
+                if(! detail::skip_pct_encoded(
+                        it, end,
+                        detail::segment_chars,
+                        discard))
+                    return false;
+                if(it == it0)
+                    return false;
+            }
+            else
+            {
+                // path-noscheme, or
+                // path-empty if it fails
+                if(! detail::skip_pct_encoded(
+                        it, end, detail::nc_chars, discard))
+                    return false;
+            }
+            if(it != it0)
+                nseg = 1;
+        }
+    }
+
+    // *( "/" segment )
+    if( it != end &&
+        *it == '/')
+    {
+        auto const it0 = it;
+        if(! detail::skip_pct_encoded(
+                it, end, detail::path_chars, discard))
+            return false;
+        nseg += std::count(it0, it, '/');
+    }
+    offset_[id_query] = it - start;
+    nseg_ = detail::path_segments(
+        get(id_path), nseg);
+
+    // [ "?" query ]
+    if( it != end &&
+        *it == '?')
+    {
+        ++it;
+        std::size_t nparam = 1;
+        if(! detail::skip_pct_encoded(
+                it, end, detail::value_chars, discard))
+            return false;
+        while(
+            it != end &&
+            *it == '&')
+        {
+            ++it;
+            ++nparam;
+            if(! detail::skip_pct_encoded(
+                    it, end, detail::value_chars, discard))
+                return false;
+        }
+        nparam_ = nparam;
+    }
+    offset_[id_frag] = it - start;
+
+    // [ "#" fragment ]
+    if( it != end &&
+        *it == '#')
+    {
+        ++it;
+        std::size_t nfrag = 0;
+        if(! detail::skip_pct_encoded(
+                it, end, detail::fragment_chars, nfrag))
+            return false;
+        decoded_[id_frag] = nfrag;
+    }
+    if(it != end)
+        return false;
+    offset_[id_end] = it - start;
+    return true;
+}
+
 //------------------------------------------------
 //
 // Parsing
@@ -731,11 +1237,22 @@ parse_uri_reference(
             "url_view::max_size exceeded",
             BOOST_CURRENT_LOCATION);
 
+    {
+        url_view u(0, s.data());
+        if(u.parse_reference(s))
+            return u;
+    }
+
+    // the grammar reports the error
     error_code ec;
     uri_reference_bnf t;
     if(! bnf::parse_string(s, ec, t))
         return ec;
 
+    // parse_reference rejected
+    // input which is valid
+    BOOST_ASSERT(false);
+
     url_view u(0, s.data());
 
     // scheme
@@ -0,0 +1,290 @@
+//
+// Copyright (c) 2019 Vinnie Falco (vinnie.falco@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/CPPAlliance/url
+//
+
+#ifndef BOOST_URL_IMPL_VALIDATE_IPP
+#define BOOST_URL_IMPL_VALIDATE_IPP
+
+#include <boost/url/validate.hpp>
+#include <boost/url/ipv4_address.hpp>
+#include <boost/url/bnf/parse.hpp>
+#include <boost/url/rfc/detail/char_table.hpp>
+#include <boost/url/rfc/ip_literal_bnf.hpp>
+#include <boost/url/rfc/reg_name_bnf.hpp>
+
+namespace boost {
+namespace urls {
+
+namespace detail {
+
+// Set the error for the bad escape
+// at it, and move it to where the
+// error is found
+inline
+bool
+bad_escape(
+    char const*& it,
+    char const* const end,
+    error_code& ec) noexcept
+{
+    for(int i = 1; i < 3; ++i)
+    {
+        if(end - it == i)
+        {
+            it = end;
+            ec = BOOST_URL_ERR(
+                error::incomplete_pct_encoding);
+            return false;
+        }
+        if(! bnf::hexdig_chars(it[i]))
+        {
+            it += i;
+            ec = BOOST_URL_ERR(
+                error::bad_pct_hexdig);
+            return false;
+        }
+    }
+    BOOST_ASSERT(false);
+    return false;
+}
+
+// Advance it past the chars in cs and
+// the escapes. On a bad escape, it is
+// left where the error is found.
+template<class CharSet>
+bool
+validate_pct_encoded(
+    char const*& it,
+    char const* const end,
+    CharSet const& cs,
+    error_code& ec) noexcept
+{
+    for(;;)
+    {
+        it = bnf::find_if_not(
+            it, end, cs);
+        if( it == end ||
+            *it != '%')
+            return true;
+        do
+        {
+            if( end - it < 3 ||
+                ! is_hexdig2(it[1], it[2]))
+                return bad_escape(it, end, ec);
+            it += 3;
+        }
+        while(
+            it != end &&
+            *it == '%');
+    }
+}
+
+/*  Check s in one pass, as
+    url_view::parse_reference does,
+    but without storing anything.
+
+    If scheme_ok, a scheme is allowed,
+    and if relative_ok it may be absent.
+*/
+std::size_t
+validate_reference(
+    string_view s,
+    error_code& ec,
+    bool scheme_ok,
+    bool relative_ok) noexcept
+{
+    auto const start = s.data();
+    auto const end = start + s.size();
+    auto it = start;
+    ec = {};
+
+    // [ scheme ":" ]
+    bool has_scheme = false;
+    if( scheme_ok &&
+        it != end &&
+        bnf::alpha_chars(*it))
+    {
+        auto const p = bnf::find_if_not(
+            it + 1, end, scheme_chars);
+        if( p != end &&
+            *p == ':')
+        {
+            it = p + 1;
+            has_scheme = true;
+        }
+        else if(! relative_ok)
+        {
+            it = p;
+        }
+    }
+    if( ! has_scheme &&
+        ! relative_ok)
+    {
+        ec = BOOST_URL_ERR(error::syntax);
+        return it - start;
+    }
+
+    if( end - it >= 2 &&
+        it[0] == '/' &&
+        it[1] == '/')
+    {
+        // "//" authority
+        it += 2;
+        auto const auth = it;
+
+        // [ userinfo "@" ]
+        if(! validate_pct_encoded(
+                it, end, user_chars, ec))
+            return it - start;
+        if( it != end &&
+            *it == ':')
+        {
+            ++it;
+            if(! validate_pct_encoded(
+                    it, end, pass_chars, ec))
+                return it - start;
+        }
+        if( it != end &&
+            *it == '@')
+            ++it;
+        else
+            it = auth;
+
+        // host
+        if(it == end)
+        {
+        }
+        else if(*it == '[')
+        {
+            ip_literal_bnf t;
+            if(! parse(it, end, ec, t))
+                return it - start;
+        }
+        else
+        {
+            auto p = it;
+            error_code ec0;
+            ipv4_address v4;
+            if( bnf::digit_chars(*it) &&
+                parse(p, end, ec0, v4))
+            {
+                it = p;
+            }
+            else if(! validate_pct_encoded(
+                it, end, reg_name_chars, ec))
+            {
+                return it - start;
+            }
+        }
+
+        // [ ":" port ]
+        if( it != end &&
+            *it == ':')
+            it = bnf::find_if_not(
+                it + 1, end,
+                bnf::digit_chars);
+    }
+    else if(
+        it != end &&
+        *it != '/')
+    {
+        auto const it0 = it;
+        if(has_scheme)
+        {
+            // path-rootless
+            if(! validate_pct_encoded(
+                    it, end, segment_chars, ec))
+                return it - start;
+            if(it == it0)
+            {
+                ec = BOOST_URL_ERR(
+                    error::syntax);
+                return it - start;
+            }
+        }
+        else
+        {
+            // path-noscheme, or
+            // path-empty if it fails
+            if(! validate_pct_encoded(
+                    it, end, nc_chars, ec))
+                return it - start;
+        }
+    }
+
+    // *( "/" segment )
+    if( it != end &&
+        *it == '/')
+    {
+        if(! validate_pct_encoded(
+                it, end, path_chars, ec))
+            return it - start;
+    }
+
+    // [ "?" query ]
+    if( it != end &&
+        *it == '?')
+    {
+        ++it;
+        if(! validate_pct_encoded(
+                it, end, query_chars, ec))
+            return it - start;
+    }
+
+    // [ "#" fragment ]
+    if( it != end &&
+        *it == '#')
+    {
+        ++it;
+        if(! validate_pct_encoded(
+                it, end, fragment_chars, ec))
+            return it - start;
+    }
+
+    if(it != end)
+    {
+        ec = BOOST_URL_ERR(
+            error::leftover_input);
+        return it - start;
+    }
+    return s.size();
+}
+
+} // detail
+
+std::size_t
+validate_uri(
+    string_view s,
+    error_code& ec) noexcept
+{
+    return detail::validate_reference(
+        s, ec, true, false);
+}
+
+std::size_t
+validate_relative_ref(
+    string_view s,
+    error_code& ec) noexcept
+{
+    return detail::validate_reference(
+        s, ec, false, true);
+}
+
+std::size_t
+validate_uri_reference(
+    string_view s,
+    error_code& ec) noexcept
+{
+    return detail::validate_reference(
+        s, ec, true, true);
+}
+
+} // urls
+} // boost
+
+#endif
@@ -0,0 +1,371 @@
+//
+// Copyright (c) 2019 Vinnie Falco (vinnie.falco@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/CPPAlliance/url
+//
+
+#ifndef BOOST_URL_LAZY_URL_VIEW_HPP
+#define BOOST_URL_LAZY_URL_VIEW_HPP
+
+#include <boost/url/detail/config.hpp>
+#include <boost/url/error.hpp>
+#include <boost/url/scheme.hpp>
+#include <boost/url/string.hpp>
+#include <boost/url/url_view.hpp>
+#include <boost/url/detail/parts_base.hpp>
+#include <cstddef>
+#include <cstdint>
+
+namespace boost {
+namespace urls {
+
+/** A view to a URL which is validated on demand
+
+    Objects of this type split a string into
+    the parts of a <em>URI-reference</em>
+    by finding the delimiters which separate
+    them, and nothing else. The characters of
+    the parts are not checked, and counts such
+    as the number of path segments are only
+    computed by the functions which return
+    them. This costs far less than
+    @ref parse_uri_reference for code which
+    looks at a few parts, such as routing on
+    the scheme and host.
+
+    @par Errors
+    Construction never fails. For a valid
+    string, each part is the same as the one
+    returned by @ref url_view. For an invalid
+    string the parts are unspecified, and the
+    error is only reported by @ref validate
+    or @ref view, which parse the whole string.
+    Callers who need the guarantees of
+    @ref url_view should call one of these
+    before trusting the parts.
+
+    @par Example
+    @code
+    lazy_url_view u( "https://www.example.com/path?id=42" );
+    if( u.scheme_id() == scheme::https &&
+        u.encoded_host() == "www.example.com" )
+    {
+        // only now is the whole URL checked
+        result< url_view > r = u.view();
+        if( r.has_value() )
+            route( *r );
+    }
+    @endcode
+
+    @note
+    The string is referenced, not copied.
+    Ownership of the underlying character
+    buffer is not transferred; the caller is
+    responsible for ensuring that its lifetime
+    extends until the view is no longer in use.
+
+    @see
+        @ref parse_uri_reference,
+        @ref url_view.
+*/
+class lazy_url_view
+    : private detail::parts_base
+{
+    char const* cs_ = "";
+    pos_t offset_[id_end + 1] = {};
+
+    string_view
+    get(int first,
+        int last) const noexcept
+    {
+        auto const p0 = first < 0 ?
+            0 : offset_[first];
+        return string_view(cs_ + p0,
+            offset_[last] - p0);
+    }
+
+    std::size_t
+    len(int id) const noexcept
+    {
+        return offset_[id + 1] -
+            (id < 0 ? 0 : offset_[id]);
+    }
+
+public:
+    /** Constructor
+
+        Default constructed views refer
+        to an empty string.
+    */
+    lazy_url_view() = default;
+
+    /** Constructor
+
+        The string is split into its parts,
+        without checking their characters.
+
+        @par Complexity
+        Linear in the size of the scheme and
+        authority, and in the number of
+        characters up to each of the delimiters
+        '?' and '#'.
+
+        @par Exception Safety
+        Throws nothing.
+
+        @param s The string to split.
+    */
+    BOOST_URL_DECL
+    explicit
+    lazy_url_view(string_view s) noexcept;
+
+    /** Return the complete string
+    */
+    string_view
+    string() const noexcept
+    {
+        return string_view(
+            cs_, offset_[id_end]);
+    }
+
+    /** Check the string against the grammar
+
+        The whole string is parsed as a
+        <em>URI-reference</em>, including the
+        percent-encoding of every part.
+
+        @par Exception Safety
+        Throws nothing.
+
+        @return The error, if the string
+        is not valid.
+    */
+    BOOST_URL_DECL
+    error_code
+    validate() const noexcept;
+
+    /** Return a url_view of the string
+
+        The whole string is parsed as a
+        <em>URI-reference</em>, and the view
+        or the error is returned.
+
+        @par Exception Safety
+        Throws nothing.
+    */
+    BOOST_URL_DECL
+    result<url_view>
+    view() const noexcept;
+
+    /** Return true if a scheme is present
+
+        @see @ref url_view::has_scheme.
+    */
+    bool
+    has_scheme() const noexcept
+    {
+        return len(id_scheme) != 0;
+    }
+
+    /** Return the scheme
+
+        @see @ref url_view::scheme.
+    */
+    string_view
+    scheme() const noexcept
+    {
+        auto s = get(id_scheme, id_user);
+        if(! s.empty())
+            s.remove_suffix(1);
+        return s;
+    }
+
+    /** Return a constant representing the scheme
+
+        @see @ref url_view::scheme_id.
+    */
+    BOOST_URL_DECL
+    urls::scheme
+    scheme_id() const noexcept;
+
+    /** Return true if an authority is present
+
+        @see @ref url_view::has_authority.
+    */
+    bool
+    has_authority() const noexcept
+    {
+        return len(id_user) != 0;
+    }
+
+    /** Return the authority
+
+        @see @ref url_view::encoded_authority.
+    */
+    string_view
+    encoded_authority() const noexcept
+    {
+        auto s = get(id_user, id_path);
+        if(! s.empty())
+            s.remove_prefix(2);
+        return s;
+    }
+
+    /** Return true if a userinfo is present
+
+        @see @ref url_view::has_userinfo.
+    */
+    bool
+    has_userinfo() const noexcept
+    {
+        return len(id_pass) != 0;
+    }
+
+    /** Return the userinfo
+
+        @see @ref url_view::encoded_userinfo.
+    */
+    string_view
+    encoded_userinfo() const noexcept
+    {
+        auto s = get(id_user, id_host);
+        if(s.empty())
+            return s;
+        s.remove_prefix(2);
+        if(! s.empty())
+            s.remove_suffix(1);
+        return s;
+    }
+
+    /** Return the host
+
+        @see @ref url_view::encoded_host.
+    */
+    string_view
+    encoded_host() const noexcept
+    {
+        return get(id_host, id_port);
+    }
+
+    /** Return true if a port is present
+
+        @see @ref url_view::has_port.
+    */
+    bool
+    has_port() const noexcept
+    {
+        return len(id_port) != 0;
+    }
+
+    /** Return the port
+
+        @see @ref url_view::port.
+    */
+    string_view
+    port() const noexcept
+    {
+        auto s = get(id_port, id_path);
+        if(! s.empty())
+            s.remove_prefix(1);
+        return s;
+    }
+
+    /** Return the port number
+
+        The port is converted each time this
+        is called. Zero is returned if there
+        is no port, or it is not a number
+        which fits in 16 bits.
+
+        @see @ref url_view::port_number.
+    */
+    BOOST_URL_DECL
+    std::uint16_t
+    port_number() const noexcept;
+
+    /** Return the path
+
+        @see @ref url_view::encoded_path.
+    */
+    string_view
+    encoded_path() const noexcept
+    {
+        return get(id_path, id_query);
+    }
+
+    /** Return the number of path segments
+
+        The path is scanned each time this
+        is called.
+
+        @see @ref url_view::segments.
+    */
+    BOOST_URL_DECL
+    std::size_t
+    segment_count() const noexcept;
+
+    /** Return true if a query is present
+
+        @see @ref url_view::has_query.
+    */
+    bool
+    has_query() const noexcept
+    {
+        return len(id_query) != 0;
+    }
+
+    /** Return the query
+
+        @see @ref url_view::encoded_query.
+    */
+    string_view
+    encoded_query() const noexcept
+    {
+        auto s = get(id_query, id_frag);
+        if(! s.empty())
+            s.remove_prefix(1);
+        return s;
+    }
+
+    /** Return the number of query params
+
+        The query is scanned each time this
+        is called.
+
+        @see @ref url_view::params.
+    */
+    BOOST_URL_DECL
+    std::size_t
+    param_count() const noexcept;
+
+    /** Return true if a fragment is present
+
+        @see @ref url_view::has_fragment.
+    */
+    bool
+    has_fragment() const noexcept
+    {
+        return len(id_frag) != 0;
+    }
+
+    /** Return the fragment
+
+        @see @ref url_view::encoded_fragment.
+    */
+    string_view
+    encoded_fragment() const noexcept
+    {
+        auto s = get(id_frag, id_end);
+        if(! s.empty())
+            s.remove_prefix(1);
+        return s;
+    }
+};
+
+} // urls
+} // boost
+
+#endif
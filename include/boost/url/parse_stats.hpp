@@ -0,0 +1,103 @@
+//
+// Copyright (c) 2019 Vinnie Falco (vinnie.falco@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/CPPAlliance/url
+//
+
+#ifndef BOOST_URL_PARSE_STATS_HPP
+#define BOOST_URL_PARSE_STATS_HPP
+
+#include <boost/url/detail/config.hpp>
+#include <cstdint>
+
+namespace boost {
+namespace urls {
+
+/** Counts of the paths taken by the URI-reference parser
+
+    Strings starting with "http://" or
+    "https://", whose host is a reg-name
+    without userinfo, are parsed by a
+    fast path. All other strings, and
+    strings which the fast path can not
+    finish, go to the general parser.
+    The sum of the two counts is the
+    number of strings parsed by
+    @ref parse_uri_reference, the
+    @ref url_view constructor, and the
+    @ref url_table functions.
+
+    The counts are only kept when the
+    library is built with the macro
+    `BOOST_URL_PARSE_STATS` defined,
+    and are zero otherwise. The counters
+    are shared by all threads.
+
+    @par Example
+    @code
+    reset_parse_stats();
+    for( auto s : requests )
+        handle( parse_uri_reference( s ) );
+    parse_stats st = get_parse_stats();
+    double hit_rate = double( st.fast ) /
+        ( st.fast + st.general );
+    @endcode
+
+    @see
+        @ref get_parse_stats,
+        @ref reset_parse_stats.
+*/
+struct parse_stats
+{
+    /** The number of strings parsed by the fast path
+    */
+    std::uint64_t fast = 0;
+
+    /** The number of strings parsed by the general parser
+    */
+    std::uint64_t general = 0;
+};
+
+/** Return the counts of the paths taken by the parser
+
+    @par Exception Safety
+    Throws nothing.
+
+    @see
+        @ref parse_stats,
+        @ref reset_parse_stats.
+*/
+BOOST_URL_DECL
+parse_stats
+get_parse_stats() noexcept;
+
+/** Set the counts of the paths taken by the parser to zero
+
+    @par Exception Safety
+    Throws nothing.
+
+    @see
+        @ref get_parse_stats,
+        @ref parse_stats.
+*/
+BOOST_URL_DECL
+void
+reset_parse_stats() noexcept;
+
+#ifndef BOOST_URL_DOCS
+namespace detail {
+
+BOOST_URL_DECL
+void
+count_parse(bool fast) noexcept;
+
+} // detail
+#endif
+
+} // urls
+} // boost
+
+#endif
@@ -113,6 +113,22 @@ validate_pct_encoding(
     may be less than the size of the output
     area.
 
+    The input is validated as it is decoded,
+    in a single pass. Since the decoded string
+    is never longer than the input, the output
+    may be written over the input by passing
+    the beginning of the input as `dest`.
+
+    @par Example
+    @code
+    char buf[] = "Program%20Files";
+    error_code ec;
+    std::size_t n = pct_decode( buf, buf + sizeof(buf) - 1,
+        string_view( buf, sizeof(buf) - 1 ), ec, {}, pchars );
+
+    assert( string_view( buf, n ) == "Program Files" );
+    @endcode
+
     @par Exception Safety
     Throws nothing.
 
@@ -131,7 +147,14 @@ validate_pct_encoding(
     @param ec Set to the error, if any
     occurred. If the destination buffer
     is too small to hold the result, `ec`
-    is set to @ref error::no_space.
+    is set to @ref error::no_space, unless
+    the input is also invalid. If the input
+    is invalid, zero is returned, and the
+    contents of the destination buffer are
+    unspecified: since the input is validated
+    as it is decoded, the buffer may hold
+    the output up to the error. No byte
+    at or after `end` is written.
 
     @param opt The options for encoding. If
     this parameter is omitted, the default
@@ -0,0 +1,252 @@
+//
+// Copyright (c) 2019 Vinnie Falco (vinnie.falco@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/CPPAlliance/url
+//
+
+#ifndef BOOST_URL_RESOLVER_HPP
+#define BOOST_URL_RESOLVER_HPP
+
+#include <boost/url/detail/config.hpp>
+#include <boost/url/error.hpp>
+#include <boost/url/string.hpp>
+#include <boost/url/url.hpp>
+#include <boost/url/url_view.hpp>
+
+namespace boost {
+namespace urls {
+
+/** Resolves URL references against one base URL
+
+    Objects of this type resolve any number
+    of references against the same base, as
+    described in rfc3986. The parts of the
+    base used by every resolution, such as
+    the directory which relative paths are
+    merged with, are determined once upon
+    construction.
+
+    The results may be written to @ref url
+    containers, which allocate only when their
+    capacity is insufficient, or packed one
+    after another into a character buffer
+    provided by the caller.
+
+    @par Example
+    @code
+    resolver r( parse_uri( "http://example.com/a/b/index.htm" ).value() );
+
+    url u;
+    r.resolve( parse_relative_ref( "../c/d.htm" ).value(), u );
+
+    assert( u.string() == "http://example.com/a/c/d.htm" );
+    @endcode
+
+    @note
+    The base URL is referenced, not copied.
+    Ownership of the underlying character
+    buffer is not transferred; the caller
+    is responsible for ensuring that the
+    lifetime of the buffer extends until
+    the resolver is destroyed.
+
+    @par Specification
+    <a href="https://datatracker.ietf.org/doc/html/rfc3986#section-5"
+        >5. Reference Resolution (rfc3986)</a>
+
+    @see
+        @ref resolve.
+*/
+class resolver
+{
+    url_view base_;
+    string_view dir_;
+
+    std::size_t
+    max_size(
+        url_view const& ref) const noexcept;
+
+    void
+    write(
+        url_view const& ref,
+        url_view& u,
+        char* dest) const noexcept;
+
+public:
+    /** Constructor
+
+        @throw std::invalid_argument `base`
+        has no scheme.
+
+        @param base The base URL, which must
+        satisfy the <em>absolute-URI</em>
+        grammar.
+    */
+    BOOST_URL_DECL
+    explicit
+    resolver(
+        url_view const& base);
+
+    /** Return the base URL
+    */
+    url_view const&
+    base() const noexcept
+    {
+        return base_;
+    }
+
+    /** Resolve a reference into a URL
+
+        The result of resolving `ref` against
+        the base is placed into `dest`, which
+        is written once. No memory is allocated
+        when the capacity of `dest` is sufficient.
+
+        @par Exception Safety
+        Basic guarantee.
+        Calls to allocate may throw.
+
+        @param ref The URL reference to resolve.
+
+        @param dest The container where the
+        result is written.
+    */
+    BOOST_URL_DECL
+    void
+    resolve(
+        url_view const& ref,
+        url& dest) const;
+
+    /** Resolve a reference into a character buffer
+
+        The result of resolving `ref` against
+        the base is written to the buffer starting
+        at `dest`, which is advanced past the
+        result. The returned view references
+        the characters in the buffer. Space is
+        required for the result before dot
+        segments are removed, which is never
+        more than the combined size of the
+        base and the reference.
+
+        @par Exception Safety
+        Throws nothing.
+
+        @return A view of the result, or an
+        empty view upon error.
+
+        @param ref The URL reference to resolve.
+
+        @param dest A reference to the start of
+        the buffer, advanced upon success.
+
+        @param end One past the end of the buffer.
+
+        @param ec Set to @ref error::no_space if
+        the buffer is too small. Upon error,
+        the buffer contents are unspecified
+        and `dest` is not changed.
+    */
+    BOOST_URL_DECL
+    url_view
+    resolve(
+        url_view const& ref,
+        char*& dest,
+        char const* end,
+        error_code& ec) const noexcept;
+
+    /** Resolve a range of references into URLs
+
+        Each reference in the range `[first, last)`
+        is resolved against the base and written
+        to successive elements of the output
+        sequence, which must be objects of type
+        @ref url or a derived class. Reusing the
+        same output objects avoids allocations
+        once their capacity is sufficient.
+
+        @par Exception Safety
+        Basic guarantee.
+        Calls to allocate may throw.
+
+        @return An iterator one past the last
+        element written.
+
+        @param first, last The range of references,
+        whose elements are convertible to
+        @ref url_view.
+
+        @param dest The beginning of the output
+        sequence.
+    */
+    template<class InputIt, class OutputIt>
+    OutputIt
+    resolve(
+        InputIt first,
+        InputIt last,
+        OutputIt dest) const;
+
+    /** Resolve a range of references into a character buffer
+
+        Each reference in the range `[first, last)`
+        is resolved against the base and written
+        to the buffer starting at `dest`, one after
+        another. A view of each result is written
+        to successive elements of the sequence
+        starting at `views`.
+
+        @par Example
+        @code
+        resolver r( base );
+        char buf[ 4096 ];
+        char* p = buf;
+        std::vector< url_view > v( refs.size() );
+        error_code ec;
+        r.resolve( refs.begin(), refs.end(), p, buf + sizeof(buf), v.begin(), ec );
+        @endcode
+
+        @par Exception Safety
+        Throws nothing unless writing to the
+        output sequence throws.
+
+        @return An iterator one past the last
+        view written.
+
+        @param first, last The range of references,
+        whose elements are convertible to
+        @ref url_view.
+
+        @param dest A reference to the start of
+        the buffer, advanced past each result.
+
+        @param end One past the end of the buffer.
+
+        @param views The beginning of the output
+        sequence of views.
+
+        @param ec Set to @ref error::no_space if
+        the buffer is too small, in which case
+        the remaining references are not resolved.
+    */
+    template<
+        class InputIt,
+        class OutputIt>
+    OutputIt
+    resolve(
+        InputIt first,
+        InputIt last,
+        char*& dest,
+        char const* end,
+        OutputIt views,
+        error_code& ec) const;
+};
+
+} // urls
+} // boost
+
+#include <boost/url/impl/resolver.hpp>
+
+#endif
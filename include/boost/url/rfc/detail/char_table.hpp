@@ -0,0 +1,256 @@
+//
+// Copyright (c) 2016-2019 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/CPPAlliance/url
+//
+
+#ifndef BOOST_URL_RFC_DETAIL_CHAR_TABLE_HPP
+#define BOOST_URL_RFC_DETAIL_CHAR_TABLE_HPP
+
+#include <boost/url/detail/config.hpp>
+#include <boost/url/bnf/charset.hpp>
+#include <boost/mp11/integer_sequence.hpp>
+#include <cstdint>
+
+namespace boost {
+namespace urls {
+namespace detail {
+
+/*  The classes of the chars used by the
+    rfc3986 grammars, one bit each. Every
+    char is in at most one class, except
+    for ct_hexdig which is also set on the
+    ALPHA and DIGIT chars it applies to.
+
+    A character set of the grammar is a
+    mask of classes, and the membership
+    of a char in any of them, or in any
+    union of them, is one load from the
+    table and one AND.
+*/
+constexpr std::uint16_t ct_alpha    = 0x0001;
+constexpr std::uint16_t ct_digit    = 0x0002;
+constexpr std::uint16_t ct_dash_dot = 0x0004; // "-" / "."
+constexpr std::uint16_t ct_mark     = 0x0008; // "_" / "~"
+constexpr std::uint16_t ct_plus     = 0x0010;
+constexpr std::uint16_t ct_subdelim = 0x0020; // not "&" "=" "+"
+constexpr std::uint16_t ct_amp      = 0x0040;
+constexpr std::uint16_t ct_equal    = 0x0080;
+constexpr std::uint16_t ct_colon    = 0x0100;
+constexpr std::uint16_t ct_at       = 0x0200;
+constexpr std::uint16_t ct_slash    = 0x0400;
+constexpr std::uint16_t ct_qmark    = 0x0800;
+constexpr std::uint16_t ct_pct      = 0x1000;
+constexpr std::uint16_t ct_hexdig   = 0x2000;
+
+// unreserved    = ALPHA / DIGIT / "-" / "." / "_" / "~"
+constexpr std::uint16_t ct_unreserved =
+    ct_alpha | ct_digit | ct_dash_dot | ct_mark;
+
+// sub-delims    = "!" / "$" / "&" / "'" / "(" / ")"
+//               / "*" / "+" / "," / ";" / "="
+constexpr std::uint16_t ct_sub_delims =
+    ct_subdelim | ct_plus | ct_amp | ct_equal;
+
+// pchar, without pct-encoded
+constexpr std::uint16_t ct_pchar =
+    ct_unreserved | ct_sub_delims |
+    ct_colon | ct_at;
+
+// query, fragment
+constexpr std::uint16_t ct_query =
+    ct_pchar | ct_slash | ct_qmark;
+
+constexpr
+std::uint16_t
+make_char_class(unsigned char c) noexcept
+{
+    return static_cast<std::uint16_t>(
+        ((c >= 'a' && c <= 'f') ||
+         (c >= 'A' && c <= 'F') ||
+         (c >= '0' && c <= '9') ?
+            ct_hexdig : 0) | (
+        (c >= 'a' && c <= 'z') ||
+        (c >= 'A' && c <= 'Z') ?
+            ct_alpha :
+        (c >= '0' && c <= '9') ?
+            ct_digit :
+        c == '-' || c == '.' ?
+            ct_dash_dot :
+        c == '_' || c == '~' ?
+            ct_mark :
+        c == '+' ? ct_plus :
+        c == '!' || c == '$' ||
+        c == '\'' || c == '(' ||
+        c == ')' || c == '*' ||
+        c == ',' || c == ';' ?
+            ct_subdelim :
+        c == '&' ? ct_amp :
+        c == '=' ? ct_equal :
+        c == ':' ? ct_colon :
+        c == '@' ? ct_at :
+        c == '/' ? ct_slash :
+        c == '?' ? ct_qmark :
+        c == '%' ? ct_pct :
+        0));
+}
+
+struct char_table_type
+{
+    std::uint16_t v[256];
+};
+
+template<std::size_t... I>
+constexpr
+char_table_type
+make_char_table(
+    mp11::index_sequence<I...>) noexcept
+{
+    return { { make_char_class(
+        static_cast<unsigned char>(I))... } };
+}
+
+constexpr char_table_type char_table =
+    make_char_table(
+        mp11::make_index_sequence<256>{});
+
+// Return the classes of c
+constexpr
+std::uint16_t
+char_class(char c) noexcept
+{
+    return char_table.v[
+        static_cast<unsigned char>(c)];
+}
+
+/*  A character set which is a mask of
+    classes from the char table.
+
+    The runs of members are found with
+    the vectorized kernels, which use a
+    lut_chars made from the same table.
+*/
+class class_chars
+{
+    struct pred
+    {
+        std::uint16_t mask;
+
+        constexpr
+        bool
+        operator()(char c) const noexcept
+        {
+            return (char_class(c) &
+                mask) != 0;
+        }
+    };
+
+    std::uint16_t mask_;
+    bnf::lut_chars lut_;
+
+public:
+    constexpr
+    explicit
+    class_chars(
+        std::uint16_t mask) noexcept
+        : mask_(mask)
+        , lut_(pred{mask})
+    {
+    }
+
+    constexpr
+    std::uint16_t
+    mask() const noexcept
+    {
+        return mask_;
+    }
+
+    constexpr
+    bool
+    operator()(char c) const noexcept
+    {
+        return (char_class(c) &
+            mask_) != 0;
+    }
+
+    char const*
+    find_if(
+        char const* first,
+        char const* last) const noexcept
+    {
+        return lut_.find_if(
+            first, last);
+    }
+
+    char const*
+    find_if_not(
+        char const* first,
+        char const* last) const noexcept
+    {
+        return lut_.find_if_not(
+            first, last);
+    }
+};
+
+// scheme chars after the first ALPHA
+constexpr class_chars scheme_chars(
+    ct_alpha | ct_digit |
+    ct_plus | ct_dash_dot);
+
+// userinfo before and after the ":"
+constexpr class_chars user_chars(
+    ct_unreserved | ct_sub_delims);
+constexpr class_chars pass_chars(
+    ct_unreserved | ct_sub_delims |
+    ct_colon);
+
+// reg-name, without pct-encoded
+constexpr class_chars reg_name_chars(
+    ct_unreserved);
+
+// segment, segment-nz-nc, and
+// the path after the first "/"
+constexpr class_chars segment_chars(
+    ct_pchar);
+constexpr class_chars nc_chars(
+    ct_pchar & ~ct_colon);
+constexpr class_chars path_chars(
+    ct_pchar | ct_slash);
+
+// query and fragment, and a param
+// key and value in the query
+constexpr class_chars query_chars(
+    ct_query);
+constexpr class_chars fragment_chars(
+    ct_query);
+constexpr class_chars key_chars(
+    ct_query & ~(ct_amp | ct_equal));
+constexpr class_chars value_chars(
+    ct_query & ~ct_amp);
+
+// IPvFuture after the "."
+constexpr class_chars future_chars(
+    ct_unreserved | ct_sub_delims |
+    ct_colon);
+
+/*  Return true if both c0 and c1 are
+    HEXDIG, with one branch.
+*/
+constexpr
+bool
+is_hexdig2(
+    char c0,
+    char c1) noexcept
+{
+    return (char_class(c0) &
+        char_class(c1) & ct_hexdig) != 0;
+}
+
+} // detail
+} // urls
+} // boost
+
+#endif
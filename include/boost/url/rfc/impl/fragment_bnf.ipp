@@ -12,7 +12,7 @@
 
 #include <boost/url/rfc/fragment_bnf.hpp>
 #include <boost/url/bnf/parse.hpp>
-#include <boost/url/rfc/charsets.hpp>
+#include <boost/url/rfc/detail/char_table.hpp>
 #include <boost/url/rfc/pct_encoded_bnf.hpp>
 
 namespace boost {
@@ -28,7 +28,7 @@ parse(
     using bnf::parse;
     return parse(it, end, ec,
         pct_encoded_bnf(
-        fragment_chars, t.v));
+            detail::fragment_chars, t.v));
 }
 
 bool
@@ -14,7 +14,7 @@
 #include <boost/url/bnf/charset.hpp>
 #include <boost/url/bnf/parse.hpp>
 #include <boost/url/bnf/token.hpp>
-#include <boost/url/rfc/charsets.hpp>
+#include <boost/url/rfc/detail/char_table.hpp>
 
 namespace boost {
 namespace urls {
@@ -28,15 +28,14 @@ parse(
 {
     using namespace bnf;
     auto const start = it;
-    static constexpr auto cs =
-        unreserved_chars +
-        subdelim_chars + ':';
     if(! parse(it, end, ec,
         'v',
         bnf::token(
             hexdig_chars, t.major),
         '.',
-        bnf::token(cs, t.minor)))
+        bnf::token(
+            urls::detail::future_chars,
+            t.minor)))
         return false;
     if(t.major.empty())
     {
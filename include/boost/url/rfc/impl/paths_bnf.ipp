@@ -12,7 +12,7 @@
 
 #include <boost/url/rfc/paths_bnf.hpp>
 #include <boost/url/bnf/parse.hpp>
-#include <boost/url/rfc/charsets.hpp>
+#include <boost/url/rfc/detail/char_table.hpp>
 #include <boost/url/rfc/pct_encoded_bnf.hpp>
 
 namespace boost {
@@ -27,7 +27,8 @@ parse(
 {
     using bnf::parse;
     return parse(it, end, ec,
-        pct_encoded_bnf(pchars, t.v));
+        pct_encoded_bnf(
+            detail::segment_chars, t.v));
 }
 
 //------------------------------------------------
@@ -42,7 +43,8 @@ parse(
     using bnf::parse;
     auto const start = it;
     if(! parse(it, end, ec,
-        pct_encoded_bnf(pchars, t.v)))
+        pct_encoded_bnf(
+            detail::segment_chars, t.v)))
         return false;
     if(it == start)
     {
@@ -65,10 +67,9 @@ parse(
 {
     using bnf::parse;
     auto const start = it;
-    static constexpr auto cs =
-        pchars - ':';
     if(! parse(it, end, ec,
-        pct_encoded_bnf(cs, t.v)))
+        pct_encoded_bnf(
+            detail::nc_chars, t.v)))
         return false;
     if(it == start)
     {
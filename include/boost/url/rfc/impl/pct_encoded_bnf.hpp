@@ -12,6 +12,7 @@
 
 #include <boost/url/pct_encoding.hpp>
 #include <boost/url/bnf/charset.hpp>
+#include <boost/url/rfc/detail/char_table.hpp>
 
 namespace boost {
 namespace urls {
@@ -66,7 +67,8 @@ skip:
                 error::missing_pct_hexdig);
             return false;
         }
-        if(bnf::hexdig_value(*it) == -1)
+        if(! (detail::char_class(*it) &
+            detail::ct_hexdig))
         {
             // expected HEXDIG
             ec = BOOST_URL_ERR(
@@ -81,7 +83,8 @@ skip:
                 error::missing_pct_hexdig);
             return false;
         }
-        if(bnf::hexdig_value(*it) == -1)
+        if(! (detail::char_class(*it) &
+            detail::ct_hexdig))
         {
             // expected HEXDIG
             ec = BOOST_URL_ERR(
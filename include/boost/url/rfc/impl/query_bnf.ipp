@@ -12,7 +12,7 @@
 
 #include <boost/url/rfc/query_bnf.hpp>
 #include <boost/url/bnf/parse.hpp>
-#include <boost/url/rfc/charsets.hpp>
+#include <boost/url/rfc/detail/char_table.hpp>
 #include <boost/url/rfc/pct_encoded_bnf.hpp>
 
 namespace boost {
@@ -29,13 +29,10 @@ begin(
     using bnf::parse;
 
     // key
-    {
-        static constexpr auto cs =
-            pchars + '/' + '?' - '&' - '=';
-        if(! parse(it, end, ec,
-            pct_encoded_bnf(cs, t.key)))
-            return false;
-    }
+    if(! parse(it, end, ec,
+        pct_encoded_bnf(
+            detail::key_chars, t.key)))
+        return false;
 
     // "="
     t.has_value = parse(
@@ -48,10 +45,9 @@ begin(
     }
 
     // value
-    static constexpr auto cs =
-        pchars + '/' + '?' - '&';
     return parse(it, end, ec,
-        pct_encoded_bnf(cs, t.value));
+        pct_encoded_bnf(
+            detail::value_chars, t.value));
 }
 
 bool
@@ -72,13 +68,10 @@ increment(
     }
 
     // key
-    {
-        static constexpr auto cs =
-            pchars + '/' + '?' - '&' - '=';
-        if(! parse(it, end, ec,
-            pct_encoded_bnf(cs, t.key)))
-            return false;
-    }
+    if(! parse(it, end, ec,
+        pct_encoded_bnf(
+            detail::key_chars, t.key)))
+        return false;
 
     // "="
     t.has_value = parse(
@@ -91,10 +84,9 @@ increment(
     }
 
     // value
-    static constexpr auto cs =
-        pchars + '/' + '?' - '&';
     return parse(it, end, ec,
-        pct_encoded_bnf(cs, t.value));
+        pct_encoded_bnf(
+            detail::value_chars, t.value));
 }
 
 bool
@@ -11,6 +11,7 @@
 #define BOOST_URL_IMPL_REG_NAME_BNF_IPP
 
 #include <boost/url/rfc/reg_name_bnf.hpp>
+#include <boost/url/rfc/detail/char_table.hpp>
 
 namespace boost {
 namespace urls {
@@ -37,7 +38,7 @@ parse(
     return parse(
         it, end, ec,
         pct_encoded_bnf(
-            reg_name_chars, t.v));
+            detail::reg_name_chars, t.v));
 }
 
 } // urls
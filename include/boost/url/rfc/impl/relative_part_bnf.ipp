@@ -35,6 +35,7 @@ parse(
     }
     if(it[0] != '/')
     {
+        auto const start = it;
         path_noscheme_bnf t0;
         if(parse(it, end, ec, t0))
         {
@@ -45,6 +46,7 @@ parse(
             return true;
         }
         // path-empty
+        it = start;
         ec = {};
         t.path = {};
         t.has_authority = false;
@@ -12,7 +12,7 @@
 
 #include <boost/url/rfc/scheme_bnf.hpp>
 #include <boost/url/bnf/parse.hpp>
-#include <boost/url/rfc/charsets.hpp>
+#include <boost/url/rfc/detail/char_table.hpp>
 
 namespace boost {
 namespace urls {
@@ -39,14 +39,9 @@ parse(
             error::bad_alpha);
         return false;
     }
-    static
-    constexpr
-    bnf::lut_chars scheme_chars(
-        "0123456789" "+-."
-        "ABCDEFGHIJKLMNOPQRSTUVWXYZ"
-        "abcdefghijklmnopqrstuvwxyz");
     it = bnf::find_if_not(
-        it + 1, end, scheme_chars);
+        it + 1, end,
+        detail::scheme_chars);
     t.scheme = string_view(
         start, it - start);
     t.scheme_id = string_to_scheme(
@@ -13,7 +13,7 @@
 #include <boost/url/rfc/userinfo_bnf.hpp>
 #include <boost/url/error.hpp>
 #include <boost/url/string.hpp>
-#include <boost/url/rfc/charsets.hpp>
+#include <boost/url/rfc/detail/char_table.hpp>
 #include <boost/url/rfc/pct_encoded_bnf.hpp>
 
 namespace boost {
@@ -28,14 +28,10 @@ parse(
 {
     using bnf::parse;
     auto start = it;
-    {
-        static constexpr auto cs =
-            unreserved_chars +
-            subdelim_chars;
-        if(! parse(it, end, ec,
-            pct_encoded_bnf(cs, t.user)))
-            return false;
-    }
+    if(! parse(it, end, ec,
+        pct_encoded_bnf(
+            detail::user_chars, t.user)))
+        return false;
     t.user_part = string_view(
         start, it - start);
     start = it;
@@ -43,11 +39,9 @@ parse(
         *it == ':')
     {
         ++it;
-        static constexpr auto cs =
-            unreserved_chars +
-            subdelim_chars + ':';
         if(! parse(it, end, ec,
-            pct_encoded_bnf(cs,
+            pct_encoded_bnf(
+                detail::pass_chars,
                 t.password)))
             return false;
         t.has_password = true;
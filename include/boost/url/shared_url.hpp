@@ -0,0 +1,268 @@
+//
+// Copyright (c) 2019 Vinnie Falco (vinnie.falco@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/CPPAlliance/url
+//
+
+#ifndef BOOST_URL_SHARED_URL_HPP
+#define BOOST_URL_SHARED_URL_HPP
+
+#include <boost/url/detail/config.hpp>
+#include <boost/url/string.hpp>
+#include <boost/url/url.hpp>
+#include <boost/url/url_view.hpp>
+#include <cstddef>
+#include <memory>
+
+namespace boost {
+namespace urls {
+
+/** A URL whose storage is shared between copies
+
+    Objects of this type hold a URL in a
+    reference-counted buffer. Copies share
+    the buffer, so copying costs no more than
+    copying a `std::shared_ptr`, however long
+    the URL. The URL is read through
+    @ref view, and modified through the
+    @ref url returned by @ref edit, which
+    first makes a private copy of the
+    buffer if it is shared. Thus a copy may
+    be handed to many consumers, and only
+    those which modify it pay for a copy.
+
+    The characters and the table of the URL
+    are stored in the same allocation as the
+    reference count. Should an edit outgrow
+    that storage, the URL moves to dynamic
+    storage, as with @ref small_url.
+
+    @par Example
+    @code
+    shared_url u0( "https://www.example.com/index.htm" );
+
+    shared_url u1 = u0;                         // no copy of the URL
+
+    assert( u1.view().data() == u0.view().data() );
+
+    u1.edit().set_encoded_path( "/favicon.ico" ); // u1 is copied here
+
+    assert( u0.view().encoded_path() == "/index.htm" );
+    assert( u1.view().encoded_path() == "/favicon.ico" );
+    @endcode
+
+    @par Thread Safety
+    Distinct objects may be used concurrently,
+    even when they share a buffer, as the
+    buffer is never modified while shared.
+    Concurrent use of the same object, where
+    any use is not const, is not safe.
+
+    @see
+        @ref url,
+        @ref url_view::collect.
+*/
+class shared_url
+{
+    struct impl;
+
+    std::shared_ptr<url> p_;
+
+    BOOST_URL_DECL
+    static
+    std::shared_ptr<url>
+    make(url_view const& u);
+
+public:
+    /** Constructor
+
+        Default constructed objects contain
+        a zero-length string. No memory
+        is allocated.
+    */
+    shared_url() noexcept = default;
+
+    /** Constructor
+
+        The new object shares the buffer
+        of `other`.
+
+        @par Exception Safety
+        Throws nothing.
+    */
+    shared_url(
+        shared_url const& other) noexcept = default;
+
+    /** Constructor
+
+        The new object takes the buffer of
+        `other`, which then contains a
+        zero-length string.
+
+        @par Exception Safety
+        Throws nothing.
+    */
+    shared_url(
+        shared_url&& other) noexcept = default;
+
+    /** Constructor
+
+        This constructs a copy of `u`, with
+        one allocation.
+
+        @par Exception Safety
+        Strong guarantee.
+        Calls to allocate may throw.
+    */
+    BOOST_URL_DECL
+    shared_url(url_view const& u);
+
+    /** Constructor
+
+        This parses the string and stores
+        a copy of the result.
+
+        @par Exception Safety
+        Strong guarantee.
+        Calls to allocate may throw.
+
+        @throw std::invalid_argument parse error.
+    */
+    BOOST_URL_DECL
+    explicit
+    shared_url(string_view s);
+
+    /** Assignment
+
+        This object shares the buffer
+        of `other`.
+
+        @par Exception Safety
+        Throws nothing.
+    */
+    shared_url&
+    operator=(
+        shared_url const& other) noexcept = default;
+
+    /** Assignment
+
+        This object takes the buffer of
+        `other`, which then contains a
+        zero-length string.
+
+        @par Exception Safety
+        Throws nothing.
+    */
+    shared_url&
+    operator=(
+        shared_url&& other) noexcept = default;
+
+    /** Assignment
+
+        This replaces the contents with a
+        copy of `u`, in a new buffer.
+
+        @par Exception Safety
+        Strong guarantee.
+        Calls to allocate may throw.
+    */
+    BOOST_URL_DECL
+    shared_url&
+    operator=(url_view const& u);
+
+    /** Return the URL
+
+        The view remains valid until this
+        object is destroyed, assigned, or
+        edited.
+    */
+    BOOST_URL_DECL
+    url_view const&
+    view() const noexcept;
+
+    /** Return the URL
+    */
+    url_view const&
+    operator*() const noexcept
+    {
+        return view();
+    }
+
+    /** Return the URL
+    */
+    url_view const*
+    operator->() const noexcept
+    {
+        return &view();
+    }
+
+    /** Return the URL for modification
+
+        If the buffer is shared with another
+        object, this object first makes a
+        copy of the URL in a new buffer, which
+        it does not share. Copies made before
+        this call keep the original URL.
+
+        @par Exception Safety
+        Strong guarantee.
+        Calls to allocate may throw.
+
+        @note
+        The buffer is shared again by any
+        copy of this object. The returned
+        reference must not be used to modify
+        the URL after a copy is made, without
+        calling this function again.
+    */
+    BOOST_URL_DECL
+    url&
+    edit();
+
+    /** Return true if no other object shares the buffer
+    */
+    bool
+    unique() const noexcept
+    {
+        return p_.use_count() <= 1;
+    }
+
+    /** Return the number of objects sharing the buffer
+
+        The value is zero if this object
+        has no buffer.
+    */
+    std::size_t
+    use_count() const noexcept
+    {
+        return static_cast<std::size_t>(
+            p_.use_count());
+    }
+
+    /** Swap the contents
+    */
+    void
+    swap(shared_url& other) noexcept
+    {
+        p_.swap(other.p_);
+    }
+
+    /** Swap the contents
+    */
+    friend
+    void
+    swap(
+        shared_url& u0,
+        shared_url& u1) noexcept
+    {
+        u0.swap(u1);
+    }
+};
+
+} // urls
+} // boost
+
+#endif
@@ -0,0 +1,91 @@
+//
+// Copyright (c) 2019 Vinnie Falco (vinnie.falco@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/CPPAlliance/url
+//
+
+#ifndef BOOST_URL_SIMD_LEVEL_HPP
+#define BOOST_URL_SIMD_LEVEL_HPP
+
+#include <boost/url/detail/config.hpp>
+#include <boost/url/string.hpp>
+
+namespace boost {
+namespace urls {
+
+/** Identifies the instruction set used by the library's kernels.
+
+    Character set scanning and percent-encoding
+    use vectorized kernels. On x86 targets,
+    kernels for instruction sets beyond the
+    compiler's target are built into the library
+    and the best one supported by the processor
+    is chosen once, on first use. Defining
+    `BOOST_URL_NO_DISPATCH` disables the run-time
+    selection, leaving only the kernels for the
+    compiler's target.
+
+    @see
+        @ref active_simd_level.
+*/
+enum class simd_level
+{
+    // VFALCO 3 space indent or
+    // else Doxygen malfunctions
+
+    /**
+     * Portable scalar code.
+    */
+    none,
+
+    /**
+     * SSE2 instructions.
+    */
+    sse2,
+
+    /**
+     * SSSE3 instructions.
+    */
+    ssse3,
+
+    /**
+     * AVX2 instructions.
+    */
+    avx2
+};
+
+/** Return the instruction set chosen for the library's kernels
+
+    The choice is made once, on the first call
+    to this function or to any algorithm which
+    uses the kernels, and does not change for
+    the lifetime of the program.
+
+    @par Exception Safety
+    Throws nothing.
+*/
+BOOST_URL_DECL
+simd_level
+active_simd_level() noexcept;
+
+/** Return the name of an instruction set as a string
+
+    @par Example
+    @code
+    assert( to_string( simd_level::avx2 ) == "avx2" );
+    @endcode
+
+    @par Exception Safety
+    Throws nothing.
+*/
+BOOST_URL_DECL
+string_view
+to_string(simd_level v) noexcept;
+
+} // urls
+} // boost
+
+#endif
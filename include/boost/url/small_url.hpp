@@ -0,0 +1,240 @@
+//
+// Copyright (c) 2019 Vinnie Falco (vinnie.falco@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/CPPAlliance/url
+//
+
+#ifndef BOOST_URL_SMALL_URL_HPP
+#define BOOST_URL_SMALL_URL_HPP
+
+#include <boost/url/detail/config.hpp>
+#include <boost/url/url.hpp>
+#include <boost/align/align_up.hpp>
+#include <boost/static_assert.hpp>
+#include <cstddef>
+
+namespace boost {
+namespace urls {
+
+// This is here to reduce the number of
+// template instantiations, and keep
+// definitions in the library
+#ifndef BOOST_URL_DOCS
+class BOOST_SYMBOL_VISIBLE
+    small_url_base : public url
+{
+    char* buf_;
+    std::size_t buf_cap_;
+
+protected:
+    BOOST_URL_DECL
+    virtual
+    ~small_url_base();
+
+    BOOST_URL_DECL small_url_base(
+        char* buf, std::size_t cap) noexcept;
+    BOOST_URL_DECL void construct(string_view s);
+    BOOST_URL_DECL void move(small_url_base& u) noexcept;
+    BOOST_URL_DECL void deallocate(char*) override;
+};
+#endif
+
+//------------------------------------------------
+
+/** A URL with inline storage for short strings
+
+    This container acts like @ref url,
+    except that the data is first stored
+    in an inline buffer. Only when the URL
+    outgrows the buffer is storage allocated
+    dynamically, after which the container
+    behaves as a @ref url. Unlike
+    @ref static_url, exceeding the inline
+    capacity is not an error.
+
+    @par Example
+    @code
+    small_url< 128 > u( "https://www.example.com" );
+
+    assert( u.is_inline() );
+
+    u.set_encoded_path( "/path/to/file.txt" );  // no allocation
+    @endcode
+
+    @tparam Capacity The size of the inline
+    buffer in bytes. A URL requires bytes
+    equal to at least the number of
+    characters plus one for the terminating
+    NULL, plus an additional number of bytes
+    proportional to the larger of the count
+    of path segments and the count of query
+    params. Due to alignment requirements,
+    the usable capacity may be slightly less
+    than this number.
+
+    @note
+    Since @ref url is a base class, an
+    object of this type may be moved into
+    a @ref url. This is undefined behavior,
+    as the storage may be inline. Copies
+    between the types are always allowed.
+
+    @see
+        @ref url,
+        @ref static_url.
+*/
+template<std::size_t Capacity>
+class small_url
+#ifdef BOOST_URL_DOCS
+    : public url
+#else
+    : public small_url_base
+#endif
+{
+    BOOST_STATIC_ASSERT(Capacity > 0);
+    BOOST_STATIC_ASSERT(
+        Capacity < (std::size_t(-1) &
+            ~(alignof(pos_t)-1)));
+    alignas(pos_t) char buf_[
+        alignment::align_up(
+            Capacity, alignof(pos_t))];
+
+public:
+    /** Destructor
+    */
+    ~small_url()
+    {
+    }
+
+    /** Constructor
+
+        Default constructed urls contain
+        a zero-length string. No memory
+        is allocated.
+    */
+    small_url() noexcept
+        : small_url_base(
+            buf_, sizeof(buf_))
+    {
+    }
+
+    /** Constructor
+
+        This constructs a copy of `u`.
+
+        @par Exception Safety
+        Strong guarantee.
+        Calls to allocate may throw.
+    */
+    small_url(url_view const& u)
+        : small_url()
+    {
+        copy(u);
+    }
+
+    /** Constructor
+
+        This constructs a copy of `u`.
+
+        @par Exception Safety
+        Strong guarantee.
+        Calls to allocate may throw.
+    */
+    small_url(small_url const& u)
+        : small_url()
+    {
+        copy(u);
+    }
+
+    /** Constructor
+
+        The contents of `u` are transferred
+        to the newly constructed object. If
+        the storage of `u` is inline the
+        characters are copied, otherwise
+        ownership of the storage is
+        transferred. After the move, `u`
+        is empty.
+    */
+    small_url(small_url&& u) noexcept
+        : small_url()
+    {
+        move(u);
+    }
+
+    /** Assignment
+
+        @par Exception Safety
+        Strong guarantee.
+        Calls to allocate may throw.
+    */
+    small_url&
+    operator=(url_view const& u)
+    {
+        copy(u);
+        return *this;
+    }
+
+    /** Assignment
+
+        @par Exception Safety
+        Strong guarantee.
+        Calls to allocate may throw.
+    */
+    small_url&
+    operator=(small_url const& u)
+    {
+        copy(u);
+        return *this;
+    }
+
+    /** Assignment
+
+        The contents of `u` are transferred
+        to this object. If the storage of `u`
+        is inline the characters are copied,
+        otherwise ownership of the storage
+        is transferred. After the move, `u`
+        is empty.
+    */
+    small_url&
+    operator=(small_url&& u) noexcept
+    {
+        move(u);
+        return *this;
+    }
+
+    /** Return true if the storage is inline
+
+        This returns `false` once the URL
+        has outgrown the inline buffer.
+    */
+    bool
+    is_inline() const noexcept
+    {
+        return s_ == buf_;
+    }
+
+    /** Construct from a string
+
+        This function constructs a URL from
+        the string `s`, which must contain a
+        valid URI or <em>relative-ref</em> or
+        else an exception is thrown.
+
+        @throw std::invalid_argument parse error
+    */
+    small_url(string_view s)
+        : small_url()
+    {
+        construct(s);
+    }
+};
+
+} // urls
+} // boost
+
+#endif
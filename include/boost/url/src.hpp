@@ -32,25 +32,38 @@ in a translation unit of the program.
 #include <boost/url/detail/impl/except.ipp>
 #include <boost/url/detail/impl/path.ipp>
 #include <boost/url/detail/impl/pct_encoding.ipp>
+#include <boost/url/detail/impl/simd.ipp>
 
 #include <boost/url/impl/authority_view.ipp>
 #include <boost/url/impl/error.ipp>
 #include <boost/url/impl/ipv4_address.ipp>
 #include <boost/url/impl/ipv6_address.ipp>
+#include <boost/url/impl/lazy_url_view.ipp>
 #include <boost/url/impl/params.ipp>
 #include <boost/url/impl/params_encoded.ipp>
 #include <boost/url/impl/params_encoded_view.ipp>
 #include <boost/url/impl/params_view.ipp>
+#include <boost/url/impl/parse_stats.ipp>
 #include <boost/url/impl/pct_encoding.ipp>
+#include <boost/url/impl/resolver.ipp>
 #include <boost/url/impl/scheme.ipp>
 #include <boost/url/impl/segments.ipp>
 #include <boost/url/impl/segments_encoded.ipp>
 #include <boost/url/impl/segments_encoded_view.ipp>
 #include <boost/url/impl/segments_view.ipp>
+#include <boost/url/impl/shared_url.ipp>
+#include <boost/url/impl/simd_level.ipp>
+#include <boost/url/impl/small_url.ipp>
 #include <boost/url/impl/static_pool.ipp>
 #include <boost/url/impl/static_url.ipp>
 #include <boost/url/impl/url.ipp>
+#include <boost/url/impl/url_builder.ipp>
+#include <boost/url/impl/url_editor.ipp>
+#include <boost/url/impl/url_pieces.ipp>
+#include <boost/url/impl/url_stream_parser.ipp>
+#include <boost/url/impl/url_table.ipp>
 #include <boost/url/impl/url_view.ipp>
+#include <boost/url/impl/validate.ipp>
 
 #include <boost/url/bnf/impl/range.ipp>
 
@@ -81,6 +81,11 @@ protected:
     void
     copy(url_view const& u);
 
+    // Returns storage of at least new_cap
+    // bytes aligned for pos_t, and sets
+    // cap_ to its size. The storage is
+    // later passed to deallocate while
+    // cap_ is still equal to its size.
     BOOST_URL_DECL
     virtual
     char*
@@ -1182,11 +1187,52 @@ public:
     //
     //--------------------------------------------
 
-    /** Normalize everything.
+    /** Normalize the URL in place
+
+        This function applies the syntax-based
+        normalizations of rfc3986 to the URL, so
+        that equivalent URLs compare equal as
+        strings:
+
+        @li The scheme and host are converted
+        to lower case,
+
+        @li Percent-encoded unreserved characters
+        are decoded, and the hexadecimal digits
+        of the remaining escapes are converted
+        to upper case,
+
+        @li Dot segments are removed from the
+        path, and
+
+        @li An empty port, or the default port
+        of a known scheme, is removed.
+
+        The URL is rewritten in its existing
+        buffer, which never grows, so no memory
+        is allocated.
+
+        @par Example
+        @code
+        url u = parse_uri( "HTTP://www.Example.COM:80/a/./b/../%7euser" ).value();
+
+        u.normalize();
+
+        assert( u.string() == "http://www.example.com/a/~user" );
+        @endcode
+
+        @par Exception Safety
+        Throws nothing.
+
+        @par Specification
+        @li <a href="https://datatracker.ietf.org/doc/html/rfc3986#section-6.2.2"
+            >6.2.2. Syntax-Based Normalization (rfc3986)</a>
+        @li <a href="https://datatracker.ietf.org/doc/html/rfc3986#section-6.2.3"
+            >6.2.3. Scheme-Based Normalization (rfc3986)</a>
     */
     BOOST_URL_DECL
     url&
-    normalize();
+    normalize() noexcept;
 
     //--------------------------------------------
     //
@@ -1210,10 +1256,27 @@ private:
     //
     //--------------------------------------------
 
+    friend class resolver;
+    friend class shared_url;
     friend class static_url_base;
+    friend class url_builder;
+    friend class url_editor;
 
     void check_invariants() const noexcept;
     void build_tab() noexcept;
+    void shift_segments(std::size_t n) noexcept;
+    void remove_dot_segments() noexcept;
+
+    inline pos_t* tab_end() const noexcept;
+    inline pos_t& seg_tab(std::size_t i) const noexcept;
+    inline pos_t& param_tab(std::size_t i) const noexcept;
+
+    static
+    std::size_t
+    capacity_for(
+        std::size_t nchar,
+        std::size_t nseg,
+        std::size_t nparam);
 
     void
     ensure_space(
@@ -1251,7 +1314,9 @@ private:
     This process is defined in detail in
     rfc3986 (see below).
     The result of the resolution is placed
-    into `dest`.
+    into `dest`, which is written once, and
+    no memory is allocated when the capacity
+    of `dest` is sufficient.
     If an error occurs, the contents of
     `dest` is unspecified.
 
@@ -1278,6 +1343,7 @@ private:
         >5. Reference Resolution (rfc3986)</a>
 
     @see
+        @ref resolver,
         @ref url,
         @ref url_view.
 */
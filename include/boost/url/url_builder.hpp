@@ -0,0 +1,287 @@
+//
+// Copyright (c) 2019 Vinnie Falco (vinnie.falco@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/CPPAlliance/url
+//
+
+#ifndef BOOST_URL_URL_BUILDER_HPP
+#define BOOST_URL_URL_BUILDER_HPP
+
+#include <boost/url/detail/config.hpp>
+#include <boost/url/host_type.hpp>
+#include <boost/url/ipv4_address.hpp>
+#include <boost/url/ipv6_address.hpp>
+#include <boost/url/scheme.hpp>
+#include <boost/url/string.hpp>
+#include <boost/url/url.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace boost {
+namespace urls {
+
+/** A builder which constructs a URL from its parts
+
+    Objects of this type hold the plain,
+    unencoded parts of a URL, and build a
+    @ref url from them. The size of the
+    encoded URL is computed exactly before
+    anything is written, so the url is
+    allocated at most once, and each part
+    is percent-encoded directly into its
+    place in the url. The table of path
+    segments and query params is produced
+    without parsing the result.
+
+    Special and reserved characters in the
+    parts are escaped as needed. A path
+    is formed from its segments, adding a
+    prefix when required to preserve them,
+    and the query is formed from its params.
+
+    @par Example
+    @code
+    url_builder b;
+    b.set_scheme( "https" )
+     .set_host( "www.example.com" )
+     .set_port( 8443 )
+     .add_segment( "docs" )
+     .add_segment( "my file.txt" )
+     .add_param( "q", "a&b" )
+     .set_fragment( "top" );
+
+    url u = b.build();
+
+    assert( u.string() == "https://www.example.com:8443/docs/my%20file.txt?q=a%26b#top" );
+    @endcode
+
+    @note
+    The strings passed to the builder are
+    referenced, not copied. The caller is
+    responsible for ensuring that their
+    lifetime extends until the builder is
+    cleared or destroyed. Clearing the
+    builder keeps the storage for segments
+    and params, so a builder may be reused
+    without allocating.
+
+    @see
+        @ref url,
+        @ref url_editor.
+*/
+class url_builder
+{
+    struct param
+    {
+        string_view key;
+        string_view value;
+        bool has_value;
+    };
+
+    string_view scheme_;
+    string_view user_;
+    string_view pass_;
+    string_view host_;
+    string_view frag_;
+    std::vector<string_view> segs_;
+    std::vector<param> params_;
+    char ip_buf_[2 +
+        ipv6_address::max_str_len];
+    std::size_t ip_n_ = 0;
+    unsigned char ip_addr_[16] = {};
+    urls::host_type host_type_ =
+        urls::host_type::none;
+    std::uint16_t port_ = 0;
+    bool has_scheme_ = false;
+    bool has_user_ = false;
+    bool has_pass_ = false;
+    bool has_port_ = false;
+    bool has_frag_ = false;
+    bool abs_ = false;
+
+    BOOST_URL_DECL
+    std::size_t
+    path_prefix() const noexcept;
+
+public:
+    /** Constructor
+
+        Default constructed builders
+        produce the empty URL.
+    */
+    url_builder() = default;
+
+    /** Remove all parts
+
+        The storage for segments and
+        params is kept.
+    */
+    BOOST_URL_DECL
+    void
+    clear() noexcept;
+
+    /** Set the scheme
+
+        The scheme is checked when the
+        URL is built.
+    */
+    BOOST_URL_DECL
+    url_builder&
+    set_scheme(string_view s) noexcept;
+
+    /** Set the scheme
+
+        @par Preconditions
+        @code
+        id != scheme::unknown
+        @endcode
+    */
+    BOOST_URL_DECL
+    url_builder&
+    set_scheme(urls::scheme id) noexcept;
+
+    /** Set the user
+
+        The URL will have an authority.
+    */
+    BOOST_URL_DECL
+    url_builder&
+    set_user(string_view s) noexcept;
+
+    /** Set the password
+
+        The URL will have an authority.
+    */
+    BOOST_URL_DECL
+    url_builder&
+    set_password(string_view s) noexcept;
+
+    /** Set the host
+
+        If the string is a valid IPv4
+        address it is used as such.
+        The URL will have an authority.
+    */
+    BOOST_URL_DECL
+    url_builder&
+    set_host(string_view s) noexcept;
+
+    /** Set the host
+
+        The URL will have an authority.
+    */
+    BOOST_URL_DECL
+    url_builder&
+    set_host(ipv4_address const& addr) noexcept;
+
+    /** Set the host
+
+        The URL will have an authority.
+    */
+    BOOST_URL_DECL
+    url_builder&
+    set_host(ipv6_address const& addr) noexcept;
+
+    /** Set the port
+
+        The URL will have an authority.
+    */
+    BOOST_URL_DECL
+    url_builder&
+    set_port(std::uint16_t n) noexcept;
+
+    /** Set whether the path is absolute
+
+        A path which follows an authority
+        is always absolute when it has
+        segments. The default is `false`.
+    */
+    BOOST_URL_DECL
+    url_builder&
+    set_path_absolute(bool absolute) noexcept;
+
+    /** Append a segment to the path
+    */
+    BOOST_URL_DECL
+    url_builder&
+    add_segment(string_view s);
+
+    /** Append a param without a value to the query
+
+        The URL has a query when it has
+        at least one param.
+    */
+    BOOST_URL_DECL
+    url_builder&
+    add_param(string_view key);
+
+    /** Append a param to the query
+
+        The URL has a query when it has
+        at least one param.
+    */
+    BOOST_URL_DECL
+    url_builder&
+    add_param(
+        string_view key,
+        string_view value);
+
+    /** Set the fragment
+    */
+    BOOST_URL_DECL
+    url_builder&
+    set_fragment(string_view s) noexcept;
+
+    /** Return the size of the URL which would be built
+
+        @throw std::invalid_argument The
+        scheme is invalid.
+    */
+    BOOST_URL_DECL
+    std::size_t
+    size() const;
+
+    /** Build the URL into an existing url
+
+        The previous contents of `u` are
+        replaced. Its storage is reused
+        when it is large enough.
+
+        @par Exception Safety
+        Strong guarantee.
+        Calls to allocate may throw.
+
+        @throw std::invalid_argument The
+        scheme is invalid.
+
+        @throw std::length_error The result
+        is longer than @ref url::max_size.
+    */
+    BOOST_URL_DECL
+    void
+    build(url& u) const;
+
+    /** Build the URL
+
+        @par Exception Safety
+        Calls to allocate may throw.
+
+        @throw std::invalid_argument The
+        scheme is invalid.
+
+        @throw std::length_error The result
+        is longer than @ref url::max_size.
+    */
+    BOOST_URL_DECL
+    url
+    build() const;
+};
+
+} // urls
+} // boost
+
+#endif
@@ -0,0 +1,354 @@
+//
+// Copyright (c) 2019 Vinnie Falco (vinnie.falco@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/CPPAlliance/url
+//
+
+#ifndef BOOST_URL_URL_EDITOR_HPP
+#define BOOST_URL_URL_EDITOR_HPP
+
+#include <boost/url/detail/config.hpp>
+#include <boost/url/ipv4_address.hpp>
+#include <boost/url/ipv6_address.hpp>
+#include <boost/url/string.hpp>
+#include <boost/url/url.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace boost {
+namespace urls {
+
+/** A set of changes applied to a url at once
+
+    Objects of this type record replacements
+    for the parts of a @ref url, which are
+    applied together when @ref commit is
+    called. Each setter of @ref url moves
+    every character after the part it changes,
+    and may reallocate, while a commit writes
+    each character of the new URL once, and
+    allocates at most once.
+
+    The recorded parts are placed verbatim
+    with their delimiters, and are checked
+    only when committed. If the result is
+    not a valid URL containing exactly those
+    parts, for example because a path without
+    a leading slash follows an authority,
+    the commit throws and the url is left
+    unchanged.
+
+    @par Example
+    @code
+    url u = parse_uri( "http://www.example.com/index.htm" ).value();
+
+    url_editor e( u );
+    e.set_scheme( "https" )
+     .set_encoded_host( "example.org" )
+     .set_port( 8443 )
+     .set_encoded_path( "/a/b" )
+     .set_encoded_query( "q=1" );
+    e.commit();
+
+    assert( u.string() == "https://example.org:8443/a/b?q=1" );
+    @endcode
+
+    @note
+    The url referenced by the editor must
+    remain valid until the editor is
+    destroyed. Changes which are not
+    committed are discarded.
+
+    @see
+        @ref url.
+*/
+class url_editor
+{
+    enum
+    {
+        p_scheme,
+        p_user,
+        p_pass,
+        p_host,
+        p_port,
+        p_path,
+        p_query,
+        p_frag,
+        p_end
+    };
+
+    enum state : unsigned char
+    {
+        st_keep,
+        st_set,
+        st_remove
+    };
+
+    struct slot
+    {
+        std::size_t pos = 0;
+        std::size_t len = 0;
+        state st = st_keep;
+    };
+
+    url& u_;
+    std::string buf_;
+    slot v_[p_end];
+    state auth_ = st_keep;
+
+    BOOST_URL_DECL
+    char*
+    set_impl(
+        int id,
+        std::size_t n);
+
+    BOOST_URL_DECL
+    void
+    set_impl(
+        int id,
+        string_view s);
+
+    BOOST_URL_DECL
+    string_view
+    get(int id) const noexcept;
+
+public:
+    /** Constructor
+
+        The editor records changes to `u`.
+        No changes are recorded initially.
+
+        @param u The url to edit.
+    */
+    explicit
+    url_editor(url& u) noexcept
+        : u_(u)
+    {
+    }
+
+    /** Return true if no change is recorded
+    */
+    BOOST_URL_DECL
+    bool
+    empty() const noexcept;
+
+    /** Discard the recorded changes
+    */
+    BOOST_URL_DECL
+    void
+    reset() noexcept;
+
+    /** Apply the recorded changes
+
+        The URL is rebuilt from the parts in
+        one pass over its characters, and the
+        recorded changes are discarded.
+
+        @par Exception Safety
+        Strong guarantee.
+        Calls to allocate may throw.
+
+        @throw std::invalid_argument The
+        result is not a valid URL with the
+        recorded parts.
+
+        @throw std::length_error The result
+        is longer than @ref url::max_size.
+    */
+    BOOST_URL_DECL
+    void
+    commit();
+
+    //--------------------------------------------
+
+    /** Set the scheme
+    */
+    BOOST_URL_DECL
+    url_editor&
+    set_scheme(string_view s);
+
+    /** Remove the scheme
+    */
+    BOOST_URL_DECL
+    url_editor&
+    remove_scheme() noexcept;
+
+    /** Set the user
+
+        Any special or reserved characters in
+        the string are automatically escaped.
+        The url will have an authority.
+    */
+    BOOST_URL_DECL
+    url_editor&
+    set_user(string_view s);
+
+    /** Set the user
+
+        The url will have an authority.
+    */
+    BOOST_URL_DECL
+    url_editor&
+    set_encoded_user(string_view s);
+
+    /** Set the password
+
+        Any special or reserved characters in
+        the string are automatically escaped.
+        The url will have an authority.
+    */
+    BOOST_URL_DECL
+    url_editor&
+    set_password(string_view s);
+
+    /** Set the password
+
+        The url will have an authority.
+    */
+    BOOST_URL_DECL
+    url_editor&
+    set_encoded_password(string_view s);
+
+    /** Remove the user and password
+    */
+    BOOST_URL_DECL
+    url_editor&
+    remove_userinfo() noexcept;
+
+    /** Set the host
+
+        If the string is a valid IPv4 address
+        it is used as such, otherwise any
+        special or reserved characters in the
+        string are automatically escaped.
+        The url will have an authority.
+    */
+    BOOST_URL_DECL
+    url_editor&
+    set_host(string_view s);
+
+    /** Set the host
+
+        The url will have an authority.
+    */
+    BOOST_URL_DECL
+    url_editor&
+    set_host(ipv4_address const& addr);
+
+    /** Set the host
+
+        The url will have an authority.
+    */
+    BOOST_URL_DECL
+    url_editor&
+    set_host(ipv6_address const& addr);
+
+    /** Set the host
+
+        The url will have an authority.
+    */
+    BOOST_URL_DECL
+    url_editor&
+    set_encoded_host(string_view s);
+
+    /** Set the port
+
+        The url will have an authority.
+    */
+    BOOST_URL_DECL
+    url_editor&
+    set_port(std::uint16_t n);
+
+    /** Set the port
+
+        The url will have an authority.
+    */
+    BOOST_URL_DECL
+    url_editor&
+    set_port(string_view s);
+
+    /** Remove the port
+    */
+    BOOST_URL_DECL
+    url_editor&
+    remove_port() noexcept;
+
+    /** Remove the authority
+
+        This removes the user, password,
+        host, and port. A later change to
+        one of them adds an authority again.
+    */
+    BOOST_URL_DECL
+    url_editor&
+    remove_authority() noexcept;
+
+    /** Set the path
+
+        Any special or reserved characters in
+        the string, other than slashes, are
+        automatically escaped.
+    */
+    BOOST_URL_DECL
+    url_editor&
+    set_path(string_view s);
+
+    /** Set the path
+    */
+    BOOST_URL_DECL
+    url_editor&
+    set_encoded_path(string_view s);
+
+    /** Set the query
+
+        Any special or reserved characters in
+        the string, other than those which
+        separate the params, are automatically
+        escaped.
+    */
+    BOOST_URL_DECL
+    url_editor&
+    set_query(string_view s);
+
+    /** Set the query
+    */
+    BOOST_URL_DECL
+    url_editor&
+    set_encoded_query(string_view s);
+
+    /** Remove the query
+    */
+    BOOST_URL_DECL
+    url_editor&
+    remove_query() noexcept;
+
+    /** Set the fragment
+
+        Any special or reserved characters in
+        the string are automatically escaped.
+    */
+    BOOST_URL_DECL
+    url_editor&
+    set_fragment(string_view s);
+
+    /** Set the fragment
+    */
+    BOOST_URL_DECL
+    url_editor&
+    set_encoded_fragment(string_view s);
+
+    /** Remove the fragment
+    */
+    BOOST_URL_DECL
+    url_editor&
+    remove_fragment() noexcept;
+};
+
+} // urls
+} // boost
+
+#endif
@@ -0,0 +1,1021 @@
+//
+// Copyright (c) 2019 Vinnie Falco (vinnie.falco@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/CPPAlliance/url
+//
+
+#ifndef BOOST_URL_URL_LITERAL_HPP
+#define BOOST_URL_URL_LITERAL_HPP
+
+#include <boost/url/detail/config.hpp>
+#include <boost/url/host_type.hpp>
+#include <boost/url/scheme.hpp>
+#include <boost/url/string.hpp>
+#include <boost/url/url_view.hpp>
+#include <boost/url/bnf/ascii.hpp>
+#include <boost/url/bnf/charset.hpp>
+#include <boost/url/detail/except.hpp>
+#include <boost/url/detail/parts_base.hpp>
+#include <boost/url/detail/path.hpp>
+#include <boost/url/rfc/charsets.hpp>
+#include <boost/url/rfc/reg_name_bnf.hpp>
+#include <cstddef>
+#include <cstdint>
+
+namespace boost {
+namespace urls {
+
+#ifndef BOOST_URL_DOCS
+namespace detail {
+namespace literal {
+
+constexpr bnf::lut_chars scheme_chars(
+    "0123456789" "+-."
+    "ABCDEFGHIJKLMNOPQRSTUVWXYZ"
+    "abcdefghijklmnopqrstuvwxyz");
+constexpr bnf::lut_chars user_chars =
+    unreserved_chars + subdelim_chars;
+constexpr bnf::lut_chars pass_chars =
+    user_chars + ':';
+constexpr bnf::lut_chars nc_chars =
+    pchars - ':';
+constexpr bnf::lut_chars path_chars =
+    pchars + '/';
+constexpr bnf::lut_chars param_chars =
+    query_chars - '&';
+constexpr bnf::lut_chars future_chars =
+    unreserved_chars + subdelim_chars + ':';
+
+} // literal
+} // detail
+#endif
+
+/** A URL parsed from a constant expression
+
+    Objects of this type hold the same parts
+    as a @ref url_view, and are produced by the
+    same <em>URI-reference</em> grammar, but
+    this is a literal type whose constructor
+    and observers are `constexpr`. A URL known
+    when the program is written can be parsed
+    and checked by the compiler, so that an
+    invalid literal is a compile error and its
+    parts are constants with no cost at run
+    time. The function @ref view returns the
+    equivalent @ref url_view, without parsing
+    again.
+
+    Under C++11 the functions are not
+    `constexpr`, and the string is parsed
+    at run time instead. Before C++17 the
+    length of a `char const*` can not be
+    found in a constant expression, so the
+    literal operator `_url` should be used.
+
+    @par Example
+    @code
+    using namespace boost::urls::literals;
+
+    constexpr auto u = "https://www.example.com:8080/index.htm"_url;
+    static_assert( u.scheme_id() == scheme::https, "" );
+    static_assert( u.port_number() == 8080, "" );
+
+    url_view v = u.view();
+    @endcode
+
+    @note
+    The string is referenced, not copied.
+    String literals are never destroyed,
+    but for any other string the caller is
+    responsible for ensuring that its lifetime
+    extends until the object is no longer
+    in use.
+
+    @see
+        @ref parse_uri_reference,
+        @ref url_view.
+*/
+class url_literal
+    : private detail::parts_base
+{
+    char const* cs_ = "";
+    pos_t offset_[id_end + 1] = {};
+    pos_t decoded_[id_end] = {};
+    pos_t nseg_ = 0;
+    pos_t nparam_ = 0;
+    unsigned char ip_addr_[16] = {};
+    std::uint16_t port_number_ = 0;
+    urls::host_type host_type_ =
+        urls::host_type::none;
+    urls::scheme scheme_ =
+        urls::scheme::none;
+
+    constexpr
+    string_view
+    get(int first,
+        int last) const noexcept
+    {
+        return string_view(
+            cs_ + (first < 0 ?
+                0 : offset_[first]),
+            offset_[last] - (first < 0 ?
+                0 : offset_[first]));
+    }
+
+    constexpr
+    std::size_t
+    len(int id) const noexcept
+    {
+        return offset_[id + 1] -
+            (id < 0 ? 0 : offset_[id]);
+    }
+
+    static
+    BOOST_CXX14_CONSTEXPR
+    bool
+    iequals(
+        char const* p,
+        std::size_t n,
+        char const* s) noexcept
+    {
+        for(; n != 0; --n)
+            if(bnf::ascii_tolower(
+                *p++) != *s++)
+                return false;
+        return *s == 0;
+    }
+
+    // as string_to_scheme
+    static
+    BOOST_CXX14_CONSTEXPR
+    urls::scheme
+    to_scheme(
+        char const* p,
+        std::size_t n) noexcept
+    {
+        return
+            iequals(p, n, "http") ?
+                urls::scheme::http :
+            iequals(p, n, "https") ?
+                urls::scheme::https :
+            iequals(p, n, "ws") ?
+                urls::scheme::ws :
+            iequals(p, n, "wss") ?
+                urls::scheme::wss :
+            iequals(p, n, "ftp") ?
+                urls::scheme::ftp :
+            iequals(p, n, "file") ?
+                urls::scheme::file :
+            urls::scheme::unknown;
+    }
+
+    // as detail::skip_pct_encoded
+    static
+    BOOST_CXX14_CONSTEXPR
+    bool
+    skip(
+        char const*& it,
+        char const* const end,
+        bnf::lut_chars const& cs,
+        std::size_t& n) noexcept
+    {
+        for(;;)
+        {
+            while(
+                it != end &&
+                cs(*it))
+            {
+                ++it;
+                ++n;
+            }
+            if( it == end ||
+                *it != '%')
+                return true;
+            if( end - it < 3 ||
+                ! bnf::hexdig_chars(it[1]) ||
+                ! bnf::hexdig_chars(it[2]))
+                return false;
+            it += 3;
+            ++n;
+        }
+    }
+
+    // as detail::dec_octet
+    static
+    BOOST_CXX14_CONSTEXPR
+    bool
+    parse_octet(
+        char const*& it,
+        char const* const end,
+        unsigned char& v) noexcept
+    {
+        if( it == end ||
+            ! bnf::digit_chars(*it))
+            return false;
+        unsigned u = *it++ - '0';
+        if( it != end &&
+            bnf::digit_chars(*it))
+        {
+            if(u == 0)
+                return false;
+            u = 10 * u + *it++ - '0';
+            if( it != end &&
+                bnf::digit_chars(*it))
+            {
+                u = 10 * u + *it++ - '0';
+                if(u > 255)
+                    return false;
+            }
+        }
+        v = static_cast<
+            unsigned char>(u);
+        return true;
+    }
+
+    // as parse(..., ipv4_address&)
+    static
+    BOOST_CXX14_CONSTEXPR
+    bool
+    parse_ipv4(
+        char const*& it,
+        char const* const end,
+        unsigned char* bytes) noexcept
+    {
+        for(int i = 0; i < 4; ++i)
+        {
+            if(i != 0)
+            {
+                if( it == end ||
+                    *it != '.')
+                    return false;
+                ++it;
+            }
+            if(! parse_octet(
+                    it, end, bytes[i]))
+                return false;
+        }
+        return true;
+    }
+
+    // as detail::h16
+    static
+    BOOST_CXX14_CONSTEXPR
+    bool
+    parse_h16(
+        char const*& it,
+        char const* const end,
+        unsigned char* p) noexcept
+    {
+        if(bnf::hexdig_value(*it) == -1)
+            return false;
+        unsigned v = 0;
+        for(int i = 0; i < 4 &&
+            it != end &&
+            bnf::hexdig_value(*it) != -1; ++i)
+            v = 16 * v +
+                bnf::hexdig_value(*it++);
+        p[0] = static_cast<
+            unsigned char>(v / 256);
+        p[1] = static_cast<
+            unsigned char>(v % 256);
+        return true;
+    }
+
+    // as parse(..., ipv6_address&)
+    static
+    BOOST_CXX14_CONSTEXPR
+    bool
+    parse_ipv6(
+        char const*& it,
+        char const* const end,
+        unsigned char* dest) noexcept
+    {
+        int n = 8;      // words needed
+        int b = -1;     // value of n
+                        // when '::' seen
+        bool c = false; // need colon
+        auto prev = it;
+        unsigned char bytes[16] = {};
+        for(;;)
+        {
+            if(it == end)
+            {
+                if(b != -1)
+                    break;
+                return false;
+            }
+            if(*it == ':')
+            {
+                ++it;
+                if(it == end)
+                    return false;
+                if(*it == ':')
+                {
+                    if(b != -1)
+                        return false;
+                    // first "::"
+                    ++it;
+                    --n;
+                    b = n;
+                    if(n == 0)
+                        break;
+                    c = false;
+                    continue;
+                }
+                if(! c)
+                    return false;
+                prev = it;
+                if(! parse_h16(it, end,
+                        &bytes[2*(8-n)]))
+                    return false;
+                --n;
+                if(n == 0)
+                    break;
+                continue;
+            }
+            if(*it == '.')
+            {
+                // the last h16 is
+                // reparsed as IPv4
+                if(b == -1 && n > 1)
+                    return false;
+                unsigned const word =
+                    bytes[2*(7-n)] * 256u +
+                    bytes[2*(7-n)+1];
+                if( word > 0x255 ||
+                    ((word >> 4) & 0xf) > 9 ||
+                    (word & 0xf) > 9)
+                    return false;
+                it = prev;
+                if(! parse_ipv4(it, end,
+                        &bytes[2*(7-n)]))
+                    return false;
+                --n;
+                break;
+            }
+            if( b != -1 &&
+                bnf::hexdig_value(*it) == -1)
+            {
+                // ends in "::"
+                break;
+            }
+            if(c)
+                return false;
+            prev = it;
+            if(! parse_h16(it, end,
+                    &bytes[2*(8-n)]))
+                return false;
+            --n;
+            if(n == 0)
+                break;
+            c = true;
+        }
+        if(b != -1)
+        {
+            // move the words after
+            // "::" to the end
+            int const i0 = 2 * (7 - b);
+            int const i1 = 2 * (b - n);
+            for(int i = 0; i < i1; ++i)
+                bytes[15 - i] =
+                    bytes[i0 + 1 + i1 - i];
+            for(int i = i0;
+                    i < 16 - i1; ++i)
+                bytes[i] = 0;
+        }
+        for(int i = 0; i < 16; ++i)
+            dest[i] = bytes[i];
+        return true;
+    }
+
+    BOOST_CXX14_CONSTEXPR
+    bool
+    parse(string_view s) noexcept
+    {
+        auto const start = s.data();
+        auto const end = start + s.size();
+        auto it = start;
+        std::size_t n = 0;
+
+        // [ scheme ":" ]
+        if( it != end &&
+            bnf::alpha_chars(*it))
+        {
+            auto p = it + 1;
+            while(
+                p != end &&
+                detail::literal::scheme_chars(*p))
+                ++p;
+            if( p != end &&
+                *p == ':')
+            {
+                scheme_ = to_scheme(
+                    it, p - it);
+                it = p + 1;
+            }
+        }
+        bool const has_scheme = it != start;
+        offset_[id_user] = it - start;
+
+        std::size_t nseg = 0;
+        if( end - it >= 2 &&
+            it[0] == '/' &&
+            it[1] == '/')
+        {
+            // "//" authority
+            it += 2;
+            auto const auth = it;
+
+            // [ userinfo "@" ]
+            std::size_t nuser = 0;
+            std::size_t npass = 0;
+            if(! skip(it, end,
+                    detail::literal::user_chars,
+                    nuser))
+                return false;
+            auto const user_end = it;
+            if( it != end &&
+                *it == ':')
+            {
+                ++it;
+                if(! skip(it, end,
+                        detail::literal::pass_chars,
+                        npass))
+                    return false;
+            }
+            if( it != end &&
+                *it == '@')
+            {
+                decoded_[id_user] = nuser;
+                decoded_[id_pass] = npass;
+                offset_[id_pass] =
+                    user_end - start;
+                ++it;
+            }
+            else
+            {
+                it = auth;
+                offset_[id_pass] = it - start;
+            }
+            offset_[id_host] = it - start;
+
+            // host
+            if(it == end)
+            {
+                host_type_ =
+                    urls::host_type::name;
+            }
+            else if(*it == '[')
+            {
+                // IP-literal
+                ++it;
+                if(it == end)
+                    return false;
+                if(*it != 'v')
+                {
+                    if(! parse_ipv6(
+                            it, end, ip_addr_))
+                        return false;
+                    host_type_ =
+                        urls::host_type::ipv6;
+                }
+                else
+                {
+                    // "v" 1*HEXDIG "." 1*( ... )
+                    ++it;
+                    auto p = it;
+                    while(
+                        it != end &&
+                        bnf::hexdig_chars(*it))
+                        ++it;
+                    if( it == p ||
+                        it == end ||
+                        *it != '.')
+                        return false;
+                    p = ++it;
+                    while(
+                        it != end &&
+                        detail::literal::future_chars(*it))
+                        ++it;
+                    if(it == p)
+                        return false;
+                    host_type_ =
+                        urls::host_type::ipvfuture;
+                }
+                if( it == end ||
+                    *it != ']')
+                    return false;
+                ++it;
+            }
+            else if(
+                bnf::digit_chars(*it) &&
+                parse_ipv4(it, end, ip_addr_))
+            {
+                host_type_ =
+                    urls::host_type::ipv4;
+            }
+            else
+            {
+                it = start + offset_[id_host];
+                for(int i = 0; i < 4; ++i)
+                    ip_addr_[i] = 0;
+                std::size_t nhost = 0;
+                if(! skip(it, end,
+                        reg_name_chars, nhost))
+                    return false;
+                host_type_ =
+                    urls::host_type::name;
+                decoded_[id_host] = nhost;
+            }
+            offset_[id_port] = it - start;
+
+            // [ ":" port ], as port_bnf
+            if( it != end &&
+                *it == ':')
+            {
+                auto const p = ++it;
+                std::uint16_t u = 0;
+                bool overflow = false;
+                while(
+                    it != end &&
+                    bnf::digit_chars(*it))
+                {
+                    auto const u0 = u;
+                    u = static_cast<
+                        std::uint16_t>(
+                            10 * u + *it - '0');
+                    if(u < u0)
+                        overflow = true;
+                    ++it;
+                }
+                if( it != p &&
+                    ! overflow)
+                    port_number_ = u;
+            }
+            offset_[id_path] = it - start;
+        }
+        else
+        {
+            offset_[id_pass] = it - start;
+            offset_[id_host] = it - start;
+            offset_[id_port] = it - start;
+            offset_[id_path] = it - start;
+            if( it != end &&
+                *it != '/')
+            {
+                auto const it0 = it;
+                if(has_scheme)
+                {
+                    // path-rootless
+                    if(! skip(it, end,
+                            pchars, n))
+                        return false;
+                    if(it == it0)
+                        return false;
+                }
+                else
+                {
+                    // path-noscheme, or
+                    // path-empty if it fails
+                    if(! skip(it, end,
+                            detail::literal::nc_chars,
+                            n))
+                        return false;
+                }
+                if(it != it0)
+                    nseg = 1;
+            }
+        }
+
+        // *( "/" segment )
+        if( it != end &&
+            *it == '/')
+        {
+            auto p = it;
+            if(! skip(it, end,
+                    detail::literal::path_chars,
+                    n))
+                return false;
+            for(; p != it; ++p)
+                if(*p == '/')
+                    ++nseg;
+        }
+        offset_[id_query] = it - start;
+        nseg_ = detail::path_segments(
+            get(id_path, id_query), nseg);
+
+        // [ "?" query ]
+        if( it != end &&
+            *it == '?')
+        {
+            ++it;
+            std::size_t nparam = 1;
+            if(! skip(it, end,
+                    detail::literal::param_chars,
+                    n))
+                return false;
+            while(
+                it != end &&
+                *it == '&')
+            {
+                ++it;
+                ++nparam;
+                if(! skip(it, end,
+                        detail::literal::param_chars,
+                        n))
+                    return false;
+            }
+            nparam_ = nparam;
+        }
+        offset_[id_frag] = it - start;
+
+        // [ "#" fragment ]
+        if( it != end &&
+            *it == '#')
+        {
+            ++it;
+            std::size_t nfrag = 0;
+            if(! skip(it, end,
+                    fragment_chars, nfrag))
+                return false;
+            decoded_[id_frag] = nfrag;
+        }
+        if(it != end)
+            return false;
+        offset_[id_end] = it - start;
+        return true;
+    }
+
+public:
+    /** Constructor
+
+        Default constructed literals refer
+        to an empty string.
+    */
+    constexpr
+    url_literal() noexcept = default;
+
+    /** Constructor
+
+        The string is parsed using the
+        <em>URI-reference</em> grammar, as
+        @ref parse_uri_reference does. In a
+        constant expression an invalid
+        string is a compile error.
+
+        @par Exception Safety
+        Exceptions thrown on invalid input.
+
+        @throw std::invalid_argument The
+        string is not a valid URI-reference.
+
+        @throw std::length_error
+        `s.size() > url_view::max_size()`
+
+        @param s The string to parse.
+    */
+    BOOST_CXX14_CONSTEXPR
+    explicit
+    url_literal(string_view s)
+        : cs_(s.data())
+    {
+        if(s.size() > url_view::max_size())
+            detail::throw_length_error(
+                "url_view::max_size exceeded",
+                BOOST_CURRENT_LOCATION);
+        if(! parse(s))
+            detail::throw_invalid_argument(
+                BOOST_CURRENT_LOCATION);
+    }
+
+    /** Return the equivalent url_view
+
+        The parts found by the constructor
+        are copied, and nothing is parsed.
+
+        @par Exception Safety
+        Throws nothing.
+    */
+    url_view
+    view() const noexcept
+    {
+        url_view u(0, cs_);
+        for(int i = 0; i <= id_end; ++i)
+            u.offset_[i] = offset_[i];
+        for(int i = 0; i < id_end; ++i)
+            u.decoded_[i] = decoded_[i];
+        for(int i = 0; i < 16; ++i)
+            u.ip_addr_[i] = ip_addr_[i];
+        u.nseg_ = nseg_;
+        u.nparam_ = nparam_;
+        u.port_number_ = port_number_;
+        u.host_type_ = host_type_;
+        u.scheme_ = scheme_;
+        return u;
+    }
+
+    /** Return the equivalent url_view
+
+        @see @ref view.
+    */
+    operator url_view() const noexcept
+    {
+        return view();
+    }
+
+    /** Return the number of characters in the URL
+    */
+    constexpr
+    std::size_t
+    size() const noexcept
+    {
+        return offset_[id_end];
+    }
+
+    /** Return a pointer to the characters
+    */
+    constexpr
+    char const*
+    data() const noexcept
+    {
+        return cs_;
+    }
+
+    /** Return the complete string
+    */
+    constexpr
+    string_view
+    string() const noexcept
+    {
+        return string_view(
+            cs_, offset_[id_end]);
+    }
+
+    /** Return true if a scheme is present
+
+        @see @ref url_view::has_scheme.
+    */
+    constexpr
+    bool
+    has_scheme() const noexcept
+    {
+        return len(id_scheme) != 0;
+    }
+
+    /** Return the scheme
+
+        @see @ref url_view::scheme.
+    */
+    BOOST_CXX14_CONSTEXPR
+    string_view
+    scheme() const noexcept
+    {
+        auto s = get(id_scheme, id_user);
+        if(! s.empty())
+            s.remove_suffix(1);
+        return s;
+    }
+
+    /** Return a constant representing the scheme
+
+        @see @ref url_view::scheme_id.
+    */
+    constexpr
+    urls::scheme
+    scheme_id() const noexcept
+    {
+        return scheme_;
+    }
+
+    /** Return true if an authority is present
+
+        @see @ref url_view::has_authority.
+    */
+    constexpr
+    bool
+    has_authority() const noexcept
+    {
+        return len(id_user) != 0;
+    }
+
+    /** Return the authority
+
+        @see @ref url_view::encoded_authority.
+    */
+    BOOST_CXX14_CONSTEXPR
+    string_view
+    encoded_authority() const noexcept
+    {
+        auto s = get(id_user, id_path);
+        if(! s.empty())
+            s.remove_prefix(2);
+        return s;
+    }
+
+    /** Return true if a userinfo is present
+
+        @see @ref url_view::has_userinfo.
+    */
+    constexpr
+    bool
+    has_userinfo() const noexcept
+    {
+        return len(id_pass) != 0;
+    }
+
+    /** Return the userinfo
+
+        @see @ref url_view::encoded_userinfo.
+    */
+    BOOST_CXX14_CONSTEXPR
+    string_view
+    encoded_userinfo() const noexcept
+    {
+        auto s = get(id_user, id_host);
+        if(s.empty())
+            return s;
+        s.remove_prefix(2);
+        if(! s.empty())
+            s.remove_suffix(1);
+        return s;
+    }
+
+    /** Return the host
+
+        @see @ref url_view::encoded_host.
+    */
+    constexpr
+    string_view
+    encoded_host() const noexcept
+    {
+        return get(id_host, id_port);
+    }
+
+    /** Return the type of host
+
+        @see @ref url_view::host_type.
+    */
+    constexpr
+    urls::host_type
+    host_type() const noexcept
+    {
+        return host_type_;
+    }
+
+    /** Return true if a port is present
+
+        @see @ref url_view::has_port.
+    */
+    constexpr
+    bool
+    has_port() const noexcept
+    {
+        return len(id_port) != 0;
+    }
+
+    /** Return the port
+
+        @see @ref url_view::port.
+    */
+    BOOST_CXX14_CONSTEXPR
+    string_view
+    port() const noexcept
+    {
+        auto s = get(id_port, id_path);
+        if(! s.empty())
+            s.remove_prefix(1);
+        return s;
+    }
+
+    /** Return the port number
+
+        @see @ref url_view::port_number.
+    */
+    constexpr
+    std::uint16_t
+    port_number() const noexcept
+    {
+        return port_number_;
+    }
+
+    /** Return the path
+
+        @see @ref url_view::encoded_path.
+    */
+    constexpr
+    string_view
+    encoded_path() const noexcept
+    {
+        return get(id_path, id_query);
+    }
+
+    /** Return the number of path segments
+
+        @see @ref url_view::segments.
+    */
+    constexpr
+    std::size_t
+    segment_count() const noexcept
+    {
+        return nseg_;
+    }
+
+    /** Return true if a query is present
+
+        @see @ref url_view::has_query.
+    */
+    constexpr
+    bool
+    has_query() const noexcept
+    {
+        return len(id_query) != 0;
+    }
+
+    /** Return the query
+
+        @see @ref url_view::encoded_query.
+    */
+    BOOST_CXX14_CONSTEXPR
+    string_view
+    encoded_query() const noexcept
+    {
+        auto s = get(id_query, id_frag);
+        if(! s.empty())
+            s.remove_prefix(1);
+        return s;
+    }
+
+    /** Return the number of query params
+
+        @see @ref url_view::params.
+    */
+    constexpr
+    std::size_t
+    param_count() const noexcept
+    {
+        return nparam_;
+    }
+
+    /** Return true if a fragment is present
+
+        @see @ref url_view::has_fragment.
+    */
+    constexpr
+    bool
+    has_fragment() const noexcept
+    {
+        return len(id_frag) != 0;
+    }
+
+    /** Return the fragment
+
+        @see @ref url_view::encoded_fragment.
+    */
+    BOOST_CXX14_CONSTEXPR
+    string_view
+    encoded_fragment() const noexcept
+    {
+        auto s = get(id_frag, id_end);
+        if(! s.empty())
+            s.remove_prefix(1);
+        return s;
+    }
+};
+
+namespace literals {
+
+/** Return a URL parsed from a string literal
+
+    @par Example
+    @code
+    using namespace boost::urls::literals;
+
+    constexpr auto u = "http://www.example.com/index.htm"_url;
+    static_assert( u.encoded_path() == "/index.htm", "" );
+    @endcode
+
+    @throw std::invalid_argument The
+    string is not a valid URI-reference.
+
+    @see @ref url_literal.
+*/
+BOOST_CXX14_CONSTEXPR
+inline
+url_literal
+operator "" _url(
+    char const* s,
+    std::size_t n)
+{
+    return url_literal(
+        string_view(s, n));
+}
+
+} // literals
+
+} // urls
+} // boost
+
+#endif
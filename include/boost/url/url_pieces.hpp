@@ -0,0 +1,349 @@
+//
+// Copyright (c) 2019 Vinnie Falco (vinnie.falco@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/CPPAlliance/url
+//
+
+#ifndef BOOST_URL_URL_PIECES_HPP
+#define BOOST_URL_URL_PIECES_HPP
+
+#include <boost/url/detail/config.hpp>
+#include <boost/url/error.hpp>
+#include <boost/url/host_type.hpp>
+#include <boost/url/scheme.hpp>
+#include <boost/url/string.hpp>
+#include <boost/url/url_stream_parser.hpp>
+#include <boost/type_traits/make_void.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <string>
+#include <type_traits>
+
+namespace boost {
+namespace urls {
+
+#ifndef BOOST_URL_DOCS
+class url_pieces;
+
+template<class Buffers>
+result<url_pieces>
+parse_uri_reference_buffers(
+    Buffers const& buffers);
+#endif
+
+/** A URL parsed from a sequence of buffers
+
+    Objects of this type hold the parts of a
+    URL whose characters are spread over the
+    buffers of a buffer sequence, such as the
+    request-target of an HTTP request received
+    with a scatter read. Each part refers into
+    the buffer which holds it. Only a part which
+    straddles the boundary between two buffers
+    is copied, into storage owned by this
+    object, so the buffers need not be joined
+    into one string before parsing.
+
+    Objects of this type are returned by
+    @ref parse_uri_reference_buffers.
+
+    @par Example
+    @code
+    std::array< string_view, 3 > bufs = {
+        "https://www.exa", "mple.com/index", ".htm?q=1" };
+
+    result< url_pieces > r = parse_uri_reference_buffers( bufs );
+
+    assert( r->encoded_host() == "www.example.com" );  // copied
+    assert( r->encoded_query() == "q=1" );             // referenced
+    @endcode
+
+    @note
+    The parts which are not copied reference
+    the buffers. Ownership of the underlying
+    character buffers is not transferred; the
+    caller is responsible for ensuring that
+    their lifetime extends until this object
+    is no longer in use.
+
+    @see
+        @ref parse_uri_reference_buffers,
+        @ref url_stream_parser.
+*/
+class url_pieces
+{
+    using part = url_stream_parser::part;
+
+    static constexpr std::size_t npart = 8;
+    static constexpr std::size_t npos =
+        std::size_t(-1);
+
+    // each part is at start_[i] in the URL,
+    // and refers into a buffer at ref_[i],
+    // or into buf_ at own_[i] if copied
+    std::size_t start_[npart] = {};
+    std::size_t len_[npart] = {};
+    char const* ref_[npart] = {};
+    std::size_t own_[npart] = {};
+    std::string buf_;
+
+    // chars of the URL seen by add
+    std::size_t pos_ = 0;
+
+    std::size_t size_ = 0;
+    std::uint16_t port_number_ = 0;
+    urls::host_type host_type_ =
+        urls::host_type::none;
+    urls::scheme scheme_ =
+        urls::scheme::none;
+    bool has_scheme_ = false;
+    bool has_authority_ = false;
+    bool has_port_ = false;
+    bool has_query_ = false;
+    bool has_fragment_ = false;
+
+    BOOST_URL_DECL
+    explicit
+    url_pieces(
+        url_stream_parser const& p);
+
+    BOOST_URL_DECL
+    void
+    add(string_view s);
+
+    BOOST_URL_DECL
+    string_view
+    get(part k) const noexcept;
+
+    template<class Buffers>
+    static
+    result<url_pieces>
+    parse(
+        Buffers const& buffers,
+        std::true_type);
+
+    template<class Buffer>
+    static
+    result<url_pieces>
+    parse(
+        Buffer const& buffer,
+        std::false_type);
+
+    template<class Buffers>
+    friend
+    result<url_pieces>
+    parse_uri_reference_buffers(
+        Buffers const& buffers);
+
+public:
+    /** Constructor
+
+        Default constructed objects hold
+        the empty URL.
+    */
+    url_pieces() = default;
+
+    /** Return the number of characters in the URL
+    */
+    std::size_t
+    size() const noexcept
+    {
+        return size_;
+    }
+
+    /** Return the number of characters copied
+
+        This is the total size of the parts
+        which straddle a buffer boundary, and
+        is zero when the URL is in one buffer.
+    */
+    std::size_t
+    copied() const noexcept
+    {
+        return buf_.size();
+    }
+
+    /** Return true if the URL has a scheme
+    */
+    bool
+    has_scheme() const noexcept
+    {
+        return has_scheme_;
+    }
+
+    /** Return the scheme
+    */
+    string_view
+    scheme() const noexcept
+    {
+        return get(part::scheme);
+    }
+
+    /** Return the scheme id
+    */
+    urls::scheme
+    scheme_id() const noexcept
+    {
+        return scheme_;
+    }
+
+    /** Return true if the URL has an authority
+    */
+    bool
+    has_authority() const noexcept
+    {
+        return has_authority_;
+    }
+
+    /** Return the user
+    */
+    string_view
+    encoded_user() const noexcept
+    {
+        return get(part::user);
+    }
+
+    /** Return the password
+    */
+    string_view
+    encoded_password() const noexcept
+    {
+        return get(part::password);
+    }
+
+    /** Return the host type
+    */
+    urls::host_type
+    host_type() const noexcept
+    {
+        return host_type_;
+    }
+
+    /** Return the host
+    */
+    string_view
+    encoded_host() const noexcept
+    {
+        return get(part::host);
+    }
+
+    /** Return true if the URL has a port
+    */
+    bool
+    has_port() const noexcept
+    {
+        return has_port_;
+    }
+
+    /** Return the port
+    */
+    string_view
+    port() const noexcept
+    {
+        return get(part::port);
+    }
+
+    /** Return the port number
+    */
+    std::uint16_t
+    port_number() const noexcept
+    {
+        return port_number_;
+    }
+
+    /** Return the path
+    */
+    string_view
+    encoded_path() const noexcept
+    {
+        return get(part::path);
+    }
+
+    /** Return true if the URL has a query
+    */
+    bool
+    has_query() const noexcept
+    {
+        return has_query_;
+    }
+
+    /** Return the query
+    */
+    string_view
+    encoded_query() const noexcept
+    {
+        return get(part::query);
+    }
+
+    /** Return true if the URL has a fragment
+    */
+    bool
+    has_fragment() const noexcept
+    {
+        return has_fragment_;
+    }
+
+    /** Return the fragment
+    */
+    string_view
+    encoded_fragment() const noexcept
+    {
+        return get(part::fragment);
+    }
+};
+
+//------------------------------------------------
+
+/** Parse a URI-reference held in a buffer sequence
+
+    This function parses the characters of
+    `buffers`, taken in order, as one string
+    according to the <em>URI-reference</em>
+    grammar. No buffer is copied, except for
+    the parts of the URL which straddle a
+    boundary between two buffers.
+
+    `Buffers` is either a single buffer, or a
+    range of buffers such as
+    `std::vector< boost::asio::const_buffer >`
+    or `std::array< string_view, N >`. A buffer
+    is an object `b` for which `b.data()` is a
+    pointer convertible to `void const*`, and
+    `b.size()` is the number of characters.
+
+    @par BNF
+    @code
+    URI-reference = URI / relative-ref
+    @endcode
+
+    @par Exception Safety
+    Strong guarantee.
+    Calls to allocate may throw.
+
+    @throw std::length_error The URL is longer
+    than @ref url_view::max_size.
+
+    @return A result containing the parsed URL,
+    or an error.
+
+    @param buffers The buffer sequence to parse.
+
+    @see
+        @ref url_pieces,
+        @ref parse_uri_reference.
+*/
+template<class Buffers>
+result<url_pieces>
+parse_uri_reference_buffers(
+    Buffers const& buffers);
+
+} // urls
+} // boost
+
+#include <boost/url/impl/url_pieces.hpp>
+
+#endif
@@ -0,0 +1,468 @@
+//
+// Copyright (c) 2019 Vinnie Falco (vinnie.falco@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/CPPAlliance/url
+//
+
+#ifndef BOOST_URL_URL_STREAM_PARSER_HPP
+#define BOOST_URL_URL_STREAM_PARSER_HPP
+
+#include <boost/url/detail/config.hpp>
+#include <boost/url/error.hpp>
+#include <boost/url/host_type.hpp>
+#include <boost/url/scheme.hpp>
+#include <boost/url/string.hpp>
+#include <boost/url/url_view.hpp>
+#include <boost/url/detail/parts_base.hpp>
+#include <cstddef>
+#include <cstdint>
+
+namespace boost {
+namespace urls {
+
+/** A parser for URI-references received in pieces
+
+    Objects of this type parse a string
+    according to the <em>URI-reference</em>
+    grammar when the characters arrive in
+    any number of pieces, such as the
+    request-target of an HTTP request read
+    from a socket. Each character is examined
+    once, when it is written, and the parser
+    keeps just enough state to resume with
+    the next piece. No piece is copied,
+    except for the at most 48 characters of
+    an IPv6 address, which are checked at
+    the closing bracket.
+
+    The end of the URL is found either when
+    @ref finish is called, or when a character
+    is written which cannot continue it, such
+    as the space after the request-target.
+    After that, @ref done returns `true` and
+    the offsets of the parts are available.
+
+    @par Example
+    @code
+    url_stream_parser p;
+    error_code ec;
+    for(;;)
+    {
+        string_view s = read_some( sock );
+        std::size_t n = p.write_some( s, ec );
+        if( ec )
+            return ec;
+        if( p.done() )
+        {
+            // s[n] is the first character after the URL
+            break;
+        }
+    }
+    std::size_t n = p.length( url_stream_parser::part::path );
+    @endcode
+
+    @par BNF
+    @code
+    URI-reference = URI / relative-ref
+    @endcode
+
+    @see
+        @ref parse_uri_reference.
+*/
+class url_stream_parser
+    : private detail::parts_base
+{
+    friend class url_editor;
+
+    enum state : unsigned char
+    {
+        st_start,
+        st_done,
+        st_error,
+        st_scheme,
+        st_noscheme,
+        st_after_scheme,
+        st_rootless,
+        st_slash,
+        st_auth,
+        st_path,
+        st_query,
+        st_frag
+    };
+
+    // the parts, as in url_view
+    pos_t offset_[id_end + 1];
+    pos_t decoded_[id_end];
+    pos_t nseg_;
+    pos_t nparam_;
+    unsigned char ip_addr_[16];
+    std::uint16_t port_number_;
+    urls::host_type host_type_;
+    urls::scheme scheme_;
+    error_code ec_;
+
+    // chars consumed
+    std::size_t n_;
+    state st_;
+
+    // hex digits left in an escape
+    unsigned char pct_;
+
+    // the scheme, and the start
+    // of the path, which decide
+    // the segment count
+    char scheme_buf_[8];
+    unsigned char scheme_n_;
+    char path_buf_[3];
+    unsigned char path_n_;
+
+    // the authority is scanned once
+    // as both userinfo and host, until
+    // an '@' or a char which ends it
+    bool has_auth_;
+    bool has_userinfo_;
+    bool user_ok_;
+    unsigned char hp_;
+    std::size_t auth_;
+    std::size_t host_;
+    std::size_t colon_;
+    std::size_t esc_[2];
+    unsigned char ip4_;
+    unsigned char ip4_idx_;
+    unsigned char ip4_digits_;
+    unsigned ip4_val_;
+    unsigned char ip4_buf_[4];
+    std::uint16_t port_;
+    bool port_ovf_;
+    unsigned char lit_;
+    unsigned char lit_n_;
+    char lit_buf_[49];
+
+    std::size_t fail(
+        char const* p,
+        char const* data,
+        error_code& ec,
+        error e) noexcept;
+    std::size_t stop(
+        char const* p,
+        char const* data,
+        error_code& ec) noexcept;
+    void add_scheme(
+        char const* first,
+        char const* last) noexcept;
+    void add_path(
+        char const* first,
+        char const* last) noexcept;
+    bool accepting() const noexcept;
+    void begin_host(
+        std::size_t pos) noexcept;
+    void begin_port(
+        std::size_t pos) noexcept;
+    bool host_char(
+        char c,
+        std::size_t pos) noexcept;
+    bool ip4_char(char c) noexcept;
+    bool literal_char(char c) noexcept;
+    void end_authority(
+        std::size_t pos) noexcept;
+    void end_url(
+        std::size_t pos) noexcept;
+
+public:
+    /** Identifies a part of the URL
+
+        @see
+            @ref offset,
+            @ref length.
+    */
+    enum class part
+    {
+        /// The scheme, without the colon
+        scheme,
+
+        /// The user, without the leading "//"
+        user,
+
+        /// The password, without the colon and '@'
+        password,
+
+        /// The host
+        host,
+
+        /// The port, without the colon
+        port,
+
+        /// The path
+        path,
+
+        /// The query, without the question mark
+        query,
+
+        /// The fragment, without the hash
+        fragment
+    };
+
+    /** Constructor
+
+        Default-constructed parsers are ready
+        to receive the first character of a URL.
+    */
+    BOOST_URL_DECL
+    url_stream_parser() noexcept;
+
+    /** Prepare to parse a new URL
+
+        Any previous state and error are
+        discarded.
+    */
+    BOOST_URL_DECL
+    void
+    reset() noexcept;
+
+    /** Return true if a complete URL was parsed
+    */
+    bool
+    done() const noexcept
+    {
+        return st_ == st_done;
+    }
+
+    /** Return the number of characters consumed
+
+        When @ref done returns `true`, this is
+        the size of the URL.
+    */
+    std::size_t
+    size() const noexcept
+    {
+        return n_;
+    }
+
+    /** Parse some characters
+
+        Characters are consumed from the beginning
+        of the buffer until the end, or until a
+        character which cannot continue the URL.
+        In the latter case, the URL before that
+        character is complete, and @ref done
+        returns `true`.
+
+        @par Exception Safety
+        Basic guarantee.
+
+        @return The number of characters consumed.
+
+        @param data A pointer to the characters.
+
+        @param size The number of characters.
+
+        @param ec Set to the error, if any occurred.
+        Errors are final; later calls set the same
+        error until the parser is reset.
+
+        @throw std::length_error The URL is longer
+        than @ref url_view::max_size.
+    */
+    BOOST_URL_DECL
+    std::size_t
+    write_some(
+        char const* data,
+        std::size_t size,
+        error_code& ec);
+
+    /** Parse some characters
+
+        @see @ref write_some.
+    */
+    std::size_t
+    write_some(
+        string_view s,
+        error_code& ec)
+    {
+        return write_some(
+            s.data(), s.size(), ec);
+    }
+
+    /** Parse all of the characters
+
+        This function is like @ref write_some,
+        except that every character must be
+        consumed, or else the error is
+        @ref error::leftover_input.
+
+        @par Exception Safety
+        Basic guarantee.
+
+        @return The number of characters consumed.
+
+        @param data A pointer to the characters.
+
+        @param size The number of characters.
+
+        @param ec Set to the error, if any occurred.
+
+        @throw std::length_error The URL is longer
+        than @ref url_view::max_size.
+    */
+    BOOST_URL_DECL
+    std::size_t
+    write(
+        char const* data,
+        std::size_t size,
+        error_code& ec);
+
+    /** Parse all of the characters
+
+        @see @ref write.
+    */
+    std::size_t
+    write(
+        string_view s,
+        error_code& ec)
+    {
+        return write(
+            s.data(), s.size(), ec);
+    }
+
+    /** Indicate the end of the URL
+
+        This tells the parser that no characters
+        follow those written. Upon success,
+        @ref done returns `true`.
+
+        @par Exception Safety
+        Throws nothing.
+
+        @param ec Set to the error, if any occurred.
+    */
+    BOOST_URL_DECL
+    void
+    finish(error_code& ec) noexcept;
+
+    /** Return the offset of a part
+
+        This returns the offset of the first
+        character of the part from the first
+        character of the URL. When the part is
+        absent, this is where it would be.
+
+        @par Preconditions
+        @code
+        this->done()
+        @endcode
+    */
+    BOOST_URL_DECL
+    std::size_t
+    offset(part p) const noexcept;
+
+    /** Return the number of characters in a part
+
+        @par Preconditions
+        @code
+        this->done()
+        @endcode
+    */
+    BOOST_URL_DECL
+    std::size_t
+    length(part p) const noexcept;
+
+    /** Return true if the URL has a scheme
+    */
+    bool
+    has_scheme() const noexcept
+    {
+        return offset_[id_user] != 0;
+    }
+
+    /** Return the scheme id
+
+        @see @ref url_view::scheme_id.
+    */
+    urls::scheme
+    scheme_id() const noexcept
+    {
+        return scheme_;
+    }
+
+    /** Return true if the URL has an authority
+    */
+    bool
+    has_authority() const noexcept
+    {
+        return offset_[id_pass] !=
+            offset_[id_user];
+    }
+
+    /** Return the host type
+
+        @see @ref url_view::host_type.
+    */
+    urls::host_type
+    host_type() const noexcept
+    {
+        return host_type_;
+    }
+
+    /** Return true if the URL has a port
+    */
+    bool
+    has_port() const noexcept
+    {
+        return offset_[id_path] !=
+            offset_[id_port];
+    }
+
+    /** Return the port number
+
+        @see @ref url_view::port_number.
+    */
+    std::uint16_t
+    port_number() const noexcept
+    {
+        return port_number_;
+    }
+
+    /** Return true if the URL has a query
+    */
+    bool
+    has_query() const noexcept
+    {
+        return offset_[id_frag] !=
+            offset_[id_query];
+    }
+
+    /** Return true if the URL has a fragment
+    */
+    bool
+    has_fragment() const noexcept
+    {
+        return offset_[id_end] !=
+            offset_[id_frag];
+    }
+
+    /** Return a view of the parsed URL
+
+        This returns a view referencing `s`,
+        which must hold the characters that were
+        written, for example after the pieces
+        were received into one buffer. The view
+        is built from the state of the parser
+        without examining the characters again.
+
+        @par Preconditions
+        @code
+        this->done() && s.size() == this->size()
+        @endcode
+    */
+    BOOST_URL_DECL
+    url_view
+    view(string_view s) const noexcept;
+};
+
+} // urls
+} // boost
+
+#endif
@@ -0,0 +1,529 @@
+//
+// Copyright (c) 2019 Vinnie Falco (vinnie.falco@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/CPPAlliance/url
+//
+
+#ifndef BOOST_URL_URL_TABLE_HPP
+#define BOOST_URL_URL_TABLE_HPP
+
+#include <boost/url/detail/config.hpp>
+#include <boost/url/error.hpp>
+#include <boost/url/host_type.hpp>
+#include <boost/url/scheme.hpp>
+#include <boost/url/string.hpp>
+#include <boost/url/url_view.hpp>
+#include <boost/url/detail/parts_base.hpp>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace boost {
+namespace urls {
+
+/** Options for parsing lines in parallel
+
+    @see
+        @ref parse_uri_reference_lines.
+*/
+struct parse_lines_opts
+{
+    /** The number of threads to use
+
+        The calling thread is one of them.
+        Zero means the number of hardware
+        threads.
+    */
+    std::size_t threads = 0;
+
+    /** The number of bytes in one unit of work
+
+        The input is split into chunks of about
+        this size, ending on line boundaries,
+        which idle threads steal from the busy
+        ones.
+    */
+    std::size_t chunk_size = 64 * 1024;
+};
+
+/** The work done by one thread when parsing lines
+
+    @see
+        @ref parse_uri_reference_lines.
+*/
+struct parse_lines_stats
+{
+    /** The number of lines parsed
+    */
+    std::size_t lines = 0;
+
+    /** The number of bytes in the chunks parsed
+    */
+    std::size_t bytes = 0;
+
+    /** The number of chunks parsed
+    */
+    std::size_t chunks = 0;
+
+    /** The number of times chunks were stolen
+    */
+    std::size_t steals = 0;
+
+    /** The time spent parsing
+    */
+    std::chrono::nanoseconds elapsed =
+        std::chrono::nanoseconds::zero();
+};
+
+/** A table of parsed URLs stored by column
+
+    Objects of this type hold the results of
+    parsing many strings at once with
+    @ref parse_uri_reference. Each string
+    occupies one row, and each property of
+    the rows, such as the scheme, the host
+    type, the port number, or the offsets of
+    the parts, is stored in its own contiguous
+    array. Loops which filter rows on one
+    property only touch the memory of that
+    property, and not the characters of the
+    strings.
+
+    Rows which failed to parse hold the error,
+    an empty scheme and host, and parts which
+    are all empty.
+
+    @par Example
+    @code
+    std::vector< string_view > v = lines();
+    url_table t;
+    parse_uri_reference( v.data(), v.size(), t );
+
+    std::size_t n = 0;
+    for( std::size_t i = 0; i < t.size(); ++i )
+        if( t.scheme_id( i ) == scheme::https &&
+            t.host_type( i ) == host_type::ipv4 )
+            ++n;
+    @endcode
+
+    @note
+    The strings are referenced, not copied.
+    Ownership of the underlying character
+    buffers is not transferred; the caller
+    is responsible for ensuring that their
+    lifetime extends until the table is
+    cleared, refilled, or destroyed.
+
+    @see
+        @ref parse_uri_reference.
+*/
+class url_table
+    : private detail::parts_base
+{
+    // offsets fit in 32 bits,
+    // see BOOST_URL_MAX_SIZE
+    using pos32_t = std::uint32_t;
+
+    std::vector<string_view> s_;
+    std::vector<error_code> ec_;
+    std::vector<urls::scheme> scheme_;
+    std::vector<urls::host_type> host_type_;
+    std::vector<std::uint16_t> port_number_;
+    std::vector<pos32_t> nseg_;
+    std::vector<pos32_t> nparam_;
+    std::vector<pos32_t> offset_[id_end + 1];
+
+    string_view
+    get(std::size_t i, int first,
+        int last) const noexcept
+    {
+        auto const p0 = first < 0 ?
+            0 : offset_[first][i];
+        return s_[i].substr(p0,
+            offset_[last][i] - p0);
+    }
+
+    void resize(std::size_t n);
+    std::size_t parse_rows(
+        std::size_t first,
+        std::size_t last) noexcept;
+
+    friend
+    BOOST_URL_DECL
+    std::size_t
+    parse_uri_reference(
+        string_view const* v,
+        std::size_t n,
+        url_table& t);
+
+    friend
+    BOOST_URL_DECL
+    std::size_t
+    parse_uri_reference_lines(
+        string_view s,
+        url_table& t,
+        parse_lines_opts const& opt,
+        std::vector<parse_lines_stats>* stats);
+
+public:
+    /** Constructor
+
+        Default-constructed tables are empty.
+    */
+    url_table() = default;
+
+    /** Return the number of rows
+    */
+    std::size_t
+    size() const noexcept
+    {
+        return s_.size();
+    }
+
+    /** Return true if there are no rows
+    */
+    bool
+    empty() const noexcept
+    {
+        return s_.empty();
+    }
+
+    /** Remove all rows
+
+        The capacity is kept, so refilling
+        the table with no more rows than
+        before does not allocate.
+    */
+    BOOST_URL_DECL
+    void
+    clear() noexcept;
+
+    /** Allocate space for at least `n` rows
+
+        @par Exception Safety
+        Strong guarantee.
+        Calls to allocate may throw.
+    */
+    BOOST_URL_DECL
+    void
+    reserve(std::size_t n);
+
+    /** Return the string parsed into row `i`
+    */
+    string_view
+    string(std::size_t i) const noexcept
+    {
+        return s_[i];
+    }
+
+    /** Return the result of parsing row `i`
+
+        The returned error code indicates
+        success if the string is a valid
+        <em>URI-reference</em>.
+    */
+    error_code
+    error(std::size_t i) const noexcept
+    {
+        return ec_[i];
+    }
+
+    /** Return a view of the URL in row `i`
+
+        The view references the string in the
+        row, which is parsed again to obtain
+        the properties which are not stored in
+        the table, such as decoded sizes and
+        IP addresses.
+
+        @par Preconditions
+        @code
+        ! this->error( i )
+        @endcode
+    */
+    BOOST_URL_DECL
+    url_view
+    view(std::size_t i) const noexcept;
+
+    /** Return the scheme of row `i`
+
+        @see @ref url_view::scheme.
+    */
+    string_view
+    scheme(std::size_t i) const noexcept
+    {
+        auto s = get(i, id_scheme, id_user);
+        if(! s.empty())
+            s.remove_suffix(1);
+        return s;
+    }
+
+    /** Return the scheme id of row `i`
+
+        @see @ref url_view::scheme_id.
+    */
+    urls::scheme
+    scheme_id(std::size_t i) const noexcept
+    {
+        return scheme_[i];
+    }
+
+    /** Return true if row `i` has an authority
+
+        @see @ref url_view::has_authority.
+    */
+    bool
+    has_authority(std::size_t i) const noexcept
+    {
+        return offset_[id_pass][i] !=
+            offset_[id_user][i];
+    }
+
+    /** Return the host type of row `i`
+
+        @see @ref url_view::host_type.
+    */
+    urls::host_type
+    host_type(std::size_t i) const noexcept
+    {
+        return host_type_[i];
+    }
+
+    /** Return the host of row `i`
+
+        @see @ref url_view::encoded_host.
+    */
+    string_view
+    encoded_host(std::size_t i) const noexcept
+    {
+        return get(i, id_host, id_port);
+    }
+
+    /** Return true if row `i` has a port
+
+        @see @ref url_view::has_port.
+    */
+    bool
+    has_port(std::size_t i) const noexcept
+    {
+        return offset_[id_path][i] !=
+            offset_[id_port][i];
+    }
+
+    /** Return the port number of row `i`
+
+        @see @ref url_view::port_number.
+    */
+    std::uint16_t
+    port_number(std::size_t i) const noexcept
+    {
+        return port_number_[i];
+    }
+
+    /** Return the path of row `i`
+
+        @see @ref url_view::encoded_path.
+    */
+    string_view
+    encoded_path(std::size_t i) const noexcept
+    {
+        return get(i, id_path, id_query);
+    }
+
+    /** Return the number of path segments of row `i`
+
+        @see @ref url_view::segments.
+    */
+    std::size_t
+    segment_count(std::size_t i) const noexcept
+    {
+        return nseg_[i];
+    }
+
+    /** Return true if row `i` has a query
+
+        @see @ref url_view::has_query.
+    */
+    bool
+    has_query(std::size_t i) const noexcept
+    {
+        return offset_[id_frag][i] !=
+            offset_[id_query][i];
+    }
+
+    /** Return the query of row `i`
+
+        @see @ref url_view::encoded_query.
+    */
+    string_view
+    encoded_query(std::size_t i) const noexcept
+    {
+        auto s = get(i, id_query, id_frag);
+        if(! s.empty())
+            s.remove_prefix(1);
+        return s;
+    }
+
+    /** Return the number of query params of row `i`
+
+        @see @ref url_view::params.
+    */
+    std::size_t
+    param_count(std::size_t i) const noexcept
+    {
+        return nparam_[i];
+    }
+
+    /** Return true if row `i` has a fragment
+
+        @see @ref url_view::has_fragment.
+    */
+    bool
+    has_fragment(std::size_t i) const noexcept
+    {
+        return offset_[id_end][i] !=
+            offset_[id_frag][i];
+    }
+
+    /** Return the fragment of row `i`
+
+        @see @ref url_view::encoded_fragment.
+    */
+    string_view
+    encoded_fragment(std::size_t i) const noexcept
+    {
+        auto s = get(i, id_frag, id_end);
+        if(! s.empty())
+            s.remove_prefix(1);
+        return s;
+    }
+};
+
+//------------------------------------------------
+
+/** Parse many URI-references into a table
+
+    Each of the `n` strings starting at `v` is
+    parsed according to the <em>URI-reference</em>
+    grammar, and the result is written to the
+    row with the same index in `t`, replacing
+    its previous contents. No @ref url_view or
+    result is produced for the strings, and no
+    memory is allocated when the capacity of
+    `t` is sufficient.
+
+    @par Example
+    @code
+    url_table t;
+    for( auto const& batch : batches )
+    {
+        // reuses the capacity of t
+        parse_uri_reference( batch.data(), batch.size(), t );
+        ...
+    }
+    @endcode
+
+    @par Exception Safety
+    Basic guarantee.
+    Calls to allocate may throw.
+
+    @return The number of strings which
+    were parsed successfully.
+
+    @param v A pointer to the first string.
+
+    @param n The number of strings.
+
+    @param t The table to write to.
+
+    @throw std::length_error A string is longer
+    than @ref url_view::max_size.
+
+    @see
+        @ref url_table.
+*/
+BOOST_URL_DECL
+std::size_t
+parse_uri_reference(
+    string_view const* v,
+    std::size_t n,
+    url_table& t);
+
+/** Parse the lines of a buffer into a table, in parallel
+
+    The string `s` is treated as a sequence of
+    lines separated by LF ('\n'), such as a
+    log file mapped into memory. Each line,
+    without the LF and any CR ('\r') before
+    it, is parsed according to the
+    <em>URI-reference</em> grammar and written
+    to the next row of `t`, replacing its
+    previous contents. Rows are in the same
+    order as the lines. A last line without a
+    terminating LF is included if it is not
+    empty.
+
+    The buffer is split into chunks which are
+    first spread evenly over the threads. A
+    thread which runs out of chunks steals
+    half of the remaining chunks of the
+    busiest thread, so the threads finish
+    at about the same time even when the
+    lines are not uniform.
+
+    @par Example
+    @code
+    string_view log = map_file( "access.log" );
+    url_table t;
+    std::vector< parse_lines_stats > stats;
+    parse_uri_reference_lines( log, t, {}, &stats );
+    for( auto const& st : stats )
+        std::cout << st.bytes * 1e3 / st.elapsed.count() << " MB/s\n";
+    @endcode
+
+    @par Exception Safety
+    Basic guarantee.
+    Calls to allocate may throw. When a
+    thread cannot be created, the work is
+    done by the threads which were.
+
+    @return The number of lines which
+    were parsed successfully.
+
+    @param s The lines to parse.
+
+    @param t The table to write to.
+
+    @param opt The options to use.
+
+    @param stats If not null, the vector
+    is resized to the number of threads used
+    and element `i` is set to the work done
+    by thread `i`, where thread 0 is the
+    calling thread.
+
+    @throw std::length_error A line is longer
+    than @ref url_view::max_size, or there are
+    too many chunks.
+
+    @see
+        @ref parse_lines_opts,
+        @ref parse_lines_stats,
+        @ref url_table.
+*/
+BOOST_URL_DECL
+std::size_t
+parse_uri_reference_lines(
+    string_view s,
+    url_table& t,
+    parse_lines_opts const& opt = {},
+    std::vector<parse_lines_stats>* stats = nullptr);
+
+} // urls
+} // boost
+
+#endif
@@ -40,6 +40,9 @@ struct host_bnf;
 struct parsed_path;
 struct query_part_bnf;
 struct scheme_part_bnf;
+class url_literal;
+class url_stream_parser;
+class url_table;
 #endif
 
 /** A read-only view to a URL
@@ -110,7 +113,13 @@ protected:
         urls::scheme::none;
 
     friend class url;
+    friend class resolver;
     friend class static_url_base;
+    friend class url_builder;
+    friend class url_editor;
+    friend class url_literal;
+    friend class url_stream_parser;
+    friend class url_table;
     struct shared_impl;
 
     inline url_view& base() noexcept;
@@ -412,6 +421,9 @@ public:
         }
         std::cout << *sp; // works
         @endcode
+
+        @see
+            @ref shared_url.
     */
     BOOST_URL_DECL
     std::shared_ptr<
@@ -1715,6 +1727,9 @@ private:
     void apply(parsed_path const& path) noexcept;
     void apply(query_part_bnf const& t) noexcept;
     void apply(fragment_part_bnf const& t) noexcept;
+
+    bool parse_http(string_view s) noexcept;
+    bool parse_reference(string_view s) noexcept;
 };
 
 //------------------------------------------------
@@ -0,0 +1,145 @@
+//
+// Copyright (c) 2019 Vinnie Falco (vinnie.falco@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/CPPAlliance/url
+//
+
+#ifndef BOOST_URL_VALIDATE_HPP
+#define BOOST_URL_VALIDATE_HPP
+
+#include <boost/url/detail/config.hpp>
+#include <boost/url/error.hpp>
+#include <boost/url/string.hpp>
+#include <cstddef>
+
+namespace boost {
+namespace urls {
+
+/** Check a string against the URI grammar
+
+    This function returns success for exactly
+    the strings accepted by @ref parse_uri,
+    without producing a @ref url_view. Nothing
+    is stored: the parts are not measured,
+    segments and params are not counted, and
+    IP addresses are checked but not kept.
+
+    When the string is invalid, the error
+    is one of the following, and the return
+    value is the offset of the character
+    where it was found:
+
+    @li @ref error::bad_pct_hexdig or
+        @ref error::incomplete_pct_encoding
+        for a percent-encoded octet,
+
+    @li the error of the grammar, for an
+        IP-literal,
+
+    @li @ref error::leftover_input for a
+        character which cannot follow the
+        valid characters before it,
+
+    @li @ref error::syntax otherwise.
+
+    @par Example
+    @code
+    error_code ec;
+    std::size_t n = validate_uri( "http://a b", ec );
+    assert( ec == error::leftover_input && n == 8 );
+    @endcode
+
+    @par Exception Safety
+    Throws nothing.
+
+    @return The size of the string on success,
+    otherwise the offset of the error.
+
+    @param s The string to check.
+
+    @param ec Set to the error, if any occurred.
+
+    @see
+        @ref parse_uri,
+        @ref validate_relative_ref,
+        @ref validate_uri_reference.
+*/
+BOOST_URL_DECL
+std::size_t
+validate_uri(
+    string_view s,
+    error_code& ec) noexcept;
+
+/** Check a string against the relative-ref grammar
+
+    This function returns success for exactly
+    the strings accepted by
+    @ref parse_relative_ref, without producing
+    a @ref url_view. The errors are those of
+    @ref validate_uri.
+
+    @par Exception Safety
+    Throws nothing.
+
+    @return The size of the string on success,
+    otherwise the offset of the error.
+
+    @param s The string to check.
+
+    @param ec Set to the error, if any occurred.
+
+    @see
+        @ref parse_relative_ref,
+        @ref validate_uri,
+        @ref validate_uri_reference.
+*/
+BOOST_URL_DECL
+std::size_t
+validate_relative_ref(
+    string_view s,
+    error_code& ec) noexcept;
+
+/** Check a string against the URI-reference grammar
+
+    This function returns success for exactly
+    the strings accepted by
+    @ref parse_uri_reference, without producing
+    a @ref url_view. The errors are those of
+    @ref validate_uri.
+
+    @par Example
+    @code
+    error_code ec;
+    validate_uri_reference( request_target, ec );
+    if( ec )
+        return reject( ec );
+    @endcode
+
+    @par Exception Safety
+    Throws nothing.
+
+    @return The size of the string on success,
+    otherwise the offset of the error.
+
+    @param s The string to check.
+
+    @param ec Set to the error, if any occurred.
+
+    @see
+        @ref parse_uri_reference,
+        @ref validate_relative_ref,
+        @ref validate_uri.
+*/
+BOOST_URL_DECL
+std::size_t
+validate_uri_reference(
+    string_view s,
+    error_code& ec) noexcept;
+
+} // urls
+} // boost
+
+#endif
@@ -0,0 +1,207 @@
+//
+// Copyright (c) 2019 Vinnie Falco (vinnie.falco@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/CPPAlliance/url
+//
+
+// Test that header file is self-contained.
+#include <boost/url/basic_url.hpp>
+
+#include <boost/url/static_pool.hpp>
+#include <boost/url/url_view.hpp>
+#include "test_suite.hpp"
+#include <stdexcept>
+
+namespace boost {
+namespace urls {
+
+class basic_url_test
+{
+public:
+    // counts the bytes outstanding
+    template<class T>
+    struct counting_allocator
+    {
+        using value_type = T;
+
+        std::size_t* n;
+
+        explicit
+        counting_allocator(
+            std::size_t& n_) noexcept
+            : n(&n_)
+        {
+        }
+
+        template<class U>
+        counting_allocator(
+            counting_allocator<U> const& other) noexcept
+            : n(other.n)
+        {
+        }
+
+        T*
+        allocate(std::size_t count)
+        {
+            *n += count * sizeof(T);
+            return std::allocator<T>{}.allocate(count);
+        }
+
+        void
+        deallocate(T* p, std::size_t count) noexcept
+        {
+            BOOST_TEST(*n >= count * sizeof(T));
+            *n -= count * sizeof(T);
+            std::allocator<T>{}.deallocate(p, count);
+        }
+
+        template<class U>
+        bool
+        operator==(counting_allocator<
+            U> const& other) const noexcept
+        {
+            return n == other.n;
+        }
+
+        template<class U>
+        bool
+        operator!=(counting_allocator<
+            U> const& other) const noexcept
+        {
+            return n != other.n;
+        }
+    };
+
+    using url_t = basic_url<
+        counting_allocator<char>>;
+
+    void
+    testAllocator()
+    {
+        std::size_t n = 0;
+        counting_allocator<char> a(n);
+
+        // default ctor
+        {
+            url_t u(a);
+            BOOST_TEST(*u.c_str() == '\0');
+            BOOST_TEST(u.capacity_in_bytes() == 0);
+            BOOST_TEST(n == 0);
+            BOOST_TEST(u.get_allocator() == a);
+        }
+
+        // growth
+        {
+            url_t u(a);
+            u.set_scheme("http");
+            u.set_encoded_host("www.example.com");
+            BOOST_TEST(n == u.capacity_in_bytes());
+            for(int i = 0; i < 50; ++i)
+                u.segments().push_back("path");
+            u.params().emplace_back("k", "v");
+            BOOST_TEST(n == u.capacity_in_bytes());
+            BOOST_TEST(u.segments().size() == 50);
+            BOOST_TEST(u.encoded_query() == "k=v");
+            BOOST_TEST(u.string().substr(0, 28) ==
+                "http://www.example.com/path/");
+        }
+        BOOST_TEST(n == 0);
+
+        // string ctor
+        {
+            url_t u("http://example.com/a?b#c", a);
+            BOOST_TEST(u.encoded_host() == "example.com");
+            BOOST_TEST(u.encoded_fragment() == "c");
+            BOOST_TEST(n == u.capacity_in_bytes());
+            BOOST_TEST_THROWS(url_t("http://a b", a),
+                std::invalid_argument);
+        }
+        BOOST_TEST(n == 0);
+
+        // copy and move
+        {
+            url_view const v =
+                parse_uri("http://example.com/a/b").value();
+            url_t u0(v, a);
+            url_t u1(u0);
+            BOOST_TEST(u1.string() == v.string());
+            BOOST_TEST(n ==
+                u0.capacity_in_bytes() +
+                u1.capacity_in_bytes());
+
+            url_t u2(std::move(u1));
+            BOOST_TEST(u2.string() == v.string());
+            BOOST_TEST(u1.string().empty());
+            BOOST_TEST(u1.capacity_in_bytes() == 0);
+
+            url_t u3(a);
+            u3 = std::move(u2);
+            BOOST_TEST(u3.string() == v.string());
+            BOOST_TEST(u2.string().empty());
+
+            u2 = u3;
+            BOOST_TEST(u2.string() == v.string());
+            u2 = u2;
+            BOOST_TEST(u2.string() == v.string());
+            u2 = parse_relative_ref("/x").value();
+            BOOST_TEST(u2.string() == "/x");
+
+            // unequal allocators copy
+            std::size_t n2 = 0;
+            url_t u4(counting_allocator<char>{n2});
+            u4 = std::move(u3);
+            BOOST_TEST(u4.string() == v.string());
+            BOOST_TEST(n2 == u4.capacity_in_bytes());
+            BOOST_TEST(u3.string().empty());
+
+            url u5 = u4;
+            BOOST_TEST(u5.string() == v.string());
+        }
+        BOOST_TEST(n == 0);
+    }
+
+    void
+    testPool()
+    {
+        static_pool<4096> pool;
+        using alloc_t = static_pool<
+            4096>::allocator_type<char>;
+        basic_url<alloc_t> u(
+            "https://www.example.com/index.htm",
+            pool.allocator());
+        u.set_encoded_query("q=1");
+        BOOST_TEST(u.string() ==
+            "https://www.example.com/index.htm?q=1");
+        BOOST_TEST(u.get_allocator() ==
+            pool.allocator());
+    }
+
+    void
+    testDefault()
+    {
+        basic_url<> u("/a/b/c");
+        BOOST_TEST(u.segments().size() == 3);
+        basic_url<> u2 = u;
+        u2.segments().push_back("d");
+        BOOST_TEST(u2.string() == "/a/b/c/d");
+        BOOST_TEST(u.string() == "/a/b/c");
+    }
+
+    void
+    run()
+    {
+        testAllocator();
+        testPool();
+        testDefault();
+    }
+};
+
+TEST_SUITE(
+    basic_url_test,
+    "boost.url.basic_url");
+
+} // urls
+} // boost
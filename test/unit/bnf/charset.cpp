@@ -13,6 +13,7 @@
 #include <boost/url/string.hpp>
 #include "test_suite.hpp"
 #include "test_bnf.hpp"
+#include <cstring>
 
 namespace boost {
 namespace urls {
@@ -136,10 +137,80 @@ public:
         }
     }
 
+    // exercise the vectorized paths
+    // against a plain loop, for every
+    // length and match position.
+    void
+    test_lut_find()
+    {
+        auto const check = [](
+            lut_chars const& cs,
+            char in,
+            char out)
+        {
+            char buf[100];
+            for(std::size_t n = 0;
+                n <= sizeof(buf); ++n)
+            {
+                for(std::size_t i = 0;
+                    i <= n; ++i)
+                {
+                    std::memset(buf, in, n);
+                    if(i < n)
+                        buf[i] = out;
+                    BOOST_TEST(find_if_not(
+                        buf, buf + n, cs) ==
+                            buf + i);
+                    std::memset(buf, out, n);
+                    if(i < n)
+                        buf[i] = in;
+                    BOOST_TEST(find_if(
+                        buf, buf + n, cs) ==
+                            buf + i);
+                }
+            }
+        };
+
+        constexpr lut_chars cs1 =
+            "ABCDEFGHIJKLMNOPQRSTUVWXYZ"
+            "abcdefghijklmnopqrstuvwxyz"
+            "0123456789" "-._~";
+        check(cs1, 'a', '%');
+        check(cs1, '~', '\x80');
+        check(cs1, '0', '\0');
+
+        constexpr lut_chars cs2 =
+            ~lut_chars("\x7f\x80");
+        check(cs2, '\xff', '\x80');
+        check(cs2, '\x81', '\x7f');
+        check(cs2, '\0', '\x80');
+
+        // every char as the only member
+        for_each_char(
+        [](char c)
+        {
+            lut_chars const cs(c);
+            char buf[48];
+            std::memset(buf,
+                static_cast<char>(c ^ 1),
+                sizeof(buf));
+            buf[37] = c;
+            BOOST_TEST(find_if(buf,
+                buf + sizeof(buf), cs) ==
+                    buf + 37);
+            std::memset(buf, c, sizeof(buf));
+            buf[21] = static_cast<char>(c ^ 1);
+            BOOST_TEST(find_if_not(buf,
+                buf + sizeof(buf), cs) ==
+                    buf + 21);
+        });
+    }
+
     void
     run()
     {
         test_lut_chars();
+        test_lut_find();
 
         std::size_t n0 = 0;
         std::size_t n1 = 0;
@@ -0,0 +1,70 @@
+//
+// Copyright (c) 2019 Vinnie Falco (vinnie.falco@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/CPPAlliance/url
+//
+
+// Test that header file is self-contained.
+#include <boost/url/parse_stats.hpp>
+
+#include <boost/url/url_view.hpp>
+#include "test_suite.hpp"
+
+namespace boost {
+namespace urls {
+
+class parse_stats_test
+{
+public:
+    void
+    testCounts()
+    {
+        reset_parse_stats();
+        auto st = get_parse_stats();
+        BOOST_TEST(st.fast == 0);
+        BOOST_TEST(st.general == 0);
+
+        // fast path
+        parse_uri_reference("http://example.com");
+        parse_uri_reference("https://h:443/a?b#c");
+        url_view("http://h/%41");
+
+        // general parser
+        parse_uri_reference("http://1.2.3.4/");
+        parse_uri_reference("http://u@h/");
+        parse_uri_reference("https://[::1]/");
+        parse_uri_reference("HTTP://h/");
+        parse_uri_reference("ftp://h/");
+        parse_uri_reference("/path");
+        parse_uri_reference("http://h/%zz");
+
+        st = get_parse_stats();
+#ifdef BOOST_URL_PARSE_STATS
+        BOOST_TEST(st.fast == 3);
+        BOOST_TEST(st.general == 7);
+#else
+        BOOST_TEST(st.fast == 0);
+        BOOST_TEST(st.general == 0);
+#endif
+        reset_parse_stats();
+        st = get_parse_stats();
+        BOOST_TEST(st.fast == 0);
+        BOOST_TEST(st.general == 0);
+    }
+
+    void
+    run()
+    {
+        testCounts();
+    }
+};
+
+TEST_SUITE(
+    parse_stats_test,
+    "boost.url.parse_stats");
+
+} // urls
+} // boost
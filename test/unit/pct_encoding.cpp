@@ -12,7 +12,9 @@
 
 #include <boost/url/static_pool.hpp>
 #include "test_suite.hpp"
+#include <cstring>
 #include <memory>
+#include <string>
 
 namespace boost {
 namespace urls {
@@ -98,6 +100,17 @@ public:
                     break;
                 }
             }
+            // pct_decode in place
+            {
+                std::string s(s0);
+                error_code ec;
+                auto const n = pct_decode(
+                    &s[0], &s[0] + s.size(),
+                        s, ec, opt, *pcs);
+                BOOST_TEST(! ec.failed());
+                BOOST_TEST(
+                    string_view(s.data(), n) == s1);
+            }
             // pct_decode() -> std::string
             {
                 std::string s = pct_decode(
@@ -163,10 +176,34 @@ public:
             // pct_decode to buffer
             {
                 char buf[16];
+                for(std::size_t i = 0;
+                    i < sizeof(buf); ++i)
+                {
+                    // invalid input is reported
+                    // before insufficient space
+                    std::memset(buf, '*',
+                        sizeof(buf));
+                    error_code ec;
+                    auto const n = pct_decode(
+                        buf, buf + i,
+                            s, ec, opt, *pcs);
+                    BOOST_TEST(ec.failed());
+                    BOOST_TEST(
+                        ec != error::no_space);
+                    BOOST_TEST(n == 0);
+                    // nothing past the end
+                    for(auto j = i; j <
+                            sizeof(buf); ++j)
+                        BOOST_TEST(buf[j] == '*');
+                }
+            }
+            // pct_decode in place
+            {
+                std::string s1(s);
                 error_code ec;
-                pct_decode(buf,
-                    buf + sizeof(buf),
-                        s, ec, opt, *pcs);
+                pct_decode(
+                    &s1[0], &s1[0] + s1.size(),
+                        s1, ec, opt, *pcs);
                 BOOST_TEST(ec.failed());
             }
             // pct_decode_to_value()
@@ -354,6 +391,71 @@ public:
         }
     }
 
+    void
+    testDecodeLong()
+    {
+        // long runs between escapes, pluses
+        // in and out of the character set,
+        // compared against the two pass result
+        constexpr bnf::lut_chars CS1("abc");
+        constexpr bnf::lut_chars CS2 = CS1 + '+';
+        std::string s;
+        for(int i = 0; i < 500; ++i)
+        {
+            if(i % 37 == 36)
+                s += "%41";
+            else if(i % 29 == 28)
+                s += '+';
+            else
+                s += static_cast<char>(
+                    'a' + i % 3);
+        }
+        for(int k = 0; k < 4; ++k)
+        {
+            pct_decode_opts opt;
+            opt.plus_to_space = (k & 1) != 0;
+            auto const& cs = (k & 2) ? CS2 : CS1;
+            if( ! opt.plus_to_space &&
+                ! cs('+'))
+                continue;
+            error_code ec;
+            auto const n0 =
+                validate_pct_encoding(
+                    s, ec, cs, opt);
+            if(! BOOST_TEST(! ec.failed()))
+                continue;
+            std::string d0(n0, '\0');
+            pct_decode_unchecked(
+                &d0[0], &d0[0] + n0, s, opt);
+
+            // to buffer
+            std::string d(s.size(), '\0');
+            auto n = pct_decode(&d[0],
+                &d[0] + d.size(), s, ec, opt, cs);
+            BOOST_TEST(! ec.failed());
+            BOOST_TEST(d.substr(0, n) == d0);
+
+            // in place
+            d = s;
+            n = pct_decode(&d[0],
+                &d[0] + d.size(), d, ec, opt, cs);
+            BOOST_TEST(! ec.failed());
+            BOOST_TEST(d.substr(0, n) == d0);
+
+            // every truncation
+            for(std::size_t i = 0;
+                i < n0; i += 7)
+            {
+                d.assign(i, '\0');
+                n = pct_decode(&d[0],
+                    &d[0] + i, s, ec, opt, cs);
+                BOOST_TEST(ec == error::no_space);
+                BOOST_TEST(n == i);
+                BOOST_TEST(d == d0.substr(0, i));
+            }
+        }
+    }
+
     //--------------------------------------------
 
     void
@@ -504,6 +606,7 @@ public:
     run()
     {
         testDecoding();
+        testDecodeLong();
         testEncode();
         testEncodeExtras();
     }
@@ -0,0 +1,231 @@
+//
+// Copyright (c) 2019 Vinnie Falco (vinnie.falco@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/CPPAlliance/url
+//
+
+// Test that header file is self-contained.
+#include <boost/url/resolver.hpp>
+
+#include <boost/url/static_url.hpp>
+#include "test_suite.hpp"
+#include <vector>
+
+namespace boost {
+namespace urls {
+
+class resolver_test
+{
+public:
+    struct case_t
+    {
+        char const* ref;
+        char const* result;
+    };
+
+    // rfc3986 5.4, with Errata 4547
+    static constexpr case_t cases[] = {
+        { "g:h"          , "g:h" },
+        { "g"            , "http://a/b/c/g" },
+        { "./g"          , "http://a/b/c/g" },
+        { "g/"           , "http://a/b/c/g/" },
+        { "/g"           , "http://a/g" },
+        { "//g"          , "http://g" },
+        { "?y"           , "http://a/b/c/d;p?y" },
+        { "g?y"          , "http://a/b/c/g?y" },
+        { "#s"           , "http://a/b/c/d;p?q#s" },
+        { "g#s"          , "http://a/b/c/g#s" },
+        { ";x"           , "http://a/b/c/;x" },
+        { ""             , "http://a/b/c/d;p?q" },
+        { "."            , "http://a/b/c/" },
+        { ".."           , "http://a/b/" },
+        { "../g"         , "http://a/b/g" },
+        { "../.."        , "http://a/" },
+        { "../../g"      , "http://a/g" },
+        { "../../../g"   , "http://a/../g" },
+        { "/./g"         , "http://a/g" },
+        { "g/../h"       , "http://a/b/c/h" },
+        { "g?y/../x"     , "http://a/b/c/g?y/../x" },
+    };
+
+    static
+    url_view
+    base()
+    {
+        return parse_uri(
+            "http://a/b/c/d;p?q").value();
+    }
+
+    void
+    testUrl()
+    {
+        resolver const r(base());
+        BOOST_TEST(r.base().string() ==
+            "http://a/b/c/d;p?q");
+
+        // one at a time, reusing
+        // the same container
+        url u;
+        u.reserve_bytes(128);
+        auto const p = u.c_str();
+        for(auto const& c : cases)
+        {
+            r.resolve(parse_uri_reference(
+                c.ref).value(), u);
+            BOOST_TEST(u.string() == c.result);
+            BOOST_TEST(u.c_str() == p);
+
+            // same as resolve()
+            url u1;
+            error_code ec;
+            resolve(base(), parse_uri_reference(
+                c.ref).value(), u1, ec);
+            BOOST_TEST(! ec.failed());
+            BOOST_TEST(u1.string() == u.string());
+        }
+
+        // a range
+        std::vector<url_view> refs;
+        for(auto const& c : cases)
+            refs.push_back(parse_uri_reference(
+                c.ref).value());
+        std::vector<url> v(refs.size() + 1);
+        auto it = r.resolve(
+            refs.begin(), refs.end(), v.begin());
+        BOOST_TEST(it == v.begin() + refs.size());
+        for(std::size_t i = 0; i < refs.size(); ++i)
+        {
+            BOOST_TEST(v[i].string() ==
+                cases[i].result);
+            BOOST_TEST(v[i].segments().size() ==
+                parse_uri(cases[i].result
+                    ).value().segments().size());
+        }
+        BOOST_TEST(v.back().string().empty());
+
+        // static storage
+        static_url<256> su;
+        r.resolve(parse_relative_ref(
+            "../x/./y?z").value(), su);
+        BOOST_TEST(su.string() == "http://a/b/x/y?z");
+        BOOST_TEST(su.encoded_segments().size() == 3);
+        BOOST_TEST(su.encoded_params().size() == 1);
+    }
+
+    void
+    testBuffer()
+    {
+        resolver const r(base());
+        std::vector<url_view> refs;
+        for(auto const& c : cases)
+            refs.push_back(parse_uri_reference(
+                c.ref).value());
+
+        // everything in one buffer
+        char buf[1024];
+        char* p = buf;
+        std::vector<url_view> v(refs.size());
+        error_code ec;
+        auto it = r.resolve(refs.begin(), refs.end(),
+            p, buf + sizeof(buf), v.begin(), ec);
+        BOOST_TEST(! ec.failed());
+        BOOST_TEST(it == v.end());
+        char const* q = buf;
+        for(std::size_t i = 0; i < v.size(); ++i)
+        {
+            BOOST_TEST(v[i].string() ==
+                cases[i].result);
+            // packed one after another
+            BOOST_TEST(v[i].string().data() == q);
+            q += v[i].size();
+            // the parts are usable
+            url_view const u = parse_uri(
+                cases[i].result).value();
+            BOOST_TEST(v[i].encoded_host() ==
+                u.encoded_host());
+            BOOST_TEST(v[i].encoded_query() ==
+                u.encoded_query());
+            BOOST_TEST(v[i].segments().size() ==
+                u.segments().size());
+            BOOST_TEST(v[i].encoded_params().size() ==
+                u.encoded_params().size());
+        }
+        BOOST_TEST(p == q);
+
+        // not enough space
+        {
+            char small[16];
+            char* p1 = small;
+            auto const u = r.resolve(
+                parse_relative_ref("g/h/i").value(),
+                p1, small + sizeof(small), ec);
+            BOOST_TEST(ec == error::no_space);
+            BOOST_TEST(p1 == small);
+            BOOST_TEST(u.string().empty());
+
+            p1 = small;
+            std::vector<url_view> v1(2);
+            auto it1 = r.resolve(refs.begin(), refs.end(),
+                p1, small + sizeof(small), v1.begin(), ec);
+            BOOST_TEST(ec == error::no_space);
+            // "g:h" fits, the next does not
+            BOOST_TEST(it1 == v1.begin() + 1);
+            BOOST_TEST(v1[0].string() == "g:h");
+        }
+    }
+
+    void
+    testBase()
+    {
+        // not a base
+        BOOST_TEST_THROWS(
+            resolver(parse_relative_ref(
+                "/a").value()),
+            std::invalid_argument);
+
+        // merging with an empty path
+        url u;
+        resolver(parse_uri("x://h").value()
+            ).resolve(parse_relative_ref(
+                "g").value(), u);
+        BOOST_TEST(u.string() == "x://h/g");
+
+        // no directory
+        resolver(parse_uri("x:y").value()
+            ).resolve(parse_relative_ref(
+                "g").value(), u);
+        BOOST_TEST(u.string() == "x:g");
+
+        // authority parts
+        resolver(parse_uri(
+            "x://u:p@[::1]:8/a?b").value()
+            ).resolve(parse_relative_ref(
+                "c").value(), u);
+        BOOST_TEST(u.string() == "x://u:p@[::1]:8/c");
+        BOOST_TEST(u.host_type() == host_type::ipv6);
+        BOOST_TEST(u.ipv6_address().is_loopback());
+        BOOST_TEST(u.port_number() == 8);
+        BOOST_TEST(u.user() == "u");
+        BOOST_TEST(u.password() == "p");
+    }
+
+    void
+    run()
+    {
+        testUrl();
+        testBuffer();
+        testBase();
+    }
+};
+
+constexpr resolver_test::case_t resolver_test::cases[];
+
+TEST_SUITE(
+    resolver_test,
+    "boost.url.resolver");
+
+} // urls
+} // boost
@@ -10,6 +10,8 @@
 // Test that header file is self-contained.
 #include <boost/url/rfc/charsets.hpp>
 
+#include <boost/url/rfc/reg_name_bnf.hpp>
+#include <boost/url/rfc/detail/char_table.hpp>
 #include "test_bnf.hpp"
 #include "test_suite.hpp"
 
@@ -35,10 +37,79 @@ public:
             ":@");
     }
 
+    void
+    testCharTable()
+    {
+        // the grammar sets, as the
+        // public sets they are made of
+        auto const same = [](
+            detail::class_chars const& cs0,
+            bnf::lut_chars const& cs1)
+        {
+            for_each_char(
+            [&](char c)
+            {
+                BOOST_TEST(cs0(c) == cs1(c));
+            });
+        };
+        same(detail::scheme_chars,
+            bnf::lut_chars(
+                "0123456789" "+-."
+                "ABCDEFGHIJKLMNOPQRSTUVWXYZ"
+                "abcdefghijklmnopqrstuvwxyz"));
+        same(detail::user_chars,
+            unreserved_chars + subdelim_chars);
+        same(detail::pass_chars,
+            unreserved_chars + subdelim_chars + ':');
+        same(detail::reg_name_chars,
+            reg_name_chars);
+        same(detail::segment_chars, pchars);
+        same(detail::nc_chars, pchars - ':');
+        same(detail::path_chars, pchars + '/');
+        same(detail::query_chars, query_chars);
+        same(detail::fragment_chars,
+            fragment_chars);
+        same(detail::key_chars,
+            query_chars - '&' - '=');
+        same(detail::value_chars,
+            query_chars - '&');
+        same(detail::future_chars,
+            unreserved_chars + subdelim_chars + ':');
+
+        test_char_set(detail::key_chars,
+            "ABCDEFGHIJKLMNOPQRSTUVWXYZ"
+            "abcdefghijklmnopqrstuvwxyz"
+            "0123456789" "-._~"
+            "!$'()*+,;" ":@/?");
+
+        // one load answers every class
+        BOOST_TEST(detail::char_class('=') ==
+            detail::ct_equal);
+        BOOST_TEST(detail::char_class('%') ==
+            detail::ct_pct);
+        BOOST_TEST(detail::char_class('a') ==
+            (detail::ct_alpha | detail::ct_hexdig));
+        BOOST_TEST(detail::char_class('g') ==
+            detail::ct_alpha);
+        BOOST_TEST(detail::char_class('#') == 0);
+        BOOST_TEST(detail::char_class('\x80') == 0);
+        for_each_char(
+        [](char c)
+        {
+            BOOST_TEST(((detail::char_class(c) &
+                detail::ct_hexdig) != 0) ==
+                    bnf::hexdig_chars(c));
+        });
+        BOOST_TEST(detail::is_hexdig2('0', 'f'));
+        BOOST_TEST(! detail::is_hexdig2('0', 'g'));
+        BOOST_TEST(! detail::is_hexdig2('x', 'A'));
+    }
+
     void
     run()
     {
         testLuts();
+        testCharTable();
     }
 };
 
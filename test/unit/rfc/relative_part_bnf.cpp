@@ -142,6 +142,11 @@ public:
             good<T>("a/x/");
             good<T>("a/x//");
             good<T>("a///");
+
+            // bad escape in the first segment
+            bad<T>("%");
+            bad<T>("%4");
+            bad<T>("a%zz");
         }
 
         // path-abempty
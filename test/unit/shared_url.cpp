@@ -0,0 +1,196 @@
+//
+// Copyright (c) 2019 Vinnie Falco (vinnie.falco@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/CPPAlliance/url
+//
+
+// Test that header file is self-contained.
+#include <boost/url/shared_url.hpp>
+
+#include "test_suite.hpp"
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+namespace boost {
+namespace urls {
+
+class shared_url_test
+{
+public:
+    void
+    testSpecial()
+    {
+        url_view const c1 = parse_uri(
+            "http://example.com/a/b?c=d#e").value();
+
+        // default ctor
+        {
+            shared_url u;
+            BOOST_TEST(u.use_count() == 0);
+            BOOST_TEST(u.unique());
+            BOOST_TEST(u->string().empty());
+            BOOST_TEST(*u->data() == '\0');
+        }
+
+        // shared_url(url_view)
+        {
+            shared_url u(c1);
+            BOOST_TEST(u->string() == c1.string());
+            BOOST_TEST(u->data() != c1.data());
+            BOOST_TEST(u.use_count() == 1);
+            BOOST_TEST(u->encoded_segments().size() == 2);
+            BOOST_TEST(u->encoded_params().size() == 1);
+        }
+
+        // shared_url(string_view)
+        {
+            shared_url u("http://example.com/path/to/file.txt?#");
+            BOOST_TEST(u->encoded_path() ==
+                "/path/to/file.txt");
+            BOOST_TEST_THROWS(shared_url("http://a b"),
+                std::invalid_argument);
+        }
+
+        // copy ctor
+        {
+            shared_url u0(c1);
+            shared_url u(u0);
+            BOOST_TEST(u->data() == u0->data());
+            BOOST_TEST(u.use_count() == 2);
+            BOOST_TEST(! u.unique());
+            BOOST_TEST(! u0.unique());
+        }
+
+        // move ctor
+        {
+            shared_url u0(c1);
+            auto const p = u0->data();
+            shared_url u(std::move(u0));
+            BOOST_TEST(u->data() == p);
+            BOOST_TEST(u.unique());
+            BOOST_TEST(u0->string().empty());
+        }
+
+        // copy assign
+        {
+            shared_url u0(c1);
+            shared_url u("/x");
+            u = u0;
+            BOOST_TEST(u->data() == u0->data());
+            BOOST_TEST(u.use_count() == 2);
+        }
+
+        // move assign
+        {
+            shared_url u0(c1);
+            auto const p = u0->data();
+            shared_url u("/x");
+            u = std::move(u0);
+            BOOST_TEST(u->data() == p);
+            BOOST_TEST(u.unique());
+        }
+
+        // operator=(url_view)
+        {
+            shared_url u0(c1);
+            shared_url u(u0);
+            u = c1;
+            BOOST_TEST(u->data() != u0->data());
+            BOOST_TEST(u->string() == c1.string());
+            BOOST_TEST(u0.unique());
+
+            // from our own buffer
+            u = *u;
+            BOOST_TEST(u->string() == c1.string());
+        }
+
+        // swap
+        {
+            shared_url u0(c1);
+            shared_url u("/x");
+            swap(u, u0);
+            BOOST_TEST(u->string() == c1.string());
+            BOOST_TEST(u0->string() == "/x");
+        }
+    }
+
+    void
+    testEdit()
+    {
+        // copy on first edit
+        {
+            shared_url u0("https://www.example.com/index.htm");
+            shared_url u1 = u0;
+            shared_url u2 = u0;
+            BOOST_TEST(u0.use_count() == 3);
+
+            url& u = u1.edit();
+            BOOST_TEST(u.data() != u0->data());
+            BOOST_TEST(u.data() == u1->data());
+            BOOST_TEST(u1.unique());
+            BOOST_TEST(u0.use_count() == 2);
+            u.set_encoded_path("/favicon.ico");
+            BOOST_TEST(u0->encoded_path() == "/index.htm");
+            BOOST_TEST(u2->encoded_path() == "/index.htm");
+            BOOST_TEST(u1->encoded_path() == "/favicon.ico");
+
+            // no copy when unique
+            auto const p = u1->data();
+            u1.edit().set_encoded_fragment("f");
+            BOOST_TEST(u1->data() == p);
+            BOOST_TEST(u1->string() ==
+                "https://www.example.com/favicon.ico#f");
+        }
+
+        // edit a default constructed object
+        {
+            shared_url u;
+            u.edit().set_scheme("http");
+            BOOST_TEST(u->string() == "http:");
+            BOOST_TEST(u.unique());
+        }
+
+        // edits outgrow the shared storage
+        {
+            shared_url u0("http://h/p");
+            shared_url u1 = u0;
+            url& u = u1.edit();
+            for(int i = 0; i < 40; ++i)
+                u.segments().push_back("segment");
+            u.params().emplace_back("k", "v");
+            BOOST_TEST(u1->encoded_segments().size() == 41);
+            BOOST_TEST(u1->encoded_query() == "k=v");
+            BOOST_TEST(u0->string() == "http://h/p");
+            shared_url u2 = u1;
+            BOOST_TEST(u2->data() == u1->data());
+        }
+
+        // the table is copied
+        {
+            shared_url u0("/a/b/c?x=1&y=2");
+            shared_url u1 = u0;
+            u1.edit().segments().push_back("d");
+            u1.edit().params().emplace_back("z", "3");
+            BOOST_TEST(u1->string() == "/a/b/c/d?x=1&y=2&z=3");
+            BOOST_TEST(u0->string() == "/a/b/c?x=1&y=2");
+        }
+    }
+
+    void
+    run()
+    {
+        testSpecial();
+        testEdit();
+    }
+};
+
+TEST_SUITE(
+    shared_url_test,
+    "boost.url.shared_url");
+
+} // urls
+} // boost
@@ -0,0 +1,450 @@
+//
+// Copyright (c) 2019 Vinnie Falco (vinnie.falco@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/CPPAlliance/url
+//
+
+// Test that header file is self-contained.
+#include <boost/url/simd_level.hpp>
+
+#include <boost/url/detail/simd.hpp>
+#include <boost/url/pct_encoding.hpp>
+#include <boost/url/rfc/charsets.hpp>
+#include "test_suite.hpp"
+#include <cstring>
+#include <string>
+
+namespace boost {
+namespace urls {
+
+class simd_level_test
+{
+public:
+    static
+    char const*
+    find_pct(
+        char const* first,
+        char const* last,
+        bool plus)
+    {
+        while(
+            first != last &&
+            *first != '%' &&
+            ! (plus && *first == '+'))
+            ++first;
+        return first;
+    }
+
+    static
+    std::string
+    encode(
+        std::string const& s,
+        bool plus)
+    {
+        static char const hex[] =
+            "0123456789abcdef";
+        std::string r;
+        for(char c : s)
+        {
+            auto const u = static_cast<
+                unsigned char>(c);
+            if(pchars(c))
+                r += c;
+            else if(plus && c == ' ')
+                r += '+';
+            else
+            {
+                r += '%';
+                r += hex[u >> 4];
+                r += hex[u & 15];
+            }
+        }
+        return r;
+    }
+
+    void
+    testKernels()
+    {
+        // nibble table for pchars,
+        // laid out as in lut_chars
+        unsigned char tab[32] = {};
+        for(int c = 0; c < 256; ++c)
+            if(pchars(static_cast<char>(c)))
+                tab[((c >> 7) << 4) | (c & 15)] |=
+                    static_cast<unsigned char>(
+                        1 << ((c >> 4) & 7));
+
+        simd_level const levels[] = {
+            simd_level::none,
+            simd_level::sse2,
+            simd_level::ssse3,
+            simd_level::avx2 };
+        for(auto v : levels)
+        {
+            auto const& k =
+                detail::get_simd_kernels(v);
+            BOOST_TEST(k.level <= v);
+            BOOST_TEST(k.level <=
+                active_simd_level());
+
+            // every length and position
+            char buf[80];
+            for(std::size_t n = 0;
+                n <= sizeof(buf); ++n)
+            {
+                for(std::size_t i = 0;
+                    i <= n; ++i)
+                {
+                    std::memset(buf, 'a', n);
+                    if(i < n)
+                        buf[i] = '%';
+                    BOOST_TEST(k.find_pct(
+                        buf, buf + n, false) ==
+                            buf + i);
+                    if(i < n)
+                        buf[i] = '+';
+                    BOOST_TEST(k.find_pct(
+                        buf, buf + n, true) ==
+                            buf + i);
+                    BOOST_TEST(k.find_pct(
+                        buf, buf + n, false) ==
+                            buf + n);
+                }
+            }
+
+            // find_lut, every length and position
+            for(std::size_t n = 0;
+                n <= sizeof(buf); ++n)
+            {
+                for(std::size_t i = 0;
+                    i <= n; ++i)
+                {
+                    std::memset(buf, 'a', n);
+                    if(i < n)
+                        buf[i] = '\x80';
+                    BOOST_TEST(k.find_lut(
+                        tab, false, buf, buf + n) ==
+                            buf + i);
+                    std::memset(buf, '#', n);
+                    if(i < n)
+                        buf[i] = '~';
+                    BOOST_TEST(k.find_lut(
+                        tab, true, buf, buf + n) ==
+                            buf + i);
+                }
+            }
+
+            // decode_pct, every length and
+            // position of an invalid escape
+            for(std::size_t n = 0;
+                n <= 24; ++n)
+            {
+                for(std::size_t i = 0;
+                    i <= n; ++i)
+                {
+                    static char const hex[] =
+                        "0123456789abcdefABCDEF";
+                    std::string s;
+                    std::string d;
+                    for(std::size_t j = 0;
+                        j < n; ++j)
+                    {
+                        auto const h =
+                            (j * 7 + n) % 22;
+                        auto const l =
+                            (j * 5 + i) % 22;
+                        s += '%';
+                        s += hex[h];
+                        s += hex[l];
+                        d += static_cast<char>(
+                            ((h < 16 ? h : h - 6) << 4) +
+                            (l < 16 ? l : l - 6));
+                    }
+                    if(i < n)
+                    {
+                        // corrupt escape i
+                        s[3 * i + 1 + (n & 1)] =
+                            (n & 2) ? 'g' : '/';
+                        if(n & 4)
+                            s[3 * i] = 'x';
+                        d.resize(i);
+                    }
+                    std::string out(n, '*');
+                    auto const m = k.decode_pct(
+                        &out[0], s.data(),
+                        s.data() + s.size());
+                    BOOST_TEST(m == d.size());
+                    BOOST_TEST(
+                        out.substr(0, m) == d);
+                    // in place
+                    std::string t = s;
+                    auto const m1 = k.decode_pct(
+                        &t[0], t.data(),
+                        t.data() + t.size());
+                    BOOST_TEST(m1 == d.size());
+                    BOOST_TEST(
+                        t.substr(0, m1) == d);
+                }
+            }
+
+            // encoded_size and encode_pct, every
+            // length and mix of escapes
+            for(std::size_t n = 0;
+                n <= 80; ++n)
+            {
+                for(std::size_t i = 0;
+                    i < 8; ++i)
+                {
+                    std::string t;
+                    for(std::size_t j = 0;
+                        j < n; ++j)
+                    {
+                        auto const c = static_cast<
+                            char>((j * 37 + i * 11) & 0xff);
+                        if((j >> i) & 1)
+                            t += c;
+                        else if(j % 5 == i % 5)
+                            t += ' ';
+                        else
+                            t += static_cast<char>(
+                                'a' + j % 26);
+                    }
+                    for(bool plus : { false, true })
+                    {
+                        auto const e = encode(t, plus);
+                        char const* const last =
+                            t.data() + t.size();
+                        BOOST_TEST(k.encoded_size(
+                            tab, plus, t.data(), last) ==
+                                e.size());
+                        // exact and truncated output
+                        for(std::size_t m = e.size();
+                            m + 4 > e.size() && m != 0;
+                            --m)
+                        {
+                            std::string out(m, '*');
+                            char const* it = t.data();
+                            char* const dest = &out[0];
+                            char* const end = k.encode_pct(
+                                tab, plus, dest, dest + m,
+                                it, last);
+                            BOOST_TEST(out.substr(
+                                0, end - dest) ==
+                                    e.substr(0, end - dest));
+                            BOOST_TEST(encode(std::string(
+                                t.data(), it), plus) ==
+                                    e.substr(0, end - dest));
+                            BOOST_TEST(end - dest + 2 >=
+                                static_cast<std::ptrdiff_t>(m));
+                        }
+                    }
+                }
+            }
+
+            // every char, '[' is not in pchars
+            for(int c = 0; c < 256; ++c)
+            {
+                std::memset(buf,
+                    static_cast<char>(c),
+                    sizeof(buf));
+                buf[sizeof(buf) - 1] = '[';
+                bool const m = pchars(
+                    static_cast<char>(c));
+                BOOST_TEST(k.find_lut(
+                    tab, m, buf, buf + sizeof(buf)) ==
+                        buf);
+                BOOST_TEST(k.find_lut(
+                    tab, ! m, buf, buf + sizeof(buf)) ==
+                        buf + sizeof(buf) - m);
+            }
+            for(int c = 0; c < 256; ++c)
+            {
+                std::memset(buf,
+                    static_cast<char>(c),
+                    sizeof(buf));
+                buf[sizeof(buf) - 1] = '%';
+                BOOST_TEST(k.find_pct(
+                    buf, buf + sizeof(buf), true) ==
+                        find_pct(buf,
+                            buf + sizeof(buf), true));
+            }
+        }
+    }
+
+    void
+    testCharsets()
+    {
+        // lut_chars::find_if_not goes through
+        // the active kernels for long inputs
+        std::string s;
+        for(int i = 0; i < 300; ++i)
+            s.push_back(static_cast<char>(
+                (i * 37) & 0xff));
+        for(std::size_t i = 0;
+            i < s.size(); ++i)
+        {
+            char const* first = s.data() + i;
+            char const* last =
+                s.data() + s.size();
+            char const* it = first;
+            while(
+                it != last &&
+                pchars(*it))
+                ++it;
+            BOOST_TEST(bnf::find_if_not(
+                first, last, pchars) == it);
+            it = first;
+            while(
+                it != last &&
+                ! pchars(*it))
+                ++it;
+            BOOST_TEST(bnf::find_if(
+                first, last, pchars) == it);
+        }
+    }
+
+    void
+    testPctEncoding()
+    {
+        // long runs of unreserved chars
+        // between escapes, to exercise
+        // the kernels in the algorithms
+        std::string s;
+        std::string d;
+        for(int i = 0; i < 200; ++i)
+        {
+            if(i % 41 == 40)
+            {
+                s += "%2F";
+                d += '/';
+            }
+            else if(i % 23 == 22)
+            {
+                s += '+';
+                d += ' ';
+            }
+            else
+            {
+                char const c = static_cast<
+                    char>('a' + i % 26);
+                s += c;
+                d += c;
+            }
+        }
+        pct_decode_opts opt;
+        opt.plus_to_space = true;
+        BOOST_TEST(pct_decode(s, opt,
+            unreserved_chars + '+') == d);
+        BOOST_TEST(pct_decode_bytes_unchecked(
+            s) == d.size());
+        BOOST_TEST(pct_decode_unchecked(
+            s, opt) == d);
+        opt.plus_to_space = false;
+        std::string d1 = d;
+        for(auto& c : d1)
+            if(c == ' ')
+                c = '+';
+        BOOST_TEST(pct_decode(s, opt,
+            unreserved_chars + '+') == d1);
+
+        // encode back, with space to plus
+        pct_encode_opts eopt;
+        eopt.space_to_plus = true;
+        std::string e = s;
+        for(std::size_t i = 0;
+            (i = e.find("%2F", i)) !=
+                std::string::npos; i += 3)
+            e.replace(i, 3, "%2f");
+        BOOST_TEST(pct_encode_bytes(
+            d, unreserved_chars, eopt) ==
+                e.size());
+        BOOST_TEST(pct_encode(
+            d, unreserved_chars, eopt) == e);
+
+        // truncated output
+        for(std::size_t i = 0;
+            i < e.size(); ++i)
+        {
+            std::string buf(i, '\0');
+            auto const n = pct_encode(
+                &buf[0], &buf[0] + i, d,
+                unreserved_chars, eopt);
+            BOOST_TEST(n <= i);
+            BOOST_TEST(n + 2 >= i);
+            BOOST_TEST(
+                buf.substr(0, n) ==
+                e.substr(0, n));
+        }
+
+        // long runs of escapes
+        s.clear();
+        d.clear();
+        for(int i = 0; i < 300; ++i)
+        {
+            static char const hex[] =
+                "0123456789ABCDEF";
+            auto const c = (i * 73) & 0xff;
+            s += '%';
+            s += hex[c >> 4];
+            s += hex[c & 15];
+            d += static_cast<char>(c);
+            if(i % 97 == 96)
+            {
+                s += 'x';
+                d += 'x';
+            }
+        }
+        BOOST_TEST(pct_decode(s, {},
+            unreserved_chars) == d);
+        BOOST_TEST(pct_decode_unchecked(
+            s) == d);
+        for(std::size_t i = 0;
+            i < d.size(); i += 13)
+        {
+            std::string buf(i, '\0');
+            error_code ec;
+            auto const n = pct_decode(
+                &buf[0], &buf[0] + i, s, ec,
+                    {}, unreserved_chars);
+            BOOST_TEST(ec == error::no_space);
+            BOOST_TEST(n == i);
+            BOOST_TEST(buf == d.substr(0, i));
+            BOOST_TEST(pct_decode_unchecked(
+                &buf[0], &buf[0] + i, s) == i);
+            BOOST_TEST(buf == d.substr(0, i));
+        }
+    }
+
+    void
+    run()
+    {
+        BOOST_TEST(to_string(
+            simd_level::none) == "none");
+        BOOST_TEST(to_string(
+            simd_level::sse2) == "sse2");
+        BOOST_TEST(to_string(
+            simd_level::ssse3) == "ssse3");
+        BOOST_TEST(to_string(
+            simd_level::avx2) == "avx2");
+        BOOST_TEST(
+            active_simd_level() ==
+            active_simd_level());
+        BOOST_TEST(
+            detail::active_simd_kernels().level ==
+            active_simd_level());
+
+        testKernels();
+        testCharsets();
+        testPctEncoding();
+    }
+};
+
+TEST_SUITE(
+    simd_level_test,
+    "boost.url.simd_level");
+
+} // urls
+} // boost
@@ -0,0 +1,161 @@
+//
+// Copyright (c) 2019 Vinnie Falco (vinnie.falco@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/CPPAlliance/url
+//
+
+// Test that header file is self-contained.
+#include <boost/url/small_url.hpp>
+
+#include <boost/url/url_view.hpp>
+#include "test_suite.hpp"
+#include <stdexcept>
+
+namespace boost {
+namespace urls {
+
+class small_url_test
+{
+public:
+    using url_t = small_url<128>;
+
+    void
+    testSpecial()
+    {
+        url_view const c1 = parse_uri(
+            "http://example.com/a/b?c=d#e").value();
+
+        // default ctor
+        {
+            url_t u;
+            BOOST_TEST(*u.c_str() == '\0');
+            BOOST_TEST(u.string().empty());
+            BOOST_TEST(u.is_inline());
+        }
+
+        // copy ctor
+        {
+            url_t u0(c1);
+            BOOST_TEST(u0.is_inline());
+            url_t u(u0);
+            BOOST_TEST(u.string() == c1.string());
+            BOOST_TEST(u.is_inline());
+            BOOST_TEST(u.c_str() != u0.c_str());
+        }
+
+        // move ctor, inline
+        {
+            url_t u0(c1);
+            url_t u(std::move(u0));
+            BOOST_TEST(u.string() == c1.string());
+            BOOST_TEST(u.is_inline());
+            BOOST_TEST(u.segments().size() == 2);
+            BOOST_TEST(u.params().size() == 1);
+            BOOST_TEST(u0.string().empty());
+            BOOST_TEST(u0.is_inline());
+        }
+
+        // move ctor, dynamic
+        {
+            url_t u0(c1);
+            for(int i = 0; i < 40; ++i)
+                u0.segments().push_back("segment");
+            BOOST_TEST(! u0.is_inline());
+            auto const s = u0.string();
+            auto const p = u0.c_str();
+            url_t u(std::move(u0));
+            BOOST_TEST(u.string() == s);
+            BOOST_TEST(u.c_str() == p);
+            BOOST_TEST(! u.is_inline());
+            BOOST_TEST(u0.string().empty());
+            BOOST_TEST(u0.is_inline());
+            u0 = c1;
+            BOOST_TEST(u0.string() == c1.string());
+        }
+
+        // move assign
+        {
+            url_t u0(c1);
+            url_t u;
+            for(int i = 0; i < 40; ++i)
+                u.segments().push_back("segment");
+            BOOST_TEST(! u.is_inline());
+            u = std::move(u0);
+            BOOST_TEST(u.string() == c1.string());
+            BOOST_TEST(u.encoded_fragment() == "e");
+            u.set_encoded_fragment("f");
+            BOOST_TEST(u.string() ==
+                "http://example.com/a/b?c=d#f");
+
+            url_t u1;
+            u1.set_encoded_path(std::string(500, 'x'));
+            u = std::move(u1);
+            BOOST_TEST(u.encoded_path().size() == 500);
+            u = std::move(u);
+            BOOST_TEST(u.encoded_path().size() == 500);
+        }
+
+        // copy assign
+        {
+            url_t u;
+            u = c1;
+            BOOST_TEST(u.string() == c1.string());
+            url_t u1;
+            u1 = u;
+            BOOST_TEST(u1.string() == c1.string());
+        }
+
+        // small_url(string_view)
+        {
+            url_t u("http://example.com/path/to/file.txt?#");
+            BOOST_TEST(u.is_inline());
+            BOOST_TEST_THROWS(url_t("http://a b"),
+                std::invalid_argument);
+        }
+
+        // conversion
+        {
+            url_t u(c1);
+            url u2 = u;
+            BOOST_TEST(u2.string() == c1.string());
+            url_view v = u;
+            BOOST_TEST(v.string() == c1.string());
+        }
+    }
+
+    void
+    testGrowth()
+    {
+        // spills to the heap instead of throwing
+        small_url<32> u;
+        u.set_scheme("https");
+        BOOST_TEST(u.is_inline());
+        u.set_encoded_host("www.example.com");
+        BOOST_TEST(u.is_inline());
+        u.set_encoded_path("/path/to/a/file.txt");
+        BOOST_TEST(! u.is_inline());
+        u.params().emplace_back("k", "v");
+        BOOST_TEST(u.string() ==
+            "https://www.example.com/path/to/a/file.txt?k=v");
+        BOOST_TEST(u.segments().size() == 4);
+        u.clear();
+        BOOST_TEST(u.string().empty());
+    }
+
+    void
+    run()
+    {
+        testSpecial();
+        testGrowth();
+    }
+};
+
+TEST_SUITE(
+    small_url_test,
+    "boost.url.small_url");
+
+} // urls
+} // boost
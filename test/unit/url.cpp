@@ -10,9 +10,12 @@
 // Test that header file is self-contained.
 #include <boost/url/url.hpp>
 
+#include <boost/url/static_url.hpp>
 #include "test_suite.hpp"
 #include <algorithm>
 #include <sstream>
+#include <string>
+#include <vector>
 
 namespace boost {
 namespace urls {
@@ -1685,6 +1688,303 @@ public:
             BOOST_TEST(u.set_path_absolute(true));
             u.encoded_segments().push_back("y");
             });
+
+        // indexed access after prefix changes
+        perform( "/path/to/the/file.txt", "/etc/to/the/file.txt", { "etc", "to", "the", "file.txt" }, [](url& u) {
+            u.segments().replace(u.segments().begin(), "etc");
+            });
+        perform( "x:a", "x:b/a", { "b", "a" }, [](url& u) {
+            u.segments().insert(u.segments().begin(), "b");
+            });
+        perform( "x:y:z/a/b", "./y:z/a/b", { "y:z", "a", "b" }, [](url& u) { u.remove_scheme(); });
+        perform( "./y:z/a/b", "x:y:z/a/b", { "y:z", "a", "b" }, [](url& u) { u.set_scheme("x"); });
+        perform( "//x//a/b", "/.//a/b", { "", "a", "b" }, [](url& u) { u.remove_authority(); });
+        perform( "y/a/b", "//x/y/a/b", { "y", "a", "b" }, [](url& u) { u.set_encoded_authority("x"); });
+        perform( "x://h//a/b", ".//a/b", { "", "a", "b" }, [](url& u) { u.remove_origin(); });
+        perform( ".//a/b", "x:.//a/b", { "", "a", "b" }, [](url& u) { u.set_scheme("x"); });
+
+        // the new first segment needs a prefix
+        perform( "//x/a/./b", "//x/././b", { ".", "b" }, [](url& u) {
+            u.encoded_segments().erase(u.encoded_segments().begin());
+            });
+        perform( "/a/./b", "/././b", { ".", "b" }, [](url& u) {
+            u.encoded_segments().erase(u.encoded_segments().begin());
+            });
+        perform( "a/./b", "././b", { ".", "b" }, [](url& u) {
+            u.encoded_segments().erase(u.encoded_segments().begin());
+            });
+        perform( "x:a//b", "x:.//b", { "", "b" }, [](url& u) {
+            u.encoded_segments().erase(u.encoded_segments().begin());
+            });
+        perform( "/a//b", "/.//b", { "", "b" }, [](url& u) {
+            u.encoded_segments().erase(u.encoded_segments().begin());
+            });
+        perform( "a/b:c", "./b:c", { "b:c" }, [](url& u) {
+            u.encoded_segments().erase(u.encoded_segments().begin());
+            });
+        perform( "//x/a", "//x/././a", { ".", "a" }, [](url& u) {
+            u.encoded_segments().insert(u.encoded_segments().begin(), ".");
+            });
+        perform( "x:y:z/a", "./y:z/a", { "y:z", "a" }, [](url& u) { u.remove_origin(); });
+        perform( "y/a/b", "/y/a/b", { "y", "a", "b" }, [](url& u) {
+            BOOST_TEST(u.set_path_absolute(true));
+            });
+        perform( "/y/a/b", "y/a/b", { "y", "a", "b" }, [](url& u) {
+            BOOST_TEST(u.set_path_absolute(false));
+            });
+    }
+
+    void
+    testTable()
+    {
+        // indexed access to segments and
+        // params after many edits, checked
+        // against a vector.
+        url u = parse_uri(
+            "http://example.com#f").value();
+        std::vector<std::string> vs;
+        std::vector<std::string> vp;
+        auto se = u.encoded_segments();
+        auto pe = u.encoded_params();
+
+        auto const check = [&]
+        {
+            BOOST_TEST(se.size() == vs.size());
+            for(std::size_t i = 0;
+                i < vs.size(); ++i)
+                BOOST_TEST(se[i] == vs[i]);
+            BOOST_TEST(pe.size() == vp.size());
+            for(std::size_t i = 0;
+                i < vp.size(); ++i)
+                BOOST_TEST(pe[i].key == vp[i]);
+            BOOST_TEST(u.encoded_fragment() == "f");
+        };
+
+        for(std::size_t i = 0; i < 100; ++i)
+        {
+            std::string s = std::to_string(i);
+            std::size_t k = (i * 7) % (vs.size() + 1);
+            se.insert(se.begin() + k, s);
+            vs.insert(vs.begin() + k, s);
+            k = (i * 5) % (vp.size() + 1);
+            pe.insert(pe.begin() + k, { s, s, true });
+            vp.insert(vp.begin() + k, s);
+        }
+        check();
+
+        for(std::size_t i = 0; i < 40; ++i)
+        {
+            std::size_t k = (i * 13) % vs.size();
+            se.erase(se.begin() + k);
+            vs.erase(vs.begin() + k);
+            k = (i * 11) % vp.size();
+            pe.erase(pe.begin() + k);
+            vp.erase(vp.begin() + k);
+        }
+        check();
+
+        // resize other parts
+        u.set_encoded_host("a-much-longer-host.example.com");
+        u.set_encoded_user("user");
+        check();
+        u.remove_authority();
+        check();
+        u.remove_scheme();
+        check();
+        u.set_scheme("http");
+        check();
+
+        // copies rebuild the table
+        url u2 = u;
+        BOOST_TEST(u2.encoded_segments().size() == vs.size());
+        for(std::size_t i = 0; i < vs.size(); ++i)
+            BOOST_TEST(u2.encoded_segments()[i] == vs[i]);
+        for(std::size_t i = 0; i < vp.size(); ++i)
+            BOOST_TEST(u2.encoded_params()[i].key == vp[i]);
+
+        // the first param changes
+        {
+            url v = parse_uri("x://h?a&b&c#f").value();
+            auto p = v.encoded_params();
+            p.insert(p.begin(), { "k", "v", true });
+            BOOST_TEST(v.string() == "x://h?k=v&a&b&c#f");
+            p.erase(p.begin(), p.begin() + 2);
+            BOOST_TEST(v.string() == "x://h?b&c#f");
+            BOOST_TEST(p[1].key == "c");
+            p.erase(p.begin());
+            BOOST_TEST(v.string() == "x://h?c#f");
+            BOOST_TEST(p[0].key == "c");
+        }
+    }
+
+    // check the parts of u against v
+    static
+    void
+    same(
+        url& u,
+        url_view const& v)
+    {
+        BOOST_TEST(u.scheme_id() == v.scheme_id());
+        BOOST_TEST(u.encoded_userinfo() == v.encoded_userinfo());
+        BOOST_TEST(u.encoded_host() == v.encoded_host());
+        BOOST_TEST(u.host_type() == v.host_type());
+        BOOST_TEST(u.has_port() == v.has_port());
+        BOOST_TEST(u.port_number() == v.port_number());
+        BOOST_TEST(u.encoded_path() == v.encoded_path());
+        BOOST_TEST(u.encoded_query() == v.encoded_query());
+        BOOST_TEST(u.encoded_fragment() == v.encoded_fragment());
+        BOOST_TEST(u.host() == v.host());
+        BOOST_TEST(u.query() == v.query());
+        BOOST_TEST(u.fragment() == v.fragment());
+        if(v.host_type() == host_type::ipv6)
+            BOOST_TEST(u.ipv6_address() == v.ipv6_address());
+        if(BOOST_TEST(u.segments().size() ==
+            v.segments().size()))
+        {
+            auto it = v.segments().begin();
+            for(auto s : u.segments())
+                BOOST_TEST(s == *it++);
+            auto it2 = v.encoded_segments().begin();
+            for(auto s : u.encoded_segments())
+                BOOST_TEST(s == *it2++);
+        }
+        if(BOOST_TEST(u.encoded_params().size() ==
+            v.encoded_params().size()))
+        {
+            auto it = v.encoded_params().begin();
+            for(auto p : u.encoded_params())
+            {
+                BOOST_TEST(p.key == (*it).key);
+                ++it;
+            }
+        }
+    }
+
+    //--------------------------------------------
+
+    void
+    testNormalize()
+    {
+        auto const check = [](
+            string_view s0,
+            string_view s1)
+        {
+            url u = parse_uri_reference(s0).value();
+            auto const p = u.c_str();
+            auto const cap = u.capacity_in_bytes();
+            u.normalize();
+            BOOST_TEST(u.string() == s1);
+            // in place
+            BOOST_TEST(u.c_str() == p);
+            BOOST_TEST(u.capacity_in_bytes() == cap);
+            // idempotent
+            u.normalize();
+            BOOST_TEST(u.string() == s1);
+            // the parts agree with a parse
+            url_view const v =
+                parse_uri_reference(s1).value();
+            BOOST_TEST(u.encoded_path() == v.encoded_path());
+            BOOST_TEST(u.encoded_host() == v.encoded_host());
+            BOOST_TEST(u.host_type() == v.host_type());
+            if(v.host_type() == host_type::ipv4)
+                BOOST_TEST(u.ipv4_address() ==
+                    v.ipv4_address());
+            BOOST_TEST(u.has_port() == v.has_port());
+            BOOST_TEST(u.port_number() == v.port_number());
+            BOOST_TEST(u.segments().size() == v.segments().size());
+            BOOST_TEST(u.encoded_params().size() ==
+                v.encoded_params().size());
+            auto it = v.encoded_segments().begin();
+            for(auto s : u.encoded_segments())
+                BOOST_TEST(s == *it++);
+            auto it2 = v.segments().begin();
+            for(auto s : u.segments())
+                BOOST_TEST(s == *it2++);
+        };
+
+        // case
+        check("HTTP://www.Example.COM/", "http://www.example.com/");
+        check("x://[FE80::A]/", "x://[fe80::a]/");
+        check("x://U:P@H/P?Q#F", "x://U:P@h/P?Q#F");
+
+        // percent-encoding
+        check("x:%7e%41%2d", "x:~A-");
+        check("x:%2f%2F%c3%a9", "x:%2F%2F%C3%A9");
+        check("x://%41%2f:%7e@%48%c3/%7e?%7e=%7e#%7e",
+            "x://A%2F:~@h%C3/~?~=~#~");
+        check("x:/a?%26=%3d&b", "x:/a?%26=%3D&b");
+
+        // a name which decodes to an IPv4 address
+        check("http://%311.2.3.4", "http://11.2.3.4");
+        check("http://1.2.3.%34/", "http://1.2.3.4/");
+        check("http://1.2.3.%2e4/", "http://1.2.3..4/");
+
+        // ports
+        check("http://x:80/", "http://x/");
+        check("http://x:080/", "http://x/");
+        check("http://x:/", "http://x/");
+        check("https://x:443", "https://x");
+        check("ws://x:80", "ws://x");
+        check("wss://x:443", "wss://x");
+        check("ftp://x:21", "ftp://x");
+        check("http://x:443/", "http://x:443/");
+        check("x://x:80/", "x://x:80/");
+        check("//x:80/", "//x:80/");
+
+        // dot segments
+        check("/a/b/c/./../../g", "/a/g");
+        check("mid/content=5/../6", "mid/6");
+        check("x:/a/./b/../c/", "x:/a/c/");
+        check("/a/%2E%2E/b", "/b");
+        check("/a/b/..", "/a/");
+        check("/a/b/.", "/a/b/");
+        check("../../a", "../../a");
+        check("/../a", "/../a");
+        check("a/..", "");
+        check(".", "");
+        check("./", "");
+        check("/.", "/");
+        check("/./", "/");
+        check("/a/..//b", "/.//b");
+        check("a/../b:c", "./b:c");
+        check("x:a/..//b", "x:.//b");
+        check("//x/.//b", "//x//b");
+        check("x:a/../b:c", "x:b:c");
+
+        // everything
+        check("HTTP://www.Example.COM:80/a/./b/../%7euser?%7E#%7e",
+            "http://www.example.com/a/~user?~#~");
+
+        // empty
+        {
+            url u;
+            u.normalize();
+            BOOST_TEST(u.string().empty());
+            BOOST_TEST(*u.c_str() == '\0');
+        }
+        {
+            url u = parse_uri_reference("").value();
+            u.normalize();
+            BOOST_TEST(u.string().empty());
+        }
+        {
+            url u = parse_uri_reference("a/..").value();
+            u.normalize();
+            BOOST_TEST(u.string().empty());
+            url u2 = u;
+            u2.normalize();
+            BOOST_TEST(u2.string().empty());
+            BOOST_TEST(*u2.c_str() == '\0');
+        }
+
+        // static storage
+        {
+            static_url<256> u(parse_uri(
+                "HTTP://X:80/a/b/../../c").value());
+            u.normalize();
+            BOOST_TEST(u.string() == "http://x/c");
+            BOOST_TEST(u.segments().size() == 1);
+        }
     }
 
     //--------------------------------------------
@@ -1708,6 +2008,7 @@ public:
             if(! BOOST_TEST(! ec.failed()))
                 return;
             BOOST_TEST(u.string() == m);
+            same(u, parse_uri(m).value());
         };
 
         check("g:h"          , "g:h");
@@ -1765,6 +2066,54 @@ public:
         check("g?y/../x"     , "http://a/b/c/g?y/../x");
         check("g#s/./x"      , "http://a/b/c/g#s/./x");
         check("g#s/../x"     , "http://a/b/c/g#s/../x");
+
+        // other bases
+        auto const check2 = [](
+            string_view b,
+            string_view r,
+            string_view m)
+        {
+            url u;
+            u.reserve_bytes(256);
+            auto const p = u.c_str();
+            error_code ec;
+            resolve(
+                parse_uri(b).value(),
+                parse_uri_reference(r).value(),
+                u, ec);
+            if(! BOOST_TEST(! ec.failed()))
+                return;
+            BOOST_TEST(u.string() == m);
+            same(u, parse_uri(m).value());
+            // no reallocation
+            BOOST_TEST(u.c_str() == p);
+        };
+
+        check2("x:", "g", "x:g");
+        check2("x:", "./g:h", "x:g:h");
+        check2("x:a/b", "..//c", "x:.//c");
+        check2("x:/a/b", "..//c", "x:/.//c");
+        check2("x://h", "g", "x://h/g");
+        check2("x://h", "?y", "x://h?y");
+        check2("x://h/a/b", "..//c", "x://h//c");
+        check2("x://u:p@h:8/a?b#c", "d?e&f#g", "x://u:p@h:8/d?e&f#g");
+        check2("x://u:p@h:8/a?b&c#c", "#g", "x://u:p@h:8/a?b&c#g");
+        check2("x://u:p@h:8/a?b&c#c", "//[::1]:9/d/./e?f", "x://[::1]:9/d/e?f");
+        check2("x://[::1]/a/b/c", "../../d/e/f/../g?h&i&j",
+            "x://[::1]/d/e/g?h&i&j");
+        check2("x://1.2.3.4/%41/b", "c/%2E%2E/d", "x://1.2.3.4/%41/c/%2E%2E/d");
+        check2("x:/a", "y:/b/../c", "y:/c");
+
+        // not a base
+        {
+            url u;
+            error_code ec;
+            resolve(
+                parse_relative_ref("/a").value(),
+                parse_relative_ref("b").value(),
+                u, ec);
+            BOOST_TEST(ec == error::not_a_base);
+        }
     }
 
     //--------------------------------------------
@@ -1810,6 +2159,8 @@ public:
         testQuery();
         testFragment();
         testSegments();
+        testTable();
+        testNormalize();
         testResolution();
         testOstream();
     }
@@ -0,0 +1,319 @@
+//
+// Copyright (c) 2019 Vinnie Falco (vinnie.falco@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/CPPAlliance/url
+//
+
+// Test that header file is self-contained.
+#include <boost/url/url_stream_parser.hpp>
+
+#include "test_suite.hpp"
+#include <string>
+
+namespace boost {
+namespace urls {
+
+class url_stream_parser_test
+{
+public:
+    using part = url_stream_parser::part;
+
+    static
+    string_view
+    get(
+        url_stream_parser const& p,
+        string_view s,
+        part k)
+    {
+        return s.substr(
+            p.offset(k), p.length(k));
+    }
+
+    // the parser is done, check it
+    // against the grammar
+    static
+    void
+    check(
+        url_stream_parser const& p,
+        string_view s,
+        url_view const& u)
+    {
+        BOOST_TEST(p.size() == s.size());
+        BOOST_TEST(p.has_scheme() ==
+            u.has_scheme());
+        BOOST_TEST(get(p, s, part::scheme) ==
+            u.scheme());
+        BOOST_TEST(p.scheme_id() ==
+            u.scheme_id());
+        BOOST_TEST(p.has_authority() ==
+            u.has_authority());
+        BOOST_TEST(get(p, s, part::user) ==
+            u.encoded_user());
+        BOOST_TEST(get(p, s, part::password) ==
+            u.encoded_password());
+        BOOST_TEST(get(p, s, part::host) ==
+            u.encoded_host());
+        BOOST_TEST(p.host_type() ==
+            u.host_type());
+        BOOST_TEST(p.has_port() ==
+            u.has_port());
+        BOOST_TEST(get(p, s, part::port) ==
+            u.port());
+        BOOST_TEST(p.port_number() ==
+            u.port_number());
+        BOOST_TEST(get(p, s, part::path) ==
+            u.encoded_path());
+        BOOST_TEST(p.has_query() ==
+            u.has_query());
+        BOOST_TEST(get(p, s, part::query) ==
+            u.encoded_query());
+        BOOST_TEST(p.has_fragment() ==
+            u.has_fragment());
+        BOOST_TEST(get(p, s, part::fragment) ==
+            u.encoded_fragment());
+
+        auto const v = p.view(s);
+        BOOST_TEST(v.data() == s.data());
+        BOOST_TEST(v.string() == u.string());
+        BOOST_TEST(v.encoded_userinfo() ==
+            u.encoded_userinfo());
+        BOOST_TEST(v.user() == u.user());
+        BOOST_TEST(v.password() ==
+            u.password());
+        BOOST_TEST(v.host() == u.host());
+        BOOST_TEST(v.ipv4_address() ==
+            u.ipv4_address());
+        BOOST_TEST(v.ipv6_address() ==
+            u.ipv6_address());
+        BOOST_TEST(v.ipv_future() ==
+            u.ipv_future());
+        BOOST_TEST(v.port_number() ==
+            u.port_number());
+        BOOST_TEST(v.segments().size() ==
+            u.segments().size());
+        BOOST_TEST(v.params().size() ==
+            u.params().size());
+        BOOST_TEST(v.fragment() ==
+            u.fragment());
+    }
+
+    // write s in two pieces split at i,
+    // or one char at a time if i is npos
+    static
+    void
+    check(
+        string_view s,
+        std::size_t i)
+    {
+        auto const r =
+            parse_uri_reference(s);
+        url_stream_parser p;
+        error_code ec;
+        if(i == string_view::npos)
+        {
+            for(std::size_t j = 0;
+                j < s.size() && ! ec; ++j)
+                p.write(s.data() + j, 1, ec);
+        }
+        else
+        {
+            p.write(s.substr(0, i), ec);
+            if(! ec)
+                p.write(s.substr(i), ec);
+        }
+        if(! ec)
+            p.finish(ec);
+        if(! BOOST_TEST(
+                r.has_error() == !! ec))
+            return;
+        if(ec)
+        {
+            BOOST_TEST(! p.done());
+            return;
+        }
+        BOOST_TEST(p.done());
+        check(p, s, *r);
+    }
+
+    void
+    testSplits()
+    {
+        string_view const schemes[] = {
+            "", "http:", "a+b.c-d:",
+            "1a:", "verylongscheme:" };
+        string_view const auths[] = {
+            "", "//", "//h", "//u@h",
+            "//u:p@h:80", "//@", "//:@:",
+            "//1.2.3.4", "//1.2.3.4:65536",
+            "//127.0.0.1:8080", "//01.2.3.4",
+            "//1.2.3.2551", "//1.2.3.4x",
+            "//1.2.3.4.5", "//1.2.3", "//256.1.1.1",
+            "//1.2.3.4@h", "//1.2.3.4:8@h",
+            "//[::1]:8", "//[1:2:3:4:5:6:7:8]",
+            "//[::ffff:1.2.3.4]", "//[v1.x]",
+            "//[v1f.a:b]", "//[v.x]", "//[v1.]",
+            "//[::1", "//[::1]x", "//[]",
+            "//%41@%42", "//a%20b:c%20d@e%20f",
+            "//a:b:c@d", "//h:8x", "//h:", "//h:%",
+            "//a!b@c", "//a!b", "//u@[::1]" };
+        string_view const paths[] = {
+            "", "/", "a", "./b", "/./", "/.",
+            "a:b", "%2e/", "/%zz", "//x",
+            ".//", "/a/b/" };
+        string_view const queries[] = {
+            "", "?", "?a&b", "?%4", "?&" };
+        string_view const frags[] = {
+            "", "#", "#f%20", "#%", "#?#" };
+
+        std::string s;
+        for(auto s0 : schemes)
+        for(auto s1 : auths)
+        for(auto s2 : paths)
+        for(auto s3 : queries)
+        for(auto s4 : frags)
+        {
+            s.assign(s0.data(), s0.size());
+            s.append(s1.data(), s1.size());
+            s.append(s2.data(), s2.size());
+            s.append(s3.data(), s3.size());
+            s.append(s4.data(), s4.size());
+            check(s, string_view::npos);
+            for(std::size_t i = 0;
+                    i <= s.size(); ++i)
+                check(s, i);
+        }
+    }
+
+    void
+    testWriteSome()
+    {
+        // the URL ends at the space
+        {
+            string_view const s =
+                "GET /index.htm?a=1 HTTP/1.1";
+            url_stream_parser p;
+            error_code ec;
+            BOOST_TEST(p.write_some(
+                s.substr(4, 6), ec) == 6);
+            BOOST_TEST(! ec);
+            BOOST_TEST(! p.done());
+            BOOST_TEST(p.write_some(
+                s.substr(10), ec) == 8);
+            BOOST_TEST(! ec);
+            BOOST_TEST(p.done());
+            BOOST_TEST(p.size() == 14);
+            check(p, s.substr(4, 14),
+                *parse_uri_reference(
+                    s.substr(4, 14)));
+
+            // done is final
+            BOOST_TEST(p.write_some(
+                "x", ec) == 0);
+            BOOST_TEST(! ec);
+            p.finish(ec);
+            BOOST_TEST(! ec);
+            BOOST_TEST(p.done());
+        }
+
+        // every valid URL ends
+        // before a space
+        for(string_view s : {
+            "", "http:", "//h", "//h:",
+            "//1.2.3.4", "//[::1]", "/",
+            "x:y", "?", "#", "a%20" })
+        {
+            std::string t(s);
+            t += " HTTP/1.1";
+            for(std::size_t i = 0;
+                i <= s.size(); ++i)
+            {
+                url_stream_parser p;
+                error_code ec;
+                auto n = p.write_some(
+                    t.data(), i, ec);
+                BOOST_TEST(! ec);
+                n += p.write_some(
+                    t.data() + i,
+                    t.size() - i, ec);
+                BOOST_TEST(! ec);
+                BOOST_TEST(p.done());
+                BOOST_TEST(n == s.size());
+                check(p, s,
+                    *parse_uri_reference(s));
+            }
+        }
+
+        // errors are final
+        {
+            url_stream_parser p;
+            error_code ec;
+            BOOST_TEST(p.write_some(
+                "/a%zz", ec) == 3);
+            BOOST_TEST(ec ==
+                error::bad_pct_hexdig);
+            BOOST_TEST(p.write_some(
+                "/", ec) == 0);
+            BOOST_TEST(ec ==
+                error::bad_pct_hexdig);
+            p.finish(ec);
+            BOOST_TEST(ec ==
+                error::bad_pct_hexdig);
+            BOOST_TEST(! p.done());
+
+            // reset
+            p.reset();
+            BOOST_TEST(p.size() == 0);
+            BOOST_TEST(p.write_some(
+                "/", ec) == 1);
+            BOOST_TEST(! ec);
+            p.finish(ec);
+            BOOST_TEST(! ec);
+            BOOST_TEST(p.done());
+        }
+
+        // incomplete
+        {
+            url_stream_parser p;
+            error_code ec;
+            p.write("/%4", ec);
+            BOOST_TEST(! ec);
+            p.finish(ec);
+            BOOST_TEST(ec ==
+                error::incomplete_pct_encoding);
+        }
+        {
+            url_stream_parser p;
+            error_code ec;
+            p.write("//[::1", ec);
+            BOOST_TEST(! ec);
+            p.finish(ec);
+            BOOST_TEST(ec ==
+                error::incomplete);
+        }
+        {
+            url_stream_parser p;
+            error_code ec;
+            BOOST_TEST(p.write(
+                "/a b", ec) == 2);
+            BOOST_TEST(ec ==
+                error::leftover_input);
+        }
+    }
+
+    void
+    run()
+    {
+        testSplits();
+        testWriteSome();
+    }
+};
+
+TEST_SUITE(
+    url_stream_parser_test,
+    "boost.url.url_stream_parser");
+
+} // urls
+} // boost
@@ -0,0 +1,150 @@
+//
+// Copyright (c) 2019 Vinnie Falco (vinnie.falco@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/CPPAlliance/url
+//
+
+// Test that header file is self-contained.
+#include <boost/url/validate.hpp>
+
+#include <boost/url/url_view.hpp>
+#include "test_suite.hpp"
+#include <string>
+
+namespace boost {
+namespace urls {
+
+class validate_test
+{
+public:
+    template<class Validate, class Parse>
+    static
+    void
+    check_grammar(
+        string_view s,
+        Validate const& validate,
+        Parse const& parse)
+    {
+        error_code ec;
+        auto const n = validate(s, ec);
+        auto const r = parse(s);
+        BOOST_TEST(r.has_error() == !! ec);
+        if(ec)
+            BOOST_TEST(n <= s.size());
+        else
+            BOOST_TEST(n == s.size());
+    }
+
+    static
+    void
+    check(string_view s)
+    {
+        check_grammar(s, validate_uri,
+            parse_uri);
+        check_grammar(s, validate_relative_ref,
+            parse_relative_ref);
+        check_grammar(s, validate_uri_reference,
+            parse_uri_reference);
+    }
+
+    static
+    void
+    check(
+        string_view s,
+        std::size_t n,
+        error_code e)
+    {
+        error_code ec;
+        BOOST_TEST(validate_uri_reference(
+            s, ec) == n);
+        BOOST_TEST(ec == e);
+    }
+
+    void
+    testGrammar()
+    {
+        string_view const schemes[] = {
+            "", "http:", "a+b.c-d:", "1a:" };
+        string_view const auths[] = {
+            "", "//", "//h", "//u:p@h:80",
+            "//@", "//:@:", "//1.2.3.4",
+            "//1.2.3.4:65536", "//01.2.3.4",
+            "//1.2.3.2551", "//1.2.3.4x",
+            "//[::1]:8", "//[v1.x]", "//[v.x]",
+            "//[::1", "//[]", "//%41@%42",
+            "//a%zz", "//a:%4", "//a:b:c@d",
+            "//h:8x", "//u@[::1]" };
+        string_view const paths[] = {
+            "", "/", "a", "./b", "a:b",
+            "%2e/", "/%zz", "//x", "/a b" };
+        string_view const queries[] = {
+            "", "?", "?a&b", "?%4", "?[" };
+        string_view const frags[] = {
+            "", "#", "#f%20", "#%", "#?#" };
+
+        std::string s;
+        for(auto s0 : schemes)
+        for(auto s1 : auths)
+        for(auto s2 : paths)
+        for(auto s3 : queries)
+        for(auto s4 : frags)
+        {
+            s.assign(s0.data(), s0.size());
+            s.append(s1.data(), s1.size());
+            s.append(s2.data(), s2.size());
+            s.append(s3.data(), s3.size());
+            s.append(s4.data(), s4.size());
+            check(s);
+        }
+    }
+
+    void
+    testPosition()
+    {
+        check("http://www.example.com/",
+            23, {});
+        check("http://a b", 8,
+            error::leftover_input);
+        check("/path%zz", 6,
+            error::bad_pct_hexdig);
+        check("/path%4", 7,
+            error::incomplete_pct_encoding);
+        check("?q=%", 4,
+            error::incomplete_pct_encoding);
+        check("http:?q", 5,
+            error::syntax);
+        check("a:b#[", 4,
+            error::leftover_input);
+
+        error_code ec;
+        BOOST_TEST(validate_uri(
+            "/path", ec) == 0);
+        BOOST_TEST(ec == error::syntax);
+        BOOST_TEST(validate_uri(
+            "path/x", ec) == 4);
+        BOOST_TEST(ec == error::syntax);
+        BOOST_TEST(validate_relative_ref(
+            "a:b", ec) == 1);
+        BOOST_TEST(ec == error::leftover_input);
+        BOOST_TEST(validate_relative_ref(
+            "", ec) == 0);
+        BOOST_TEST(! ec);
+    }
+
+    void
+    run()
+    {
+        testGrammar();
+        testPosition();
+    }
+};
+
+TEST_SUITE(
+    validate_test,
+    "boost.url.validate");
+
+} // urls
+} // boost